@@ -0,0 +1,166 @@
+#include "Background.h"
+
+BackgroundCache::BackgroundCache() {
+  poolUsed = 0;
+  for (uint8_t i = 0; i < MAX_BACKGROUNDS; i++) {
+    entries[i].length = 0;
+    entries[i].paletteSize = 0;
+  }
+  capturing = MAX_BACKGROUNDS;
+  bandY = 0;
+  overflow = false;
+  runColor = 0;
+  runLength = 0;
+}
+
+// ============================================
+// CAPTURE
+// ============================================
+
+void BackgroundCache::beginCapture(uint8_t id) {
+  if (id >= MAX_BACKGROUNDS) return;
+
+  capturing = id;
+  entries[id].offset = poolUsed;
+  entries[id].length = 0;
+  entries[id].paletteSize = 0;
+  bandY = -BACKGROUND_BAND_ROWS;
+  overflow = false;
+  runLength = 0;
+}
+
+void BackgroundCache::writeByte(uint8_t value) {
+  if (poolUsed >= BACKGROUND_POOL_BYTES) {
+    overflow = true;
+    return;
+  }
+  pool[poolUsed++] = value;
+}
+
+void BackgroundCache::flushRun() {
+  if (runLength == 0) return;
+
+  if (runLength <= 15) {
+    writeByte((runColor << 4) | (runLength - 1));
+  } else {
+    writeByte((runColor << 4) | 0x0F);
+    uint32_t extra = runLength - 16;
+    do {
+      uint8_t bits = extra & 0x7F;
+      extra >>= 7;
+      writeByte(extra ? (bits | 0x80) : bits);
+    } while (extra);
+  }
+  runLength = 0;
+}
+
+uint8_t BackgroundCache::globalIndex(Entry& entry, uint16_t color) {
+  for (uint8_t i = 0; i < entry.paletteSize; i++) {
+    if (entry.palette[i] == color) return i;
+  }
+  if (entry.paletteSize < SPRITE_PALETTE_SIZE) {
+    entry.palette[entry.paletteSize] = color;
+    return entry.paletteSize++;
+  }
+  // Any substitute colour would restore a wrong layout.
+  overflow = true;
+  return SPRITE_PALETTE_SIZE - 1;
+}
+
+// Encodes the band drawn since the last call, then opens the next one.
+Adafruit_GFX* BackgroundCache::nextBand() {
+  if (capturing >= MAX_BACKGROUNDS) return NULL;
+  Entry& entry = entries[capturing];
+
+  if (bandY >= 0) {
+    if (sprite.hasPaletteOverflow()) overflow = true;
+
+    // Band palette indices to image palette indices.
+    uint8_t remap[SPRITE_PALETTE_SIZE];
+    const uint16_t* palette = sprite.getPalette();
+    for (uint8_t i = 0; i < sprite.getPaletteSize(); i++) {
+      remap[i] = globalIndex(entry, palette[i]);
+    }
+
+    int16_t rows = min((int16_t)BACKGROUND_BAND_ROWS, (int16_t)(SCREEN_HEIGHT - bandY));
+    const uint8_t* cell = band;
+    for (uint32_t n = 0; n < (uint32_t)SCREEN_WIDTH * rows; n++) {
+      uint8_t index = (n & 1) ? (*cell++ & 0x0F) : (*cell >> 4);
+      uint8_t color = remap[index];
+      if (runLength > 0 && color != runColor) flushRun();
+      runColor = color;
+      runLength++;
+    }
+  }
+
+  bandY += BACKGROUND_BAND_ROWS;
+  if (bandY >= (int16_t)SCREEN_HEIGHT || overflow) return NULL;
+
+  sprite.begin(0, bandY, SCREEN_WIDTH, BACKGROUND_BAND_ROWS, band);
+  return &sprite;
+}
+
+bool BackgroundCache::endCapture() {
+  if (capturing >= MAX_BACKGROUNDS) return false;
+  Entry& entry = entries[capturing];
+  capturing = MAX_BACKGROUNDS;
+
+  flushRun();
+  if (overflow || bandY < (int16_t)SCREEN_HEIGHT) {
+    poolUsed = entry.offset;
+    entry.length = 0;
+    return false;
+  }
+  entry.length = poolUsed - entry.offset;
+  return true;
+}
+
+// ============================================
+// RESTORE
+// ============================================
+
+bool BackgroundCache::restore(uint8_t id, DisplayBus* bus) {
+  if (!has(id) || !bus) return false;
+  const Entry& entry = entries[id];
+
+  bus->beginTransaction();
+  bus->beginRegion(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+
+  uint16_t* span = NULL;
+  uint16_t used = 0;
+  const uint8_t* p = &pool[entry.offset];
+  const uint8_t* end = p + entry.length;
+  while (p < end) {
+    uint8_t code = *p++;
+    uint16_t color = entry.palette[code >> 4];
+    uint32_t length = (code & 0x0F) + 1;
+    if (length == 16) {
+      uint32_t extra = 0;
+      uint8_t shift = 0;
+      uint8_t bits;
+      do {
+        bits = *p++;
+        extra |= (uint32_t)(bits & 0x7F) << shift;
+        shift += 7;
+      } while (bits & 0x80);
+      length += extra;
+    }
+
+    while (length > 0) {
+      if (used == 0) span = bus->acquireSpan();
+      uint16_t count = min(length, (uint32_t)(DISPLAY_BUS_SPAN_PIXELS - used));
+      for (uint16_t i = 0; i < count; i++) span[used + i] = color;
+      used += count;
+      length -= count;
+      if (used == DISPLAY_BUS_SPAN_PIXELS) {
+        bus->queueSpan(used);
+        used = 0;
+      }
+    }
+  }
+  if (used > 0) bus->queueSpan(used);
+
+  bus->endRegion();
+  bus->endTransaction();
+  return true;
+}
@@ -0,0 +1,70 @@
+#ifndef BACKGROUND_H
+#define BACKGROUND_H
+
+#include <Adafruit_GFX.h>
+#include "Config.h"
+#include "DisplayBus.h"
+#include "Sprite.h"
+
+// ============================================
+// Cached Screen Backgrounds
+// ============================================
+// Holds each screen's static layout (frames and labels) as a run-length
+// encoded image in one pool. Capture renders the layout band by band into
+// a sprite and encodes the bands in scan order; restore decodes straight
+// into bus spans in a single full-screen window.
+//
+// Runs: one byte of colour index (high nibble) and length - 1 (low
+// nibble); a low nibble of 15 means 16 plus a LEB128 length that follows.
+class BackgroundCache {
+public:
+  static const uint8_t MAX_BACKGROUNDS = 8;  // One per screen
+
+private:
+  struct Entry {
+    uint16_t offset;
+    uint16_t length;  // 0 = not captured
+    uint8_t paletteSize;
+    uint16_t palette[SPRITE_PALETTE_SIZE];
+  };
+
+  uint8_t pool[BACKGROUND_POOL_BYTES];
+  uint16_t poolUsed;
+  Entry entries[MAX_BACKGROUNDS];
+
+  Sprite sprite;
+  uint8_t band[(SCREEN_WIDTH + 1) / 2 * BACKGROUND_BAND_ROWS];
+
+  // Capture state
+  uint8_t capturing;
+  int16_t bandY;
+  bool overflow;  // Pool or palette
+  uint8_t runColor;
+  uint32_t runLength;
+
+  void writeByte(uint8_t value);
+  void flushRun();
+  uint8_t globalIndex(Entry& entry, uint16_t color);
+
+public:
+  BackgroundCache();
+
+  // Usage: beginCapture(); while ((gfx = nextBand())) draw the layout
+  // through gfx; endCapture(). Returns false if the image did not fit
+  // the pool or used more than SPRITE_PALETTE_SIZE colours.
+  void beginCapture(uint8_t id);
+  Adafruit_GFX* nextBand();
+  bool endCapture();
+
+  bool has(uint8_t id) const {
+    return id < MAX_BACKGROUNDS && entries[id].length > 0;
+  }
+  uint16_t size(uint8_t id) const {
+    return id < MAX_BACKGROUNDS ? entries[id].length : 0;
+  }
+
+  // Streams the image to the panel in one transaction.
+  bool restore(uint8_t id, DisplayBus* bus);
+};
+
+#endif
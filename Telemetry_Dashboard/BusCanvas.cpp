@@ -0,0 +1,114 @@
+#include "BusCanvas.h"
+
+BusCanvas::BusCanvas()
+  : Adafruit_GFX(SCREEN_WIDTH, SCREEN_HEIGHT) {
+  bus = NULL;
+  writeDepth = 0;
+  runX = 0;
+  runY = 0;
+  runLength = 0;
+  runColor = 0;
+}
+
+void BusCanvas::begin(DisplayBus* b) {
+  bus = b;
+}
+
+// ============================================
+// WRITE PRIMITIVES
+// ============================================
+// Called between startWrite() and endWrite(), as Adafruit_GFX does.
+
+void BusCanvas::startWrite() {
+  if (writeDepth++ == 0) bus->beginTransaction();
+}
+
+void BusCanvas::endWrite() {
+  flushRun();
+  if (--writeDepth == 0) bus->endTransaction();
+}
+
+void BusCanvas::writePixel(int16_t x, int16_t y, uint16_t color) {
+  if (x < 0 || y < 0 || x >= SCREEN_WIDTH || y >= SCREEN_HEIGHT) return;
+
+  if (runLength > 0 && y == runY && x == runX + (int16_t)runLength && color == runColor &&
+      runLength < DISPLAY_BUS_SPAN_PIXELS) {
+    runLength++;
+    return;
+  }
+
+  flushRun();
+  runX = x;
+  runY = y;
+  runLength = 1;
+  runColor = color;
+}
+
+void BusCanvas::flushRun() {
+  if (runLength == 0) return;
+
+  uint16_t length = runLength;
+  runLength = 0;
+  writeFillRect(runX, runY, length, 1, runColor);
+}
+
+void BusCanvas::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  int16_t x0 = max(x, (int16_t)0);
+  int16_t y0 = max(y, (int16_t)0);
+  int16_t x1 = min((int16_t)(x + w), (int16_t)SCREEN_WIDTH);
+  int16_t y1 = min((int16_t)(y + h), (int16_t)SCREEN_HEIGHT);
+  if (x0 >= x1 || y0 >= y1) return;
+
+  // Keeps pixels on the panel in the order they were drawn.
+  flushRun();
+
+  bus->beginRegion(x0, y0, x1 - x0, y1 - y0);
+  uint32_t remaining = (uint32_t)(x1 - x0) * (y1 - y0);
+  while (remaining > 0) {
+    uint16_t count = remaining < DISPLAY_BUS_SPAN_PIXELS ? remaining : DISPLAY_BUS_SPAN_PIXELS;
+    uint16_t* span = bus->acquireSpan();
+    for (uint16_t i = 0; i < count; i++) {
+      span[i] = color;
+    }
+    bus->queueSpan(count);
+    remaining -= count;
+  }
+  bus->endRegion();
+}
+
+void BusCanvas::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  writeFillRect(x, y, w, 1, color);
+}
+
+void BusCanvas::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  writeFillRect(x, y, 1, h, color);
+}
+
+// ============================================
+// DRAW PRIMITIVES
+// ============================================
+// One transaction each.
+
+void BusCanvas::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  startWrite();
+  writePixel(x, y, color);
+  endWrite();
+}
+
+void BusCanvas::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  startWrite();
+  writeFillRect(x, y, w, h, color);
+  endWrite();
+}
+
+void BusCanvas::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+void BusCanvas::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+void BusCanvas::fillScreen(uint16_t color) {
+  fillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, color);
+}
@@ -0,0 +1,48 @@
+#ifndef BUS_CANVAS_H
+#define BUS_CANVAS_H
+
+#include <Adafruit_GFX.h>
+#include "Config.h"
+#include "DisplayBus.h"
+
+// ============================================
+// Panel Canvas over a DisplayBus
+// ============================================
+// Draws straight onto the panel like the Adafruit driver does, but sends
+// every primitive through a DisplayBus: each rectangle is a region
+// filled from spans. The view draws through it when the DMA transport
+// owns the SPI host, so nothing else touches the host.
+//
+// Pixels written left to right along a row (bitmaps, small text) are
+// merged into one run before they are sent, so a bitmap costs a window
+// per run rather than per pixel.
+class BusCanvas : public Adafruit_GFX {
+  DisplayBus* bus;
+  uint8_t writeDepth;  // Open startWrite() calls; the outermost holds the transaction
+
+  int16_t runX, runY;
+  uint16_t runLength;
+  uint16_t runColor;
+
+  void flushRun();
+
+public:
+  BusCanvas();
+
+  void begin(DisplayBus* b);
+
+  void startWrite() override;
+  void writePixel(int16_t x, int16_t y, uint16_t color) override;
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void endWrite() override;
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void fillScreen(uint16_t color) override;
+};
+
+#endif
@@ -0,0 +1,158 @@
+#include "ClockSync.h"
+
+ClockSync::ClockSync() {
+  reset();
+}
+
+void ClockSync::reset() {
+  memset(&stats, 0, sizeof(stats));
+  sessionUID = 0;
+  started = false;
+  slope = 1.0f;
+  rebase(0.0f, 0);
+}
+
+void ClockSync::rebase(float sessionTime, uint32_t localMS) {
+  baseSessionTime = sessionTime;
+  baseLocalMS = localMS;
+  count = 0;
+  head = 0;
+  blockOpen = false;
+  offsetMS = 0.0f;
+  synced = false;
+  haveLast = false;
+  late = false;
+}
+
+const ClockSync::Sample& ClockSync::at(uint8_t index) const {
+  return samples[(head + CLOCK_SYNC_BLOCKS - count + index) % CLOCK_SYNC_BLOCKS];
+}
+
+void ClockSync::sample(const PacketHeader* header, uint32_t arrivalMS) {
+  float sessionTime = header->m_sessionTime;
+  if (!started || header->m_sessionUID != sessionUID) {
+    reset();
+    started = true;
+    sessionUID = header->m_sessionUID;
+    rebase(sessionTime, arrivalMS);
+  }
+
+  // Packets of one frame share a timestamp and leave back to back; only
+  // the first is timed.
+  int32_t sessionMS = lroundf((sessionTime - baseSessionTime) * 1000.0f);
+  if (haveLast && sessionMS == last.sessionMS) return;
+  if (haveLast && sessionMS < last.sessionMS) {
+    stats.resyncs++;
+    rebase(sessionTime, arrivalMS);
+    sessionMS = 0;
+  }
+  int32_t localMS = (int32_t)(arrivalMS - baseLocalMS);
+
+  if (haveLast) {
+    int32_t sessionStep = sessionMS - last.sessionMS;
+    int32_t transit = (localMS - last.localMS) - sessionStep;
+    stats.jitterMS += (abs(transit) - stats.jitterMS) / 16.0f;
+    if (sessionStep >= CLOCK_STALL_MS && abs(transit) < CLOCK_STALL_MS) stats.sendGaps++;
+  }
+  last.sessionMS = sessionMS;
+  last.localMS = localMS;
+  haveLast = true;
+
+  if (synced) {
+    int32_t delay = localMS - (int32_t)lroundf(predict(sessionMS));
+    stats.delayMS = delay;
+    if (delay > stats.peakDelayMS) stats.peakDelayMS = delay;
+
+    if (delay < CLOCK_STALL_MS) {
+      if (late) stats.networkStalls++;
+      late = false;
+    } else if (!late) {
+      late = true;
+      lateSinceMS = localMS;
+    } else if (localMS - lateSinceMS >= CLOCK_SYNC_BLOCK_MS) {
+      // Still late a block on: the session clock stood still.
+      stats.resyncs++;
+      rebase(sessionTime, arrivalMS);
+      sessionMS = 0;
+      localMS = 0;
+      last.sessionMS = 0;
+      last.localMS = 0;
+      haveLast = true;
+    }
+  }
+
+  // At the nominal rate the least delayed packet has the smallest
+  // difference between the clocks.
+  if (!blockOpen) {
+    blockOpen = true;
+    blockStartMS = localMS;
+    block = last;
+  } else if (localMS - sessionMS < block.localMS - block.sessionMS) {
+    block = last;
+  }
+
+  if (localMS - blockStartMS >= CLOCK_SYNC_BLOCK_MS) {
+    samples[head] = block;
+    head = (head + 1) % CLOCK_SYNC_BLOCKS;
+    if (count < CLOCK_SYNC_BLOCKS) count++;
+    blockOpen = false;
+    fit();
+  }
+}
+
+// The window is a few dozen blocks, so sorting a copy is cheap.
+float ClockSync::median(float* values, uint8_t count) {
+  for (uint8_t i = 1; i < count; i++) {
+    float value = values[i];
+    uint8_t j = i;
+    while (j > 0 && values[j - 1] > value) {
+      values[j] = values[j - 1];
+      j--;
+    }
+    values[j] = value;
+  }
+
+  if (count % 2 == 1) return values[count / 2];
+  return (values[count / 2 - 1] + values[count / 2]) / 2.0f;
+}
+
+void ClockSync::fit() {
+  float values[CLOCK_SYNC_BLOCKS];
+
+  if (count >= CLOCK_SYNC_MIN_BLOCKS) {
+    uint8_t half = count / 2;
+    uint8_t slopes = 0;
+    for (uint8_t i = 0; i < half; i++) {
+      const Sample& a = at(i);
+      const Sample& b = at(i + half);
+      int32_t sessionSpan = b.sessionMS - a.sessionMS;
+      if (sessionSpan > 0) values[slopes++] = (float)(b.localMS - a.localMS) / sessionSpan;
+    }
+    if (slopes > 0) {
+      slope = median(values, slopes);
+      stats.driftPPM = (slope - 1.0f) * 1000000.0f;
+    }
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    values[i] = at(i).localMS - slope * at(i).sessionMS;
+  }
+  offsetMS = median(values, count);
+  synced = true;
+}
+
+uint32_t ClockSync::toLocalMS(float sessionTime) const {
+  int32_t sessionMS = lroundf((sessionTime - baseSessionTime) * 1000.0f);
+  return baseLocalMS + (uint32_t)(int32_t)lroundf(predict(sessionMS));
+}
+
+float ClockSync::toSessionTime(uint32_t localMS) const {
+  int32_t sinceBase = (int32_t)(localMS - baseLocalMS);
+  return baseSessionTime + (sinceBase - offsetMS) / slope / 1000.0f;
+}
+
+uint32_t ClockSync::packetTimeMS(float sessionTime, uint32_t arrivalMS) const {
+  if (!synced) return arrivalMS;
+  uint32_t localMS = toLocalMS(sessionTime);
+  return (int32_t)(arrivalMS - localMS) < 0 ? arrivalMS : localMS;
+}
@@ -0,0 +1,102 @@
+#ifndef CLOCK_SYNC_H
+#define CLOCK_SYNC_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// ============================================
+// Session Clock Sync
+// ============================================
+// Relates the header's m_sessionTime to millis(). Packets arrive late by
+// a floor delay plus jitter, never early. The fit is therefore made
+// through the least delayed packet of each CLOCK_SYNC_BLOCK_MS block.
+// The slope is the median of the slopes between blocks half the window
+// apart, and the offset is the median of the blocks' residuals (a
+// Theil-Sen line), so a few late blocks do not move it. Refitting costs
+// two small sorts per block.
+//
+// Against the fit, each packet's delay separates the two kinds of
+// stall. A run of late packets that catches up is the network or the
+// loop. A jump in session time with packets on time is the game not
+// sending: a hitch, or packets lost. A run that never catches up means
+// the session clock stopped (a pause), and a timestamp that goes back
+// is a flashback or a restart. Either one restarts the fit; the drift
+// is kept, since it belongs to the two clocks and not the session.
+class ClockSync {
+public:
+  struct Stats {
+    float driftPPM;          // Local clock fast (+) against the game's; 0 until measured
+    float jitterMS;          // Interarrival jitter, as RFC 3550 defines it
+    int32_t delayMS;         // Latest packet against the fit
+    int32_t peakDelayMS;     // Largest since resetPeak()
+    uint32_t networkStalls;  // Late by CLOCK_STALL_MS, then caught up
+    uint32_t sendGaps;       // Session time jumped CLOCK_STALL_MS with packets on time
+    uint32_t resyncs;        // Session clock stopped or went back; the fit restarted
+  };
+
+private:
+  struct Sample {
+    int32_t sessionMS;  // Since the base
+    int32_t localMS;
+  };
+
+  Sample samples[CLOCK_SYNC_BLOCKS];  // Ring of block minima
+  uint8_t count;
+  uint8_t head;  // Next slot to write
+
+  Sample block;  // Least delayed packet of the open block
+  int32_t blockStartMS;
+  bool blockOpen;
+
+  uint64_t sessionUID;
+  float baseSessionTime;  // s
+  uint32_t baseLocalMS;
+  bool started;
+
+  float slope;     // Local ms per session ms
+  float offsetMS;  // Local time at the base session time
+  bool synced;
+
+  Sample last;  // Latest packet with a new timestamp
+  bool haveLast;
+  int32_t lateSinceMS;
+  bool late;
+
+  Stats stats;
+
+  const Sample& at(uint8_t index) const;  // Oldest first
+  void rebase(float sessionTime, uint32_t localMS);
+  void fit();
+  float predict(int32_t sessionMS) const {
+    return offsetMS + slope * sessionMS;
+  }
+  static float median(float* values, uint8_t count);
+
+public:
+  ClockSync();
+  void reset();
+
+  void sample(const PacketHeader* header, uint32_t arrivalMS);
+
+  // False until the first block has closed; the conversions below then
+  // assume the nominal rate until the drift is measured.
+  bool isSynced() const {
+    return synced;
+  }
+  // The millis() a packet stamped sessionTime arrives at with no more
+  // than the usual delay.
+  uint32_t toLocalMS(float sessionTime) const;
+  float toSessionTime(uint32_t localMS) const;
+  // toLocalMS() of a packet just received, never later than its arrival;
+  // the arrival itself until synced.
+  uint32_t packetTimeMS(float sessionTime, uint32_t arrivalMS) const;
+
+  const Stats& getStats() const {
+    return stats;
+  }
+  void resetPeak() {
+    stats.peakDelayMS = stats.delayMS;
+  }
+};
+
+#endif
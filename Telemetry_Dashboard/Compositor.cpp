@@ -0,0 +1,171 @@
+#include "Compositor.h"
+
+Compositor::Compositor() {
+  bus = NULL;
+  arenaUsed = 0;
+  tileCount = 0;
+  tileOpen = false;
+  regionCount = 0;
+  resetStats();
+}
+
+void Compositor::resetStats() {
+  stats.tiles = 0;
+  stats.regions = 0;
+  stats.transactions = 0;
+  stats.bytes = 0;
+  sprite.resetStats();
+}
+
+// ============================================
+// TILES
+// ============================================
+
+Adafruit_GFX* Compositor::beginTile(int16_t x, int16_t y, int16_t w, int16_t h) {
+  uint32_t size = Sprite::bufferSize(w, h);
+  if (w <= 0 || h <= 0 || w > SCREEN_WIDTH || size > COMPOSITOR_ARENA_BYTES) {
+    return NULL;
+  }
+
+  if (tileCount == COMPOSITOR_MAX_TILES || arenaUsed + size > COMPOSITOR_ARENA_BYTES) {
+    flush();
+  }
+
+  Tile& tile = tiles[tileCount];
+  tile.x = x;
+  tile.y = y;
+  tile.w = w;
+  tile.h = h;
+  tile.offset = arenaUsed;
+
+  sprite.begin(x, y, w, h, &arena[arenaUsed]);
+  arenaUsed += size;
+  tileOpen = true;
+  return &sprite;
+}
+
+void Compositor::endTile() {
+  if (!tileOpen) return;
+
+  Tile& tile = tiles[tileCount];
+  tile.paletteSize = sprite.getPaletteSize();
+  memcpy(tile.palette, sprite.getPalette(), tile.paletteSize * sizeof(uint16_t));
+
+  tileCount++;
+  tileOpen = false;
+  stats.tiles++;
+}
+
+// ============================================
+// MERGE & FLUSH
+// ============================================
+
+static bool mergeable(int16_t ax, int16_t ay, int16_t aw, int16_t ah, int16_t bx, int16_t by, int16_t bw, int16_t bh) {
+  if (ax == bx && aw == bw) {
+    return by <= ay + ah && ay <= by + bh;
+  }
+  if (ay == by && ah == bh) {
+    return bx <= ax + aw && ax <= bx + bw;
+  }
+  return false;
+}
+
+void Compositor::buildRegions() {
+  regionCount = tileCount;
+  for (uint8_t i = 0; i < tileCount; i++) {
+    regions[i].x = tiles[i].x;
+    regions[i].y = tiles[i].y;
+    regions[i].w = tiles[i].w;
+    regions[i].h = tiles[i].h;
+    regions[i].members = 1UL << i;
+  }
+
+  // A merge can make the grown region mergeable with another, so repeat
+  // until nothing changes; at most COMPOSITOR_MAX_TILES entries.
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (uint8_t a = 0; a < regionCount && !merged; a++) {
+      for (uint8_t b = a + 1; b < regionCount; b++) {
+        Region& ra = regions[a];
+        const Region& rb = regions[b];
+        if (!mergeable(ra.x, ra.y, ra.w, ra.h, rb.x, rb.y, rb.w, rb.h)) continue;
+
+        int16_t x0 = min(ra.x, rb.x);
+        int16_t y0 = min(ra.y, rb.y);
+        int16_t x1 = max((int16_t)(ra.x + ra.w), (int16_t)(rb.x + rb.w));
+        int16_t y1 = max((int16_t)(ra.y + ra.h), (int16_t)(rb.y + rb.h));
+        ra.x = x0;
+        ra.y = y0;
+        ra.w = x1 - x0;
+        ra.h = y1 - y0;
+        ra.members |= rb.members;
+
+        regions[b] = regions[--regionCount];
+        merged = true;
+        break;
+      }
+    }
+  }
+
+  // Scanline order: top to bottom, then left to right.
+  for (uint8_t i = 1; i < regionCount; i++) {
+    Region r = regions[i];
+    int8_t j = i - 1;
+    while (j >= 0 && (regions[j].y > r.y || (regions[j].y == r.y && regions[j].x > r.x))) {
+      regions[j + 1] = regions[j];
+      j--;
+    }
+    regions[j + 1] = r;
+  }
+}
+
+void Compositor::sendRegion(const Region& region) {
+  bus->beginRegion(region.x, region.y, region.w, region.h);
+
+  uint16_t* span = bus->acquireSpan();
+  uint16_t used = 0;
+  for (int16_t y = region.y; y < region.y + region.h; y++) {
+    if (used + region.w > DISPLAY_BUS_SPAN_PIXELS) {
+      bus->queueSpan(used);
+      span = bus->acquireSpan();
+      used = 0;
+    }
+
+    for (uint8_t i = 0; i < tileCount; i++) {
+      if (!(region.members & (1UL << i))) continue;
+
+      const Tile& tile = tiles[i];
+      if (y < tile.y || y >= tile.y + tile.h) continue;
+
+      const uint8_t* src = &arena[tile.offset + (uint32_t)(y - tile.y) * ((tile.w + 1) / 2)];
+      uint16_t* out = &span[used + (tile.x - region.x)];
+      for (int16_t col = 0; col < tile.w; col++) {
+        uint8_t cell = src[col >> 1];
+        out[col] = tile.palette[(col & 1) ? (cell & 0x0F) : (cell >> 4)];
+      }
+    }
+    used += region.w;
+  }
+  bus->queueSpan(used);
+  bus->endRegion();
+
+  stats.regions++;
+  stats.bytes += DISPLAY_ADDR_WINDOW_BYTES + (uint32_t)region.w * region.h * 2;
+}
+
+void Compositor::flush() {
+  if (tileCount == 0 || !bus) return;
+
+  buildRegions();
+
+  bus->beginTransaction();
+  for (uint8_t i = 0; i < regionCount; i++) {
+    sendRegion(regions[i]);
+  }
+  bus->endTransaction();
+  stats.transactions++;
+
+  tileCount = 0;
+  arenaUsed = 0;
+}
@@ -0,0 +1,82 @@
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include <Adafruit_GFX.h>
+#include "Config.h"
+#include "DisplayBus.h"
+#include "Sprite.h"
+
+// ============================================
+// Dirty-Rectangle Compositor
+// ============================================
+// Widgets render into 4bpp tiles carved from one arena during a render
+// pass. flush() merges tiles whose union is exactly their bounding box
+// (stacked with the same columns, or side by side with the same rows),
+// orders the result by scanline and sends everything in one bus
+// transaction. Tiles are never merged across gaps: the pixels between
+// them belong to the static layout and are not in RAM.
+class Compositor {
+public:
+  // Per-flush instrumentation, summed until resetStats().
+  struct Stats {
+    uint32_t tiles;         // widget rectangles submitted
+    uint32_t regions;       // address windows sent after merging
+    uint32_t transactions;  // startWrite/endWrite pairs
+    uint32_t bytes;         // SPI bytes including window setup
+  };
+
+private:
+  struct Tile {
+    int16_t x, y, w, h;
+    uint16_t offset;
+    uint8_t paletteSize;
+    uint16_t palette[SPRITE_PALETTE_SIZE];
+  };
+
+  struct Region {
+    int16_t x, y, w, h;
+    uint32_t members;  // bit per tile, composed in submission order
+  };
+  static_assert(COMPOSITOR_MAX_TILES <= 32, "Region::members holds one bit per tile");
+
+  Sprite sprite;
+  DisplayBus* bus;
+
+  uint8_t arena[COMPOSITOR_ARENA_BYTES];
+  uint16_t arenaUsed;
+  Tile tiles[COMPOSITOR_MAX_TILES];
+  uint8_t tileCount;
+  bool tileOpen;
+
+  Region regions[COMPOSITOR_MAX_TILES];
+  uint8_t regionCount;
+
+  Stats stats;
+
+  void buildRegions();
+  void sendRegion(const Region& region);
+
+public:
+  Compositor();
+
+  void attachBus(DisplayBus* b) {
+    bus = b;
+  }
+
+  // Opens a tile over the region and returns the surface to draw on, or
+  // NULL if the region can never fit the arena. Flushes first if the
+  // arena or tile table is full.
+  Adafruit_GFX* beginTile(int16_t x, int16_t y, int16_t w, int16_t h);
+  void endTile();
+  void flush();
+
+  const Stats& getStats() const {
+    return stats;
+  }
+  const Sprite& getSprite() const {
+    return sprite;
+  }
+  void resetStats();
+};
+
+#endif
@@ -9,6 +9,8 @@
 const uint8_t PIN_TFT_CS = 15;
 const uint8_t PIN_TFT_DC = 2;
 const uint8_t PIN_TFT_RST = 4;
+const uint8_t PIN_TFT_MOSI = 23;  // VSPI defaults, shared with the DMA transport
+const uint8_t PIN_TFT_SCLK = 18;
 
 const uint8_t PIN_LED_STRIP = 13;
 const uint8_t NUM_LEDS = 8;
@@ -33,6 +35,106 @@ const uint16_t COLOR_ORANGE = 0xFD20;
 const uint16_t COLOR_DARKGREY = 0x7BEF;
 const uint16_t COLOR_MAGENTA = 0xF81F;
 
+// Widgets render off-screen into 4bpp palette tiles and are flushed
+// together at the end of each frame. 8 KB holds 16384 pixels: any single
+// widget (largest is the 318x22 tyre header) and a typical frame's worth
+// of changes; a full screen redraw flushes as the arena fills.
+#define ENABLE_SPRITES 1
+const uint16_t COMPOSITOR_ARENA_BYTES = 8192;
+const uint8_t COMPOSITOR_MAX_TILES = 32;
+const uint8_t SPRITE_PALETTE_SIZE = 16;
+
+// Compositor flushes go over DMA with two alternating span buffers on ESP32;
+// otherwise, or if the DMA device fails to start, they block. With DMA the
+// transport owns the SPI host, and all drawing goes through it.
+#define ENABLE_DMA_DISPLAY 1
+const uint32_t DISPLAY_SPI_FREQUENCY = 40000000;
+
+// Each screen's static layout is captured once at boot as a run-length
+// encoded 4bpp image and streamed back on a screen switch instead of being
+// redrawn. A frames-and-labels layout encodes to roughly 4 KB; a screen
+// that does not fit in the pool is drawn the slow way.
+#define ENABLE_BACKGROUND_CACHE 1
+const uint16_t BACKGROUND_POOL_BYTES = 24576;
+const uint8_t BACKGROUND_BAND_ROWS = 16;
+
+// The input trace screen plots throttle, brake and steering one column per
+// telemetry packet and scrolls with the panel's hardware scroll, so a new
+// sample costs one 240-pixel column. The history refills the plot after a
+// screen switch.
+const uint16_t INPUT_HISTORY_SAMPLES = 512;
+const int16_t INPUT_TRACE_LABEL_WIDTH = 40;  // Fixed label area left of the plot
+
+// The track map is recorded from the player's motion over one full lap,
+// reduced to a fixed-size outline and kept per track ID for the session.
+const uint16_t TRACK_RAW_POINTS = 512;    // Recording buffer, ~14 m apart on a 7 km lap
+const uint8_t TRACK_OUTLINE_POINTS = 64;  // After simplification
+const float TRACK_OUTLINE_TOLERANCE = 3.0f;  // Metres; simplification stops below this
+const uint8_t TRACK_MAP_CACHE_SIZE = 4;
+
+// Race control events (fastest lap, penalties, flags) queue for a banner
+// across the top of the screen, shown one at a time with an LED and
+// buzzer cue.
+const uint8_t EVENT_QUEUE_SIZE = 4;     // Oldest is dropped when full
+const uint16_t EVENT_BANNER_MS = 2500;
+
+// Participant names are decoded once per session into a shared string
+// pool, with a three-letter code per car for narrow columns.
+const uint8_t PARTICIPANT_NAME_LENGTH = 15;  // Longer names are cut
+const uint16_t PARTICIPANT_POOL_BYTES = 22 * (PARTICIPANT_NAME_LENGTH + 1) + 1;  // Every car, plus the empty name
+
+// The friction circle beside the map keeps a short trail of lateral and
+// longitudinal G. Motion frames are averaged in groups before they enter
+// the trail, which fades with age.
+const uint8_t GFORCE_HISTORY_POINTS = 48;  // Multiple of 4, one colour per quarter
+const uint8_t GFORCE_DECIMATION = 3;       // Motion frames per trail point (~20 Hz at 60 Hz)
+const float GFORCE_RANGE = 5.0f;           // G at the edge of the circle
+
+// Lap and sector times for every car from the session history packet,
+// packed to 8 bytes a lap. The history screen lists the player's recent
+// laps with consistency figures kept up to date as laps arrive.
+const uint8_t LAP_HISTORY_LAPS = 100;  // Per car, as many as the packet carries (~20 KB for 22 cars)
+const uint8_t LAP_HISTORY_ROWS = 10;   // Laps listed on the history screen
+
+// The strategy screen lists the player's available tyre sets and up to
+// TYRE_SUGGESTIONS sets to fit next, the freshest set of each compound
+// ranked by the game's lap delta.
+const uint8_t TYRE_SET_COUNT = 20;  // 13 dry and 7 wet, as in the packet
+const uint8_t TYRE_SET_ROWS = 11;
+const uint8_t TYRE_SUGGESTIONS = 3;
+
+// Fuel burn is measured per lap from the tank level and predicted to the
+// flag at every mini-sector; see FuelModel.
+const uint8_t FUEL_WINDOW_LAPS = 5;          // Clean laps in the median
+const uint8_t FUEL_MINI_SECTORS = 10;        // Samples per lap
+const float FUEL_MIN_PARTIAL_LAP = 0.25f;    // Share of a lap before the first estimate
+constexpr float FUEL_NO_ESTIMATE = -100.0f;  // Field value when there is nothing to show
+
+// Tyre wear is fitted per corner against laps on the set, weighted by
+// carcass temperature, at the same samples as the fuel; see TyreWearModel.
+const float TYRE_WEAR_CLIFF = 70.0f;         // % wear where the prediction ends
+const float TYRE_REFERENCE_TEMP = 100.0f;    // C; a lap here counts as one
+const float TYRE_TEMP_WEAR_FACTOR = 0.02f;   // Extra share of a lap per degree above
+const uint8_t TYRE_WEAR_MIN_SAMPLES = 10;    // About a lap before the first prediction
+
+// Pit strategy: plans for the rest of the race with none, one or two
+// stops are scored from the tyre sets, the wear trend and the timed pit
+// loss, a slice at a time, on a low-priority task on the core the loop
+// does not use; see StrategyPlanner. Without the task the slices run in
+// the loop after each frame.
+#define ENABLE_STRATEGY_TASK 1
+const uint8_t STRATEGY_TASK_CORE = 0;                 // The loop runs on core 1
+const uint8_t STRATEGY_TASK_PRIORITY = 1;             // Just above idle, below WiFi
+const uint16_t STRATEGY_TASK_STACK = 4096;
+const uint16_t STRATEGY_SLICE_PLANS = 256;            // Plans scored between yields
+const uint16_t STRATEGY_IDLE_MS = 100;                // Task sleep with nothing to search
+const uint32_t STRATEGY_REFRESH_MS = 5000;            // New inputs at least this often, and every lap
+const uint8_t STRATEGY_MAX_OPTIONS = 5;               // One per compound
+const uint16_t STRATEGY_DEFAULT_PIT_LOSS_MS = 22000;  // Until a stop has been timed
+const uint16_t STRATEGY_PIT_BYPASS_MS = 5000;         // Track time the pit lane stands in for
+const float STRATEGY_WEAR_COST_MS = 30.0f;            // Lap time lost per % of wear
+const float STRATEGY_CLIFF_COST_MS = 1500.0f;         // More per lap past TYRE_WEAR_CLIFF
+
 // ==========================================
 // 3. NETWORK SETTINGS
 // ==========================================
@@ -41,13 +143,31 @@ const char WIFI_AP_SSID[] = "Telemetry_Dashboard";
 const char WIFI_AP_PASSWORD[] = "44168104";
 const uint16_t PACKET_BUFFER_SIZE = 2048;
 
+// The game's session clock is mapped onto millis() by a robust line fit
+// through the least delayed packet of each block, giving one timebase
+// for extrapolation and logs and a measure of network jitter; see
+// ClockSync.
+const uint16_t CLOCK_SYNC_BLOCK_MS = 500;  // One sample per block
+const uint8_t CLOCK_SYNC_BLOCKS = 64;      // Fit window, ~32 s
+const uint8_t CLOCK_SYNC_MIN_BLOCKS = 8;   // Before the drift is measured; nominal rate until then
+const uint16_t CLOCK_STALL_MS = 150;       // Gaps and delays past this are stall events
+
 // ==========================================
 // 4. TIMING & UPDATE RATES
 // ==========================================
 const uint32_t SERIAL_BAUD_RATE = 115200;
 const uint32_t DISPLAY_UPDATE_INTERVAL = 50;
+const uint32_t RENDER_BUDGET_MICROS = 20000;  // Widget time per frame; critical widgets ignore it
+const uint16_t RENDER_STARVATION_MS = 500;    // Deferred this long, a widget runs regardless of budget
 const uint32_t BOOT_ANIMATION_DURATION = 2000;
 
+// Between Lap Data packets the lap time and distance are carried forward
+// on the local clock and the latest speed, so the lap timer and live
+// delta move at the display rate rather than the packet rate.
+const uint16_t LIVE_LAP_MAX_EXTRAPOLATION_MS = 250;  // Then hold until the next packet
+const uint16_t LIVE_LAP_BLEND_MS = 100;              // A packet's correction is spread over this
+const float LIVE_LAP_SNAP_M = 10.0f;                 // Larger distance errors are taken at once
+
 // ==========================================
 // 5. LED CONFIGURATION
 // ==========================================
@@ -57,7 +177,22 @@ const uint8_t LED_YELLOW_COUNT = 3;
 const uint8_t LED_RED_COUNT = 2;
 
 // ==========================================
-// 6. ENUMS
+// 6. DEBUG OPTIONS
+// ==========================================
+// Compile-time switches; disabled features are not built at all.
+#define ENABLE_MODEL_BENCHMARK 0        // Time table-driven decode vs hand-written copy at boot
+#define ENABLE_GLYPH_BENCHMARK 0        // Time scaled-font digits vs pre-rasterized glyphs at boot
+#define ENABLE_INPUT_TRACE_BENCHMARK 0  // Pixels and cycles per sample: scrolled column vs full plot redraw
+#define ENABLE_PACKET_STATS 0           // Print per-packet skip rates and clock sync to serial
+#define ENABLE_RENDER_STATS 0           // Print per-screen frame time and SPI bytes to serial
+#define ENABLE_TRACE 0                  // Time loop stages; send 't' over serial to dump, 'r' to reset
+#define ENABLE_TRACE_OVERLAY 0          // With ENABLE_TRACE, show fps, packet rate and render time on screen
+
+const uint32_t STATS_INTERVAL = 5000;
+const uint16_t TRACE_BUFFER_EVENTS = 128;  // Most recent stage timings kept for the serial dump
+
+// ==========================================
+// 7. ENUMS
 // ==========================================
 enum SessionType {
   SESSION_UNKNOWN = 0,
@@ -84,19 +219,25 @@ enum DRSStatus {
 
 
 // ==========================================
-// 7. F1 GAME PACKET IDs
+// 8. F1 GAME PACKET IDs
 // ==========================================
+const uint8_t PACKET_ID_MOTION = 0;
 const uint8_t PACKET_ID_SESSION = 1;
 const uint8_t PACKET_ID_LAP_DATA = 2;
+const uint8_t PACKET_ID_EVENT = 3;
+const uint8_t PACKET_ID_PARTICIPANTS = 4;
 const uint8_t PACKET_ID_CAR_SETUPS = 5;
 const uint8_t PACKET_ID_CAR_TELEMETRY = 6;
 const uint8_t PACKET_ID_CAR_STATUS = 7;
 const uint8_t PACKET_ID_CAR_DAMAGE = 10;
+const uint8_t PACKET_ID_SESSION_HISTORY = 11;
+const uint8_t PACKET_ID_TYRE_SETS = 12;
+const uint8_t PACKET_ID_COUNT = 15;
 
 const uint8_t MAX_CARS = 22;
 
 // ==========================================
-// 8. F1 2023 PACKET STRUCTURES
+// 9. F1 2023 PACKET STRUCTURES
 // ==========================================
 struct __attribute__((packed)) PacketHeader {
   uint16_t m_packetFormat;            // 2023
@@ -356,6 +497,147 @@ struct __attribute__((packed)) PacketCarDamageData {
   CarDamageData m_carDamageData[22];
 };
 
+struct __attribute__((packed)) CarMotionData {
+  float m_worldPositionX;      // World space X position - metres
+  float m_worldPositionY;      // World space Y position
+  float m_worldPositionZ;      // World space Z position
+  float m_worldVelocityX;      // Velocity in world space X - metres/s
+  float m_worldVelocityY;      // Velocity in world space Y
+  float m_worldVelocityZ;      // Velocity in world space Z
+  int16_t m_worldForwardDirX;  // World space forward X direction (normalised)
+  int16_t m_worldForwardDirY;  // World space forward Y direction (normalised)
+  int16_t m_worldForwardDirZ;  // World space forward Z direction (normalised)
+  int16_t m_worldRightDirX;    // World space right X direction (normalised)
+  int16_t m_worldRightDirY;    // World space right Y direction (normalised)
+  int16_t m_worldRightDirZ;    // World space right Z direction (normalised)
+  float m_gForceLateral;       // Lateral G-Force component
+  float m_gForceLongitudinal;  // Longitudinal G-Force component
+  float m_gForceVertical;      // Vertical G-Force component
+  float m_yaw;                 // Yaw angle in radians
+  float m_pitch;               // Pitch angle in radians
+  float m_roll;                // Roll angle in radians
+};
+
+struct __attribute__((packed)) PacketMotionData {
+  PacketHeader m_header;  // Header
+
+  CarMotionData m_carMotionData[22];  // Data for all cars on track
+};
+
+// Event details, selected by m_eventStringCode. Only the events the
+// dashboard reacts to are listed.
+union __attribute__((packed)) EventDataDetails {
+  struct __attribute__((packed)) {
+    uint8_t vehicleIdx;  // Vehicle index of car achieving fastest lap
+    float lapTime;       // Lap time is in seconds
+  } FastestLap;
+
+  struct __attribute__((packed)) {
+    uint8_t penaltyType;       // Penalty type - see appendix
+    uint8_t infringementType;  // Infringement type - see appendix
+    uint8_t vehicleIdx;        // Vehicle index of the car the penalty is applied to
+    uint8_t otherVehicleIdx;   // Vehicle index of the other car involved
+    uint8_t time;              // Time gained, or time spent doing action in seconds
+    uint8_t lapNum;            // Lap the penalty occurred on
+    uint8_t placesGained;      // Number of places gained by this
+  } Penalty;
+
+  struct __attribute__((packed)) {
+    uint8_t vehicleIdx;
+    float speed;
+    uint8_t isOverallFastestInSession;
+    uint8_t isDriverFastestInSession;
+    uint8_t fastestVehicleIdxInSession;
+    float fastestSpeedInSession;
+  } SpeedTrap;  // Largest member; sets the packet size
+
+  struct __attribute__((packed)) {
+    uint32_t flashbackFrameIdentifier;  // Frame identifier flashed back to
+    float flashbackSessionTime;         // Session time flashed back to
+  } Flashback;
+};
+
+struct __attribute__((packed)) PacketEventData {
+  PacketHeader m_header;  // Header
+
+  uint8_t m_eventStringCode[4];     // Event string code, e.g. "FTLP"
+  EventDataDetails m_eventDetails;  // Event details - should be interpreted differently for each type
+};
+
+struct __attribute__((packed)) ParticipantData {
+  uint8_t m_aiControlled;     // Whether the vehicle is AI (1) or Human (0) controlled
+  uint8_t m_driverId;         // Driver id - see appendix, 255 if network human
+  uint8_t m_networkId;        // Network id - unique identifier for network players
+  uint8_t m_teamId;           // Team id - see appendix
+  uint8_t m_myTeam;           // My team flag - 1 = My Team, 0 = otherwise
+  uint8_t m_raceNumber;       // Race number of the car
+  uint8_t m_nationality;      // Nationality of the driver
+  char m_name[48];            // Name of participant in UTF-8 format - null terminated
+  uint8_t m_yourTelemetry;    // The player's UDP setting, 0 = restricted, 1 = public
+  uint8_t m_showOnlineNames;  // The player's show online names setting, 0 = off, 1 = on
+  uint8_t m_platform;         // 1 = Steam, 3 = PlayStation, 4 = Xbox, 6 = Origin, 255 = unknown
+};
+
+struct __attribute__((packed)) PacketParticipantsData {
+  PacketHeader m_header;  // Header
+
+  uint8_t m_numActiveCars;  // Number of active cars in the data - should match number of cars on HUD
+  ParticipantData m_participants[22];
+};
+
+struct __attribute__((packed)) LapHistoryData {
+  uint32_t m_lapTimeInMS;       // Lap time in milliseconds
+  uint16_t m_sector1TimeInMS;   // Sector 1 milliseconds part
+  uint8_t m_sector1TimeMinutes; // Sector 1 whole minute part
+  uint16_t m_sector2TimeInMS;   // Sector 2 milliseconds part
+  uint8_t m_sector2TimeMinutes; // Sector 2 whole minute part
+  uint16_t m_sector3TimeInMS;   // Sector 3 milliseconds part
+  uint8_t m_sector3TimeMinutes; // Sector 3 whole minute part
+  uint8_t m_lapValidBitFlags;   // 0x01 bit set-lap valid, 0x02 bit set-sector 1 valid
+                                // 0x04 bit set-sector 2 valid, 0x08 bit set-sector 3 valid
+};
+
+struct __attribute__((packed)) TyreStintHistoryData {
+  uint8_t m_endLap;              // Lap the tyre usage ends on (255 of current tyre)
+  uint8_t m_tyreActualCompound;  // Actual tyres used by this driver
+  uint8_t m_tyreVisualCompound;  // Visual tyres used by this driver
+};
+
+struct __attribute__((packed)) PacketSessionHistoryData {
+  PacketHeader m_header;  // Header
+
+  uint8_t m_carIdx;             // Index of the car this lap data relates to
+  uint8_t m_numLaps;            // Num laps in the data (including current partial lap)
+  uint8_t m_numTyreStints;      // Number of tyre stints in the data
+  uint8_t m_bestLapTimeLapNum;  // Lap the best lap time was achieved on
+  uint8_t m_bestSector1LapNum;  // Lap the best Sector 1 time was achieved on
+  uint8_t m_bestSector2LapNum;  // Lap the best Sector 2 time was achieved on
+  uint8_t m_bestSector3LapNum;  // Lap the best Sector 3 time was achieved on
+
+  LapHistoryData m_lapHistoryData[100];  // 100 laps of data max
+  TyreStintHistoryData m_tyreStintsHistoryData[8];
+};
+
+struct __attribute__((packed)) TyreSetData {
+  uint8_t m_actualTyreCompound;  // Actual tyre compound used
+  uint8_t m_visualTyreCompound;  // Visual tyre compound used
+  uint8_t m_wear;                // Tyre wear (percentage)
+  uint8_t m_available;           // Whether this set is currently available
+  uint8_t m_recommendedSession;  // Recommended session for tyre set
+  uint8_t m_lifeSpan;            // Laps left in this tyre set
+  uint8_t m_usableLife;          // Max number of laps recommended for this compound
+  int16_t m_lapDeltaTime;        // Lap delta time in milliseconds compared to fitted set
+  uint8_t m_fitted;              // Whether the set is fitted or not
+};
+
+struct __attribute__((packed)) PacketTyreSetsData {
+  PacketHeader m_header;  // Header
+
+  uint8_t m_carIdx;               // Index of the car this data relates to
+  TyreSetData m_tyreSetData[20];  // 13 (dry) + 7 (wet)
+  uint8_t m_fittedIdx;            // Index into array of fitted tyre
+};
+
 
 const unsigned char F1_LOGO[] PROGMEM = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0xff, 0xff, 0xff,
@@ -1,22 +1,62 @@
 #include "Controller.h"
+#include "ModelBenchmark.h"
+#include "GlyphBenchmark.h"
+#include "InputTraceBenchmark.h"
+
+// FNV-1a: a few cycles per byte, and a collision only costs one missed
+// update until the next change.
+static uint32_t hashPayload(const void* data, size_t length) {
+  const uint8_t* bytes = (const uint8_t*)data;
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= bytes[i];
+    hash *= 16777619UL;
+  }
+  return hash;
+}
 
 TelemetryController::TelemetryController(TelemetryModel* m, TelemetryView* v, WiFiUDP* u) {
   model = m;
   view = v;
   udp = u;
 
+  model->attachCache(&packetCache);
+
   bootState = BOOT_ANIMATION;
   bootStartTime = 0;
   firstPacketReceived = false;
   lastDisplayUpdate = 0;
+  lastSafetyCarStatus = 0;
+  safetyCarSessionUID = 0;
+
+  strategyOnTask = false;
+  lastStrategySubmit = 0;
+  lastStrategyLap = 0;
 
   lastGear = -99;
   lastDRSAvailable = 0;
+
+  lastStatsPrint = 0;
+  for (uint8_t i = 0; i < PACKET_ID_COUNT; i++) {
+    payloadFilters[i].received = 0;
+    payloadFilters[i].skipped = 0;
+  }
+  resetPayloadFilters();
 }
 
 void TelemetryController::init() {
   Serial.begin(SERIAL_BAUD_RATE);
 
+#if ENABLE_MODEL_BENCHMARK
+  runModelBenchmark(Serial);
+#endif
+#if ENABLE_GLYPH_BENCHMARK
+  runGlyphBenchmark(Serial);
+#endif
+#if ENABLE_INPUT_TRACE_BENCHMARK
+  runInputTraceBenchmark(Serial);
+#endif
+
   pinMode(PIN_BUTTON, INPUT_PULLUP);
   pinMode(PIN_BUZZER, OUTPUT);
   digitalWrite(PIN_BUZZER, LOW);
@@ -25,6 +65,7 @@ void TelemetryController::init() {
   setupWiFi();
 
   udp->begin(UDP_PORT);
+  strategyOnTask = strategy.begin();
 
   bootStartTime = millis();
   bootState = BOOT_ANIMATION;
@@ -65,19 +106,62 @@ void TelemetryController::update() {
 
   handleNetworkPackets();
 
+#if ENABLE_TRACE
+  trace.tick(currentTime);
+  handleSerialCommands();
+#endif
+
   if (WiFi.softAPgetStationNum() == 0 && firstPacketReceived) {
     bootState = BOOT_WAITING;
     firstPacketReceived = false;
+    resetPayloadFilters();
+    sessionClock.reset();
     view->resetBootInfo();
     return;
   }
 
   checkBuzzerTriggers();
+  handleEvents();
+
+#if ENABLE_PACKET_STATS || ENABLE_RENDER_STATS
+  if (currentTime - lastStatsPrint >= STATS_INTERVAL) {
+#if ENABLE_PACKET_STATS
+    printPacketStats();
+#endif
+#if ENABLE_RENDER_STATS
+    view->printRenderStats(Serial);
+    view->printWidgetStats(Serial);
+#endif
+    lastStatsPrint = currentTime;
+  }
+#endif
 
   if (currentTime - lastDisplayUpdate >= DISPLAY_UPDATE_INTERVAL) {
+    // After this loop's packets, so none is stamped later than the frame.
+    model->extrapolateLap(millis());
     view->render();
     lastDisplayUpdate = currentTime;
   }
+
+  updateStrategy(currentTime);
+}
+
+// Without the planner task, one slice of the search runs here, after the
+// frame, so it only takes time the loop would otherwise spend polling.
+void TelemetryController::updateStrategy(uint32_t currentTime) {
+  uint8_t lap = model->getCurrentLapNum();
+  if (lap != lastStrategyLap || currentTime - lastStrategySubmit >= STRATEGY_REFRESH_MS) {
+    StrategyPlanner::Inputs inputs;
+    model->buildStrategyInputs(inputs);
+    strategy.submit(inputs);
+    lastStrategyLap = lap;
+    lastStrategySubmit = currentTime;
+  }
+
+  if (!strategyOnTask) strategy.runSlice();
+
+  StrategyPlanner::Plan plan;
+  if (strategy.poll(plan)) model->updateStrategy(plan);
 }
 
 void TelemetryController::handleButtonPress() {
@@ -97,28 +181,53 @@ void TelemetryController::handleButtonPress() {
 }
 
 void TelemetryController::handleNetworkPackets() {
+  TRACE_SCOPE(TRACE_NETWORK);
   int packetSize = udp->parsePacket();
 
   if (packetSize > 0) {
+    uint32_t arrivalMS = millis();
+    TRACE_COUNT(countPacket);
     int len = udp->read(packetBuffer, PACKET_BUFFER_SIZE);
+    if (len < packetSize) {
+      // Truncated; the size checks below reject it.
+      TRACE_COUNT(countDrop);
+    }
     if (len > 0) {
-      processPacket(packetBuffer, len);
+      processPacket(packetBuffer, len, arrivalMS);
     }
   }
 }
 
-void TelemetryController::processPacket(uint8_t* buffer, int size) {
+void TelemetryController::processPacket(uint8_t* buffer, int size, uint32_t arrivalMS) {
+  TRACE_SCOPE(TRACE_PACKET);
   if (!firstPacketReceived) {
     firstPacketReceived = true;
   }
 
   if (size < sizeof(PacketHeader)) {
+    TRACE_COUNT(countDrop);
     return;
   }
 
   PacketHeader* header = (PacketHeader*)buffer;
   uint8_t playerIndex = header->m_playerCarIndex;
+  sessionClock.sample(header, arrivalMS);
 
+  if (header->m_packetId < PACKET_ID_COUNT) {
+    payloadFilters[header->m_packetId].received++;
+  }
+  // Spectating reports player index 255; there is no player slice to
+  // read, but session-wide packets still apply.
+  bool sessionWide = header->m_packetId == PACKET_ID_SESSION || header->m_packetId == PACKET_ID_EVENT ||
+                     header->m_packetId == PACKET_ID_PARTICIPANTS || header->m_packetId == PACKET_ID_SESSION_HISTORY;
+  if (playerIndex >= MAX_CARS && !sessionWide) {
+    return;
+  }
+
+  // Telemetry and lap data feed the LEDs, buzzer and live delta on every
+  // frame, and motion records the track outline, so they are decoded
+  // straight away. The rest waits in the cache until a visible widget
+  // asks for it.
   switch (header->m_packetId) {
     case PACKET_ID_CAR_TELEMETRY:
       if (size >= sizeof(PacketCarTelemetryData)) {
@@ -128,43 +237,201 @@ void TelemetryController::processPacket(uint8_t* buffer, int size) {
 
     case PACKET_ID_LAP_DATA:
       if (size >= sizeof(PacketLapData)) {
-        model->updateLapData((PacketLapData*)buffer, playerIndex);
+        // Extrapolated from when the game sent it, so neither network
+        // jitter nor the wait for the loop shows in the live timer.
+        model->updateLapData((PacketLapData*)buffer, playerIndex,
+                             sessionClock.packetTimeMS(header->m_sessionTime, arrivalMS));
+      }
+      break;
+
+    case PACKET_ID_MOTION:
+      if (size >= sizeof(PacketMotionData)) {
+        model->updateMotion((PacketMotionData*)buffer, playerIndex);
+      }
+      break;
+
+    case PACKET_ID_EVENT:
+      if (size >= sizeof(PacketEventData)) {
+        RaceEvent event;
+        if (!decodeEvent((PacketEventData*)buffer, playerIndex, event)) break;
+        // The model must not wait for the banner queue.
+        if (event.type == EVENT_FLASHBACK) {
+          model->handleFlashback();
+        }
+        events.push(event);
+      }
+      break;
+
+    case PACKET_ID_PARTICIPANTS:
+      // Rebuilt only when the session or car count changes; see ParticipantTable.
+      if (size >= sizeof(PacketParticipantsData)) {
+        model->updateParticipants((PacketParticipantsData*)buffer);
+      }
+      break;
+
+    case PACKET_ID_SESSION_HISTORY:
+      // One car per packet, so the cache would keep only the last car;
+      // the history copies just the laps that are new.
+      if (size >= sizeof(PacketSessionHistoryData)) {
+        model->updateSessionHistory((PacketSessionHistoryData*)buffer, playerIndex);
       }
       break;
 
     case PACKET_ID_CAR_STATUS:
       if (size >= sizeof(PacketCarStatusData)) {
-        model->updateCarStatus((PacketCarStatusData*)buffer, playerIndex);
+        const PacketCarStatusData* packet = (PacketCarStatusData*)buffer;
+        if (isRepeatedPayload(PACKET_ID_CAR_STATUS, &packet->m_carStatusData[playerIndex], sizeof(CarStatusData))) break;
+        packetCache.store(buffer, size);
       }
       break;
 
     case PACKET_ID_CAR_DAMAGE:
       if (size >= sizeof(PacketCarDamageData)) {
-        model->updateCarDamage((PacketCarDamageData*)buffer, playerIndex);
+        const PacketCarDamageData* packet = (PacketCarDamageData*)buffer;
+        if (isRepeatedPayload(PACKET_ID_CAR_DAMAGE, &packet->m_carDamageData[playerIndex], sizeof(CarDamageData))) break;
+        packetCache.store(buffer, size);
       }
       break;
 
     case PACKET_ID_SESSION:
       if (size >= sizeof(PacketSessionData)) {
-        model->updateSessionData((PacketSessionData*)buffer);
+        // The header carries frame counters, so hash only the body.
+        if (isRepeatedPayload(PACKET_ID_SESSION, buffer + sizeof(PacketHeader), sizeof(PacketSessionData) - sizeof(PacketHeader))) break;
+
+        // Read on arrival, not with the lazy decode, so the banner is on time.
+        // A new session starts from its own status rather than an event.
+        uint8_t status = ((PacketSessionData*)buffer)->m_safetyCarStatus;
+        RaceEvent event;
+        if (header->m_sessionUID == safetyCarSessionUID && decodeSafetyCar(lastSafetyCarStatus, status, event)) {
+          events.push(event);
+        }
+        lastSafetyCarStatus = status;
+        safetyCarSessionUID = header->m_sessionUID;
+        packetCache.store(buffer, size);
+      }
+      break;
+
+    case PACKET_ID_TYRE_SETS:
+      if (size >= sizeof(PacketTyreSetsData)) {
+        // Sent for each car in turn; the filter sees only the player's.
+        const PacketTyreSetsData* packet = (PacketTyreSetsData*)buffer;
+        if (packet->m_carIdx != playerIndex) break;
+        if (isRepeatedPayload(PACKET_ID_TYRE_SETS, &packet->m_tyreSetData, sizeof(PacketTyreSetsData) - sizeof(PacketHeader) - 1)) break;
+        packetCache.store(buffer, size);
       }
       break;
 
     case PACKET_ID_CAR_SETUPS:
       if (size >= sizeof(PacketCarSetupData)) {
-        model->updateCarSetup((PacketCarSetupData*)buffer, playerIndex);
+        const PacketCarSetupData* packet = (PacketCarSetupData*)buffer;
+        if (isRepeatedPayload(PACKET_ID_CAR_SETUPS, &packet->m_carSetups[playerIndex], sizeof(CarSetupData))) break;
+        packetCache.store(buffer, size);
       }
       break;
     default:
       break;
   }
 }
+
+// ============================================
+// Payload Filtering
+// ============================================
+// Telemetry and lap data change every frame and are never filtered.
+bool TelemetryController::isRepeatedPayload(uint8_t packetId, const void* data, size_t length) {
+  PayloadFilter& filter = payloadFilters[packetId];
+  uint32_t hash = hashPayload(data, length);
+
+  if (filter.valid && filter.hash == hash) {
+    filter.skipped++;
+    return true;
+  }
+
+  filter.hash = hash;
+  filter.valid = true;
+  return false;
+}
+
+void TelemetryController::resetPayloadFilters() {
+  for (uint8_t i = 0; i < PACKET_ID_COUNT; i++) {
+    payloadFilters[i].valid = false;
+  }
+}
+
+uint32_t TelemetryController::getPacketsReceived(uint8_t packetId) const {
+  return packetId < PACKET_ID_COUNT ? payloadFilters[packetId].received : 0;
+}
+
+uint32_t TelemetryController::getPacketsSkipped(uint8_t packetId) const {
+  return packetId < PACKET_ID_COUNT ? payloadFilters[packetId].skipped : 0;
+}
+
+void TelemetryController::printPacketStats() {
+  Serial.println("Packet  recv  skip  skip%");
+  for (uint8_t i = 0; i < PACKET_ID_COUNT; i++) {
+    const PayloadFilter& filter = payloadFilters[i];
+    if (filter.received == 0) continue;
+
+    Serial.printf("%6u %5lu %5lu %5lu%%\n", i, (unsigned long)filter.received, (unsigned long)filter.skipped,
+                  (unsigned long)(filter.skipped * 100UL / filter.received));
+  }
+  Serial.printf("Events dropped: %lu\n", (unsigned long)events.getDropped());
+
+  const ClockSync::Stats& clock = sessionClock.getStats();
+  Serial.printf("Clock %s: drift %+.1f ppm, jitter %.1f ms, delay %ld ms (peak %ld)\n",
+                sessionClock.isSynced() ? "synced" : "unsynced", clock.driftPPM, clock.jitterMS,
+                (long)clock.delayMS, (long)clock.peakDelayMS);
+  Serial.printf("Stalls: network %lu, send gaps %lu, resyncs %lu\n", (unsigned long)clock.networkStalls,
+                (unsigned long)clock.sendGaps, (unsigned long)clock.resyncs);
+  sessionClock.resetPeak();
+}
+
+#if ENABLE_TRACE
+// 't' dumps the trace, 'r' clears it.
+void TelemetryController::handleSerialCommands() {
+  while (Serial.available() > 0) {
+    switch (Serial.read()) {
+      case 't':
+        trace.dump(Serial);
+        break;
+      case 'r':
+        trace.reset();
+        break;
+      default:
+        break;
+    }
+  }
+}
+#endif
+
 void TelemetryController::playBuzzerBeep(uint8_t duration) {
   tone(PIN_BUZZER, 2000, duration);
   delay(duration);
   noTone(PIN_BUZZER);
 }
 
+// Shows queued events one banner at a time; the buzzer sounds as each
+// banner appears, for the events that need the driver's attention.
+void TelemetryController::handleEvents() {
+  RaceEvent event;
+  if (view->isShowingEvent() || !events.pop(event)) return;
+
+  view->showEvent(event);
+  switch (event.type) {
+    case EVENT_PENALTY:
+    case EVENT_SAFETY_CAR:
+    case EVENT_RED_FLAG:
+      playBuzzerBeep(150);
+      break;
+    case EVENT_FASTEST_LAP:
+      if (event.vehicleIdx == model->getPlayerCarIndex()) {
+        playBuzzerBeep(50);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
 void TelemetryController::checkBuzzerTriggers() {
   int8_t currentGear = model->getGear();
   uint8_t currentDRS = model->getDRS();
@@ -7,6 +7,11 @@
 #include "Config.h"
 #include "Model.h"
 #include "View.h"
+#include "PacketCache.h"
+#include "Events.h"
+#include "Strategy.h"
+#include "ClockSync.h"
+#include "Trace.h"
 
 class TelemetryController {
   TelemetryModel* model;
@@ -25,22 +30,58 @@ class TelemetryController {
 
   uint32_t lastDisplayUpdate;
   uint8_t packetBuffer[PACKET_BUFFER_SIZE];
+  PacketCache packetCache;
+  EventQueue events;
+  // Session status as last seen, for the safety car events.
+  uint8_t lastSafetyCarStatus;
+  uint64_t safetyCarSessionUID;
+
+  // Game session time against millis(), from every packet header.
+  ClockSync sessionClock;
+
+  // The planner runs on its own task where there is one; inputs go in
+  // every lap and every STRATEGY_REFRESH_MS.
+  StrategyPlanner strategy;
+  bool strategyOnTask;
+  uint32_t lastStrategySubmit;
+  uint8_t lastStrategyLap;
 
   int8_t lastGear;
   uint8_t lastDRSAvailable;
 
+  // Slow packets mostly repeat the player's data; a hash of the player's
+  // slice per packet ID lets identical payloads skip the Model entirely.
+  struct PayloadFilter {
+    uint32_t hash;
+    bool valid;
+    uint32_t received;
+    uint32_t skipped;
+  };
+  PayloadFilter payloadFilters[PACKET_ID_COUNT];
+  uint32_t lastStatsPrint;
+
+  bool isRepeatedPayload(uint8_t packetId, const void* data, size_t length);
+  void resetPayloadFilters();
+  void printPacketStats();
+  void handleSerialCommands();
+
   void handleNetworkPackets();
-  void processPacket(uint8_t* buffer, int size);
+  void processPacket(uint8_t* buffer, int size, uint32_t arrivalMS);
   void setupWiFi();
   void handleButtonPress();
   void checkBuzzerTriggers();
+  void handleEvents();
   void playBuzzerBeep(uint8_t duration = 50);
+  void updateStrategy(uint32_t currentTime);
 
 public:
   TelemetryController(TelemetryModel* m, TelemetryView* v, WiFiUDP* u);
 
   void init();
   void update();
+
+  uint32_t getPacketsReceived(uint8_t packetId) const;
+  uint32_t getPacketsSkipped(uint8_t packetId) const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,68 @@
+#ifndef DISPLAY_BUS_H
+#define DISPLAY_BUS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================
+// Display Transport
+// ============================================
+// Moves pixel spans from RAM to the panel. A transaction holds the bus
+// for any number of regions; each region is opened with its address
+// window, filled span by span, then closed. acquireSpan() hands
+// out a buffer the caller may fill while earlier spans are still on the
+// wire, so implementations with two buffers overlap CPU and SPI time.
+//
+// Spans are native-endian RGB565; the bus handles byte order. Kept free
+// of Arduino headers so the host benchmark can build against it.
+const uint16_t DISPLAY_BUS_SPAN_PIXELS = 1024;
+
+// CASET + 4 bytes, PASET + 4 bytes, RAMWR
+const uint8_t DISPLAY_ADDR_WINDOW_BYTES = 11;
+
+struct DisplayBusStats {
+  uint32_t transactions;
+  uint32_t regions;
+  uint32_t spans;
+  uint32_t bytes;
+  uint32_t waitMicros;  // CPU time spent blocked on the bus
+};
+
+class DisplayBus {
+protected:
+  DisplayBusStats stats;
+
+public:
+  DisplayBus() {
+    resetStats();
+  }
+  virtual ~DisplayBus() {}
+
+  virtual void beginTransaction() = 0;
+  // Returns once everything queued is on the panel and the bus is free
+  // for direct drawing again.
+  virtual void endTransaction() = 0;
+
+  virtual void beginRegion(int16_t x, int16_t y, int16_t w, int16_t h) = 0;
+  virtual uint16_t* acquireSpan() = 0;
+  // Sends the first count pixels of the buffer last acquired.
+  virtual void queueSpan(uint16_t count) = 0;
+  virtual void endRegion() = 0;
+
+  // A panel command with its parameters, between regions; the scroll
+  // registers are set this way.
+  virtual void sendCommand(uint8_t command, const uint8_t* data, uint8_t length) = 0;
+
+  const DisplayBusStats& getStats() const {
+    return stats;
+  }
+  void resetStats() {
+    stats.transactions = 0;
+    stats.regions = 0;
+    stats.spans = 0;
+    stats.bytes = 0;
+    stats.waitMicros = 0;
+  }
+};
+
+#endif
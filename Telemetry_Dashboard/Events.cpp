@@ -0,0 +1,137 @@
+#include "Events.h"
+
+// ============================================
+// EVENT CODES
+// ============================================
+// Codes compare as little-endian 32-bit words, so a code is one load and
+// one compare. The dispatch switch is keyed on a multiplicative hash that
+// is perfect over the handled codes: it maps them into 0-7 with no two
+// alike, so the switch compiles to a single 8-entry jump table. Adding a
+// code whose slot collides is a compile error (duplicate case value);
+// pick a new EVENT_HASH_MULTIPLIER then.
+static constexpr uint32_t eventCode(const char* text) {
+  return (uint32_t)(uint8_t)text[0] | (uint32_t)(uint8_t)text[1] << 8 | (uint32_t)(uint8_t)text[2] << 16 |
+         (uint32_t)(uint8_t)text[3] << 24;
+}
+
+static constexpr uint32_t EVENT_HASH_MULTIPLIER = 143;
+
+static constexpr uint8_t eventSlot(uint32_t code) {
+  return (uint8_t)((uint32_t)(code * EVENT_HASH_MULTIPLIER) >> 29);
+}
+
+static constexpr uint32_t CODE_FASTEST_LAP = eventCode("FTLP");
+static constexpr uint32_t CODE_PENALTY = eventCode("PENA");
+static constexpr uint32_t CODE_DRS_ENABLED = eventCode("DRSE");
+static constexpr uint32_t CODE_DRS_DISABLED = eventCode("DRSD");
+static constexpr uint32_t CODE_FLASHBACK = eventCode("FLBK");
+static constexpr uint32_t CODE_RED_FLAG = eventCode("RDFL");
+static constexpr uint32_t CODE_CHEQUERED_FLAG = eventCode("CHQF");
+
+bool decodeEvent(const PacketEventData* packet, uint8_t playerIndex, RaceEvent& event) {
+  const EventDataDetails& details = packet->m_eventDetails;
+  uint32_t code;
+  memcpy(&code, packet->m_eventStringCode, sizeof(code));
+
+  event.vehicleIdx = 255;
+  event.detail = 0;
+  event.phase = 0;
+  event.value = 0;
+
+  // Unhandled codes share slots with handled ones; each case checks the
+  // full code before trusting the details.
+  switch (eventSlot(code)) {
+    case eventSlot(CODE_FASTEST_LAP):
+      if (code != CODE_FASTEST_LAP) return false;
+      event.type = EVENT_FASTEST_LAP;
+      event.vehicleIdx = details.FastestLap.vehicleIdx;
+      event.value = (uint32_t)lroundf(details.FastestLap.lapTime * 1000.0f);
+      return true;
+
+    case eventSlot(CODE_PENALTY):
+      if (code != CODE_PENALTY || details.Penalty.vehicleIdx != playerIndex) return false;
+      event.type = EVENT_PENALTY;
+      event.vehicleIdx = details.Penalty.vehicleIdx;
+      // 255 means no time is attached (warnings, drive-throughs).
+      event.detail = details.Penalty.time == 255 ? 0 : details.Penalty.time;
+      return true;
+
+    case eventSlot(CODE_DRS_ENABLED):
+      if (code != CODE_DRS_ENABLED) return false;
+      event.type = EVENT_DRS_ENABLED;
+      return true;
+
+    case eventSlot(CODE_DRS_DISABLED):
+      if (code != CODE_DRS_DISABLED) return false;
+      event.type = EVENT_DRS_DISABLED;
+      return true;
+
+    case eventSlot(CODE_FLASHBACK):
+      if (code != CODE_FLASHBACK) return false;
+      event.type = EVENT_FLASHBACK;
+      return true;
+
+    case eventSlot(CODE_RED_FLAG):
+      if (code != CODE_RED_FLAG) return false;
+      event.type = EVENT_RED_FLAG;
+      return true;
+
+    case eventSlot(CODE_CHEQUERED_FLAG):
+      if (code != CODE_CHEQUERED_FLAG) return false;
+      event.type = EVENT_CHEQUERED_FLAG;
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+// A new status is a deployment (formation laps included); a full or
+// virtual safety car going back to none is its end.
+bool decodeSafetyCar(uint8_t previousStatus, uint8_t status, RaceEvent& event) {
+  if (status == previousStatus) return false;
+
+  event.type = EVENT_SAFETY_CAR;
+  event.vehicleIdx = 255;
+  event.value = 0;
+  if (status != 0) {
+    event.detail = status;
+    event.phase = 0;
+    return true;
+  }
+  if (previousStatus == 1 || previousStatus == 2) {
+    event.detail = previousStatus;
+    event.phase = 1;
+    return true;
+  }
+  return false;
+}
+
+// ============================================
+// QUEUE
+// ============================================
+
+EventQueue::EventQueue() {
+  head = 0;
+  count = 0;
+  dropped = 0;
+}
+
+void EventQueue::push(const RaceEvent& event) {
+  if (count == EVENT_QUEUE_SIZE) {
+    head = (head + 1) % EVENT_QUEUE_SIZE;
+    count--;
+    dropped++;
+  }
+  events[(head + count) % EVENT_QUEUE_SIZE] = event;
+  count++;
+}
+
+bool EventQueue::pop(RaceEvent& event) {
+  if (count == 0) return false;
+
+  event = events[head];
+  head = (head + 1) % EVENT_QUEUE_SIZE;
+  count--;
+  return true;
+}
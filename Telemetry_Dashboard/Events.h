@@ -0,0 +1,68 @@
+#ifndef EVENTS_H
+#define EVENTS_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// ============================================
+// Race Events
+// ============================================
+// The event packet carries one four-letter code and a union of details.
+// decodeEvent() reduces the codes the dashboard reacts to into a small
+// fixed-size record; everything else (button presses, speed traps, ...)
+// is ignored.
+enum RaceEventType : uint8_t {
+  EVENT_FASTEST_LAP,
+  EVENT_PENALTY,
+  EVENT_DRS_ENABLED,
+  EVENT_DRS_DISABLED,
+  EVENT_SAFETY_CAR,
+  EVENT_FLASHBACK,
+  EVENT_RED_FLAG,
+  EVENT_CHEQUERED_FLAG,
+  EVENT_TYPE_COUNT
+};
+
+struct RaceEvent {
+  RaceEventType type;
+  uint8_t vehicleIdx;  // 255 when the event is not about one car
+  uint8_t detail;      // Penalty seconds; safety car type
+  uint8_t phase;       // Safety car: 0 = deployed, 1 = returning
+  uint32_t value;      // Fastest lap time in ms
+};
+
+// Returns true and fills event if the packet is one the dashboard shows.
+// Penalties are only reported for the player.
+bool decodeEvent(const PacketEventData* packet, uint8_t playerIndex, RaceEvent& event);
+
+// F1 23 has no safety car event code; deployments and endings are read
+// from changes of the Session packet's m_safetyCarStatus instead.
+// Returns true and fills event on a change the dashboard shows.
+bool decodeSafetyCar(uint8_t previousStatus, uint8_t status, RaceEvent& event);
+
+// ============================================
+// Event Queue
+// ============================================
+// Ring buffer between the packet handler and the banner. When full, the
+// oldest event is dropped: a late banner for a stale event is worse than
+// none.
+class EventQueue {
+  RaceEvent events[EVENT_QUEUE_SIZE];
+  uint8_t head;   // Next to pop
+  uint8_t count;
+  uint32_t dropped;
+
+public:
+  EventQueue();
+
+  void push(const RaceEvent& event);
+  bool pop(RaceEvent& event);
+  bool isEmpty() const {
+    return count == 0;
+  }
+  uint32_t getDropped() const {
+    return dropped;
+  }
+};
+
+#endif
@@ -0,0 +1,94 @@
+#include "Format.h"
+
+static const uint16_t POWERS_OF_TEN[] = { 1, 10, 100, 1000 };
+
+int32_t toFixed(float value, uint8_t decimals) {
+  float scaled = value;
+  for (uint8_t i = 0; i < decimals; i++) scaled *= 10.0f;
+  return (int32_t)lroundf(scaled);
+}
+
+// Digits of magnitude with a decimal point before the last `decimals`,
+// zero-padded so there is always at least one digit before the point.
+static uint8_t writeDigits(char* out, uint32_t magnitude, uint8_t decimals) {
+  char digits[12];
+  uint8_t count = 0;
+  do {
+    digits[count++] = '0' + magnitude % 10;
+    magnitude /= 10;
+  } while (magnitude > 0 || count <= decimals);
+
+  char* p = out;
+  while (count > 0) {
+    if (count == decimals) *p++ = '.';
+    *p++ = digits[--count];
+  }
+  *p = '\0';
+  return p - out;
+}
+
+uint8_t formatFixed(char* out, int32_t value, uint8_t decimals) {
+  if (value < 0) {
+    out[0] = '-';
+    return 1 + writeDigits(out + 1, -(uint32_t)value, decimals);
+  }
+  return writeDigits(out, value, decimals);
+}
+
+uint8_t formatSigned(char* out, int32_t value, uint8_t decimals) {
+  out[0] = value < 0 ? '-' : '+';
+  return 1 + writeDigits(out + 1, value < 0 ? -(uint32_t)value : value, decimals);
+}
+
+static uint8_t writeFraction(char* out, uint32_t fractionMS, uint8_t decimals) {
+  if (decimals == 0) {
+    *out = '\0';
+    return 0;
+  }
+  if (decimals > 3) decimals = 3;
+  out[0] = '.';
+  uint32_t fraction = fractionMS / POWERS_OF_TEN[3 - decimals];
+  for (uint8_t i = decimals; i > 0; i--) {
+    out[i] = '0' + fraction % 10;
+    fraction /= 10;
+  }
+  out[decimals + 1] = '\0';
+  return decimals + 1;
+}
+
+uint8_t formatLapTime(char* out, uint32_t timeMS, uint8_t decimals) {
+  uint32_t totalSeconds = timeMS / 1000;
+  uint8_t length = writeDigits(out, totalSeconds / 60, 0);
+  uint8_t seconds = totalSeconds % 60;
+  out[length++] = ':';
+  out[length++] = '0' + seconds / 10;
+  out[length++] = '0' + seconds % 10;
+  return length + writeFraction(out + length, timeMS % 1000, decimals);
+}
+
+uint8_t formatSeconds(char* out, uint32_t timeMS, uint8_t decimals) {
+  uint8_t length = writeDigits(out, timeMS / 1000, 0);
+  return length + writeFraction(out + length, timeMS % 1000, decimals);
+}
+
+uint8_t formatClock(char* out, uint32_t seconds) {
+  uint32_t minutes = seconds / 60;
+  uint8_t length = 0;
+  if (minutes < 10) out[length++] = '0';
+  length += writeDigits(out + length, minutes, 0);
+  out[length++] = ':';
+  out[length++] = '0' + (seconds % 60) / 10;
+  out[length++] = '0' + seconds % 10;
+  out[length] = '\0';
+  return length;
+}
+
+uint8_t formatPercent(char* out, int32_t percent) {
+  return appendText(out, formatFixed(out, percent, 0), "%");
+}
+
+uint8_t appendText(char* out, uint8_t length, const char* text) {
+  while (*text && length < FORMAT_BUFFER_SIZE - 1) out[length++] = *text++;
+  out[length] = '\0';
+  return length;
+}
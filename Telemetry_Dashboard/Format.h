@@ -0,0 +1,42 @@
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include <Arduino.h>
+
+// ============================================
+// Fixed-point Text Formatting
+// ============================================
+// Number and time formatting for the widgets without printf, floats or
+// Print. Each function writes into a caller buffer, NUL-terminates it and
+// returns the number of characters written. The classic font is fixed
+// width, so that count is also the text's width in glyphs (textWidth()).
+//
+// Fixed-point values are integers in units of 10^-decimals:
+// formatFixed(buffer, 2345, 2) writes "23.45".
+
+// Large enough for any single formatted value plus a short prefix/suffix.
+const uint8_t FORMAT_BUFFER_SIZE = 24;
+
+// Rounds value to decimals places as a fixed-point integer.
+int32_t toFixed(float value, uint8_t decimals);
+
+uint8_t formatFixed(char* out, int32_t value, uint8_t decimals);
+uint8_t formatSigned(char* out, int32_t value, uint8_t decimals);  // Always "+" or "-"
+
+// "1:23.456" (decimals 0-3, truncated like the game's own HUD).
+uint8_t formatLapTime(char* out, uint32_t timeMS, uint8_t decimals = 3);
+// "23.456": seconds only, for sector times and gaps.
+uint8_t formatSeconds(char* out, uint32_t timeMS, uint8_t decimals = 3);
+// "mm:ss"
+uint8_t formatClock(char* out, uint32_t seconds);
+
+uint8_t formatPercent(char* out, int32_t percent);
+
+// Appends text at out + length; returns the new length.
+uint8_t appendText(char* out, uint8_t length, const char* text);
+
+inline int16_t textWidth(uint8_t length, uint8_t size) {
+  return length * 6 * size;
+}
+
+#endif
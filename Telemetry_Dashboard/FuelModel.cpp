@@ -0,0 +1,82 @@
+#include "FuelModel.h"
+
+FuelModel::FuelModel() {
+  reset();
+}
+
+void FuelModel::reset() {
+  burnCount = 0;
+  burnHead = 0;
+  burnPerLap = 0.0f;
+  lapStartFuel = 0.0f;
+  lapStarted = false;
+  lapExcluded = false;
+  miniSector = 0;
+}
+
+void FuelModel::startLap(float fuel, float lapFraction) {
+  lapFraction = constrain(lapFraction, 0.0f, 1.0f);
+  if (lapStarted && lapStartFuel > fuel) fuel += (lapStartFuel - fuel) * lapFraction / (1.0f + lapFraction);
+
+  float burn = lapStartFuel - fuel;
+  if (lapStarted && !lapExcluded && burn > 0.0f) {
+    burns[burnHead] = burn;
+    burnHead = (burnHead + 1) % FUEL_WINDOW_LAPS;
+    if (burnCount < FUEL_WINDOW_LAPS) burnCount++;
+    burnPerLap = median();
+  }
+
+  lapStartFuel = fuel;
+  lapStarted = true;
+  lapExcluded = false;
+  miniSector = 0;
+}
+
+// The window is a handful of laps, so sorting a copy is constant time.
+float FuelModel::median() const {
+  float sorted[FUEL_WINDOW_LAPS];
+  for (uint8_t i = 0; i < burnCount; i++) {
+    float burn = burns[i];
+    uint8_t j = i;
+    while (j > 0 && sorted[j - 1] > burn) {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = burn;
+  }
+
+  if (burnCount % 2 == 1) return sorted[burnCount / 2];
+  return (sorted[burnCount / 2 - 1] + sorted[burnCount / 2]) / 2.0f;
+}
+
+bool FuelModel::crossedMiniSector(float lapFraction) {
+  if (lapFraction < 0.0f) lapFraction = 0.0f;
+  uint8_t sector = (uint8_t)(lapFraction * FUEL_MINI_SECTORS);
+  if (sector >= FUEL_MINI_SECTORS) sector = FUEL_MINI_SECTORS - 1;
+  if (sector == miniSector) return false;
+
+  miniSector = sector;
+  return true;
+}
+
+void FuelModel::predict(float fuel, float lapFraction, uint8_t currentLap, uint8_t totalLaps,
+                        Prediction& out) const {
+  lapFraction = constrain(lapFraction, 0.0f, 1.0f);
+
+  float rate = burnPerLap;
+  if (burnCount == 0) {
+    bool partial = lapStarted && !lapExcluded && lapFraction >= FUEL_MIN_PARTIAL_LAP;
+    rate = partial ? (lapStartFuel - fuel) / lapFraction : 0.0f;
+    if (rate < 0.0f) rate = 0.0f;
+  }
+
+  out.burnPerLap = rate;
+  out.fuelAtFinish = FUEL_NO_ESTIMATE;
+  out.savePerLap = FUEL_NO_ESTIMATE;
+  if (rate == 0.0f || totalLaps == 0) return;
+
+  float lapsLeft = currentLap <= totalLaps ? totalLaps - currentLap + 1.0f - lapFraction : 0.0f;
+  float atFinish = fuel - rate * lapsLeft;
+  out.fuelAtFinish = atFinish > FUEL_NO_ESTIMATE ? atFinish : FUEL_NO_ESTIMATE + 0.1f;
+  out.savePerLap = atFinish < 0.0f && lapsLeft > 0.0f ? -atFinish / lapsLeft : 0.0f;
+}
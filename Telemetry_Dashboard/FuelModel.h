@@ -0,0 +1,59 @@
+#ifndef FUEL_MODEL_H
+#define FUEL_MODEL_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// ============================================
+// Fuel Model
+// ============================================
+// Fuel burned per lap, measured from the tank level at each lap boundary
+// rather than taken from the game's MFD estimate. Laps with a pit stop,
+// safety car or flashback in them are left out, and the estimate is the
+// median of the last FUEL_WINDOW_LAPS clean laps, so one odd lap does not
+// move it. Until the first clean lap, the running lap's burn so far is
+// scaled up instead.
+//
+// The tank is sampled FUEL_MINI_SECTORS times a lap; each sample gives a
+// new prediction of the fuel left at the flag, and the saving per lap
+// needed to reach it. Every step is constant time.
+class FuelModel {
+public:
+  struct Prediction {
+    float burnPerLap;    // kg; 0 with no estimate
+    float fuelAtFinish;  // kg; FUEL_NO_ESTIMATE without one or a lap count
+    float savePerLap;    // kg to save on each lap left; FUEL_NO_ESTIMATE likewise
+  };
+
+private:
+  float burns[FUEL_WINDOW_LAPS];  // Ring of clean laps
+  uint8_t burnCount;
+  uint8_t burnHead;               // Next slot to write
+  float burnPerLap;               // Median of burns
+  float lapStartFuel;
+  bool lapStarted;   // lapStartFuel was taken at a lap boundary
+  bool lapExcluded;
+  uint8_t miniSector;
+
+  float median() const;
+
+public:
+  FuelModel();
+  void reset();
+
+  // Closes the lap just finished at the line, and opens the next. The
+  // tank may be read lapFraction past the line; the burn since is put
+  // back at the closing lap's rate.
+  void startLap(float fuel, float lapFraction);
+  // The running lap will not count.
+  void excludeLap() {
+    lapExcluded = true;
+  }
+
+  // True once per mini-sector, when lapFraction (0-1) enters a new one.
+  bool crossedMiniSector(float lapFraction);
+
+  void predict(float fuel, float lapFraction, uint8_t currentLap, uint8_t totalLaps, Prediction& out) const;
+};
+
+#endif
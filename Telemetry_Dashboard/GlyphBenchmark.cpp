@@ -0,0 +1,54 @@
+#include "GlyphBenchmark.h"
+
+#if ENABLE_GLYPH_BENCHMARK
+
+#include "Glyphs.h"
+#include "Sprite.h"
+
+namespace {
+
+const uint16_t BENCHMARK_ITERATIONS = 200;
+const uint8_t BENCHMARK_SIZES[] = { 1, 2, 3, 8 };
+const char BENCHMARK_DIGITS[] = "0123456789";
+
+}  // namespace
+
+void runGlyphBenchmark(Print& out) {
+  // Big enough for one size-8 glyph.
+  static uint8_t buffer[(48 + 1) / 2 * 64];
+  static Sprite sprite;
+
+  out.println("Glyph benchmark (cycles per glyph):");
+  for (uint8_t s = 0; s < sizeof(BENCHMARK_SIZES); s++) {
+    uint8_t size = BENCHMARK_SIZES[s];
+    sprite.begin(0, 0, 6 * size, 8 * size, buffer);
+
+    uint32_t start = ESP.getCycleCount();
+    for (uint16_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+      for (uint8_t d = 0; d < 10; d++) {
+        sprite.drawChar(0, 0, BENCHMARK_DIGITS[d], COLOR_WHITE, COLOR_WHITE, size);
+      }
+    }
+    uint32_t scaledFont = ESP.getCycleCount() - start;
+
+    char glyph[2] = { 0, 0 };
+    start = ESP.getCycleCount();
+    for (uint16_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+      for (uint8_t d = 0; d < 10; d++) {
+        glyph[0] = BENCHMARK_DIGITS[d];
+        drawGlyphText(&sprite, 0, 0, glyph, size, COLOR_WHITE);
+      }
+    }
+    uint32_t glyphs = ESP.getCycleCount() - start;
+
+    out.print("Size ");
+    out.print(size);
+    out.print(": scaled font ");
+    out.print(scaledFont / (BENCHMARK_ITERATIONS * 10UL));
+    out.print(" cyc, glyphs ");
+    out.print(glyphs / (BENCHMARK_ITERATIONS * 10UL));
+    out.println(" cyc");
+  }
+}
+
+#endif
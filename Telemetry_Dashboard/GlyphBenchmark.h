@@ -0,0 +1,14 @@
+#ifndef GLYPH_BENCHMARK_H
+#define GLYPH_BENCHMARK_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+#if ENABLE_GLYPH_BENCHMARK
+// Times drawing digits into a widget sprite through Adafruit_GFX's scaled
+// classic font and through the pre-rasterized glyphs, and prints cycles
+// per glyph for each text size the dashboard uses.
+void runGlyphBenchmark(Print& out);
+#endif
+
+#endif
@@ -0,0 +1,47 @@
+// Generated by tools/make_glyphs.py from Adafruit GFX glcdfont.c. Do not edit.
+#ifndef GLYPH_DATA_H
+#define GLYPH_DATA_H
+
+#include "Glyphs.h"
+
+static const GlyphRect GLYPH_RECTS[] = {
+  { 0x01, 0x15 }, { 0x10, 0x31 }, { 0x14, 0x11 }, { 0x16, 0x31 }, { 0x23, 0x11 }, { 0x32, 0x11 }, { 0x41, 0x15 },  // '0'
+  { 0x20, 0x11 }, { 0x11, 0x21 }, { 0x22, 0x14 }, { 0x16, 0x31 },  // '1'
+  { 0x10, 0x31 }, { 0x01, 0x11 }, { 0x41, 0x12 }, { 0x13, 0x31 }, { 0x04, 0x12 }, { 0x06, 0x51 },  // '2'
+  { 0x00, 0x51 }, { 0x41, 0x11 }, { 0x32, 0x11 }, { 0x23, 0x21 }, { 0x44, 0x12 }, { 0x05, 0x11 }, { 0x16, 0x31 },  // '3'
+  { 0x03, 0x12 }, { 0x12, 0x11 }, { 0x14, 0x21 }, { 0x21, 0x11 }, { 0x30, 0x17 }, { 0x44, 0x11 },  // '4'
+  { 0x00, 0x51 }, { 0x01, 0x11 }, { 0x02, 0x41 }, { 0x43, 0x13 }, { 0x05, 0x11 }, { 0x16, 0x31 },  // '5'
+  { 0x02, 0x14 }, { 0x11, 0x11 }, { 0x13, 0x31 }, { 0x16, 0x31 }, { 0x20, 0x31 }, { 0x44, 0x12 },  // '6'
+  { 0x00, 0x51 }, { 0x41, 0x12 }, { 0x33, 0x11 }, { 0x24, 0x11 }, { 0x15, 0x11 }, { 0x06, 0x11 },  // '7'
+  { 0x10, 0x31 }, { 0x01, 0x12 }, { 0x41, 0x12 }, { 0x13, 0x31 }, { 0x04, 0x12 }, { 0x44, 0x12 }, { 0x16, 0x31 },  // '8'
+  { 0x01, 0x12 }, { 0x06, 0x31 }, { 0x10, 0x31 }, { 0x13, 0x31 }, { 0x35, 0x11 }, { 0x41, 0x14 },  // '9'
+  { 0x03, 0x51 },  // '-'
+  { 0x21, 0x12 }, { 0x03, 0x51 }, { 0x24, 0x12 },  // '+'
+  { 0x15, 0x22 },  // '.'
+  { 0x11, 0x22 }, { 0x14, 0x22 },  // ':'
+  { 0x00, 0x22 }, { 0x41, 0x11 }, { 0x32, 0x11 }, { 0x23, 0x11 }, { 0x14, 0x11 }, { 0x05, 0x11 }, { 0x35, 0x22 },  // '%'
+  { 0x00, 0x41 }, { 0x01, 0x12 }, { 0x41, 0x12 }, { 0x03, 0x41 }, { 0x04, 0x13 }, { 0x24, 0x11 }, { 0x35, 0x11 }, { 0x46, 0x11 },  // 'R'
+  { 0x00, 0x17 }, { 0x12, 0x11 }, { 0x23, 0x11 }, { 0x34, 0x11 }, { 0x40, 0x17 },  // 'N'
+};
+
+static const Glyph GLYPHS[] = {
+  { '0', 0, 7 },  // 19 px
+  { '1', 7, 4 },  // 10 px
+  { '2', 11, 6 },  // 16 px
+  { '3', 17, 7 },  // 15 px
+  { '4', 24, 6 },  // 14 px
+  { '5', 30, 6 },  // 17 px
+  { '6', 36, 6 },  // 16 px
+  { '7', 42, 6 },  // 11 px
+  { '8', 48, 7 },  // 17 px
+  { '9', 55, 6 },  // 16 px
+  { '-', 61, 1 },  // 5 px
+  { '+', 62, 3 },  // 9 px
+  { '.', 65, 1 },  // 4 px
+  { ':', 66, 2 },  // 8 px
+  { '%', 68, 7 },  // 13 px
+  { 'R', 75, 8 },  // 18 px
+  { 'N', 83, 5 },  // 17 px
+};
+
+#endif
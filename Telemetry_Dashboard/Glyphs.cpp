@@ -0,0 +1,26 @@
+#include "Glyphs.h"
+#include "GlyphData.h"
+
+static const Glyph* findGlyph(char c) {
+  for (uint8_t i = 0; i < sizeof(GLYPHS) / sizeof(GLYPHS[0]); i++) {
+    if (GLYPHS[i].c == c) return &GLYPHS[i];
+  }
+  return NULL;
+}
+
+int16_t drawGlyphText(Adafruit_GFX* gfx, int16_t x, int16_t y, const char* text, uint8_t size, uint16_t color) {
+  for (; *text; text++) {
+    const Glyph* glyph = findGlyph(*text);
+    if (glyph) {
+      const GlyphRect* rect = &GLYPH_RECTS[glyph->offset];
+      for (uint8_t i = 0; i < glyph->count; i++, rect++) {
+        gfx->fillRect(x + (rect->xy >> 4) * size, y + (rect->xy & 0x0F) * size,
+                      (rect->wh >> 4) * size, (rect->wh & 0x0F) * size, color);
+      }
+    } else if (*text != ' ') {
+      gfx->drawChar(x, y, *text, color, color, size);
+    }
+    x += 6 * size;
+  }
+  return x;
+}
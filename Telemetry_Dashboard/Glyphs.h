@@ -0,0 +1,33 @@
+#ifndef GLYPHS_H
+#define GLYPHS_H
+
+#include <Adafruit_GFX.h>
+
+// ============================================
+// Pre-rasterized Numerals
+// ============================================
+// Adafruit_GFX draws the classic font at size s as one s*s fillRect per
+// lit pixel. For the characters in GlyphData.h (digits and the few
+// symbols numbers use) each glyph is stored in flash as a handful of
+// filled rectangles, so a size-8 gear is ~7 calls instead of ~17.
+// Regenerate GlyphData.h with tools/make_glyphs.py.
+
+// One rectangle in font units: x/y in the high/low nibble of xy, w/h in wh.
+struct GlyphRect {
+  uint8_t xy;
+  uint8_t wh;
+};
+
+struct Glyph {
+  char c;
+  uint8_t offset;  // first rectangle in GLYPH_RECTS
+  uint8_t count;
+};
+
+// Draws text in the classic font with its top-left at (x, y) and a
+// transparent background, like setCursor() + print() with a one-argument
+// setTextColor(). Characters without a stored glyph fall back to
+// drawChar(). No wrapping. Returns the x after the last character.
+int16_t drawGlyphText(Adafruit_GFX* gfx, int16_t x, int16_t y, const char* text, uint8_t size, uint16_t color);
+
+#endif
@@ -0,0 +1,148 @@
+#include "InputTrace.h"
+
+static_assert(DISPLAY_ROTATION == 1 || DISPLAY_ROTATION == 3, "input trace scrolls along screen x; landscape only");
+static_assert(INPUT_HISTORY_SAMPLES >= SCREEN_WIDTH - INPUT_TRACE_LABEL_WIDTH, "history must fill the plot");
+static_assert(DISPLAY_BUS_SPAN_PIXELS >= SCREEN_HEIGHT, "a column must fit one span");
+
+// Lane rows: the last row of each lane is its separator, the first is a gap.
+static const int16_t STEER_CENTRE = 2 * InputTrace::LANE_HEIGHT + InputTrace::LANE_HEIGHT / 2;
+static const int16_t STEER_RANGE = InputTrace::LANE_HEIGHT / 2 - 2;
+static const int16_t FILL_RANGE = InputTrace::LANE_HEIGHT - 2;
+
+InputTrace::InputTrace() {
+  bus = NULL;
+  active = false;
+  head = 0;
+  drawnSamples = 0;
+  stats.samples = 0;
+  stats.pixels = 0;
+  stats.scrolls = 0;
+}
+
+void InputTrace::begin(DisplayBus* b) {
+  bus = b;
+}
+
+// ============================================
+// SCROLLING
+// ============================================
+
+void InputTrace::activate(const TelemetryModel& model) {
+  if (!bus) return;
+
+  // Scroll start at the top of the area shows the panel as drawn; head
+  // is then whichever line is at the plot's right edge.
+  bus->beginTransaction();
+  defineScrollArea(TOP_FIXED, BOTTOM_FIXED);
+  scrollTo(TOP_FIXED);
+  bus->endTransaction();
+  head = MIRRORED ? 0 : PLOT_WIDTH - 1;
+  active = true;
+
+  uint32_t total = model.getInputSamples();
+  drawnSamples = total > (uint32_t)PLOT_WIDTH ? total - PLOT_WIDTH : 0;
+  update(model);
+}
+
+void InputTrace::deactivate() {
+  if (!active) return;
+
+  bus->beginTransaction();
+  defineScrollArea(0, 0);
+  scrollTo(0);
+  bus->endTransaction();
+  active = false;
+}
+
+void InputTrace::update(const TelemetryModel& model) {
+  if (!active) return;
+
+  // Anything older than a full plot would be overwritten anyway.
+  uint32_t total = model.getInputSamples();
+  if (total - drawnSamples > (uint32_t)PLOT_WIDTH) {
+    drawnSamples = total - PLOT_WIDTH;
+  }
+  if (drawnSamples == total) return;
+
+  bus->beginTransaction();
+  while (drawnSamples != total) {
+    drawSample(model.getInputSample(drawnSamples));
+    drawnSamples++;
+  }
+  scroll();
+  bus->endTransaction();
+}
+
+// Overwrites the oldest column, which becomes the newest once scrolled.
+void InputTrace::drawSample(const TelemetryModel::InputSample& sample) {
+  head = (head + (MIRRORED ? PLOT_WIDTH - 1 : 1)) % PLOT_WIDTH;
+  uint16_t line = TOP_FIXED + head;
+  int16_t x = MIRRORED ? SCREEN_WIDTH - 1 - line : line;
+
+  bus->beginRegion(x, 0, 1, SCREEN_HEIGHT);
+  renderColumn(sample, bus->acquireSpan());
+  bus->queueSpan(SCREEN_HEIGHT);
+  bus->endRegion();
+
+  stats.samples++;
+  stats.pixels += SCREEN_HEIGHT;
+}
+
+// The scroll start is the line shown first in the area: the newest column
+// when mirrored, otherwise the oldest.
+void InputTrace::scroll() {
+  uint16_t start = MIRRORED ? head : (head + 1) % PLOT_WIDTH;
+  scrollTo(TOP_FIXED + start);
+  stats.scrolls++;
+}
+
+// The scroll axis is the panel's 320 lines, screen x in landscape.
+void InputTrace::defineScrollArea(uint16_t top, uint16_t bottom) {
+  uint16_t middle = SCREEN_WIDTH - top - bottom;
+  uint8_t data[6] = { (uint8_t)(top >> 8), (uint8_t)top, (uint8_t)(middle >> 8), (uint8_t)middle,
+                      (uint8_t)(bottom >> 8), (uint8_t)bottom };
+  bus->sendCommand(ILI9341_VSCRDEF, data, 6);
+}
+
+void InputTrace::scrollTo(uint16_t line) {
+  uint8_t data[2] = { (uint8_t)(line >> 8), (uint8_t)line };
+  bus->sendCommand(ILI9341_VSCRSADD, data, 2);
+}
+
+// ============================================
+// DRAWING
+// ============================================
+
+void InputTrace::renderColumn(const TelemetryModel::InputSample& sample, uint16_t* column) {
+  for (int16_t y = 0; y < SCREEN_HEIGHT; y++) {
+    column[y] = COLOR_BLACK;
+  }
+
+  // Throttle and brake fill up from the bottom of their lanes.
+  int16_t throttle = sample.throttle * FILL_RANGE / 100;
+  for (int16_t y = LANE_HEIGHT - 1 - throttle; y < LANE_HEIGHT - 1; y++) {
+    column[y] = COLOR_GREEN;
+  }
+  int16_t brake = sample.brake * FILL_RANGE / 100;
+  for (int16_t y = 2 * LANE_HEIGHT - 1 - brake; y < 2 * LANE_HEIGHT - 1; y++) {
+    column[y] = COLOR_RED;
+  }
+  column[LANE_HEIGHT - 1] = COLOR_DARKGREY;
+  column[2 * LANE_HEIGHT - 1] = COLOR_DARKGREY;
+
+  // Steering fills away from the centre line, right lock upwards.
+  column[STEER_CENTRE] = COLOR_DARKGREY;
+  int16_t steer = sample.steer * STEER_RANGE / 100;
+  for (int16_t y = STEER_CENTRE - steer; y < STEER_CENTRE; y++) {
+    column[y] = COLOR_CYAN;
+  }
+  for (int16_t y = STEER_CENTRE + 1; y <= STEER_CENTRE - steer; y++) {
+    column[y] = COLOR_CYAN;
+  }
+}
+
+void InputTrace::drawGuides(Adafruit_GFX* gfx) {
+  gfx->drawFastHLine(PLOT_X, LANE_HEIGHT - 1, PLOT_WIDTH, COLOR_DARKGREY);
+  gfx->drawFastHLine(PLOT_X, 2 * LANE_HEIGHT - 1, PLOT_WIDTH, COLOR_DARKGREY);
+  gfx->drawFastHLine(PLOT_X, STEER_CENTRE, PLOT_WIDTH, COLOR_DARKGREY);
+}
@@ -0,0 +1,80 @@
+#ifndef INPUT_TRACE_H
+#define INPUT_TRACE_H
+
+#include <Adafruit_GFX.h>
+#include <Adafruit_ILI9341.h>
+#include "Config.h"
+#include "DisplayBus.h"
+#include "Model.h"
+
+// ============================================
+// Hardware-scrolled Input Trace
+// ============================================
+// Throttle, brake and steering lanes plotted one column per telemetry
+// sample, newest at the right edge. The ILI9341 scrolls along its native
+// 320-line axis, which is screen x in landscape, so the plot is a scroll
+// area spanning the full height: each sample overwrites the oldest
+// column and moves the scroll start by one line. The label area to the
+// left is a fixed margin and does not move.
+//
+// While active, the panel's line order is rotated inside the plot; the
+// view deactivates the trace before drawing anything else there.
+class InputTrace {
+public:
+  static const int16_t PLOT_X = INPUT_TRACE_LABEL_WIDTH;
+  static const int16_t PLOT_WIDTH = SCREEN_WIDTH - PLOT_X;
+  static const int16_t LANE_HEIGHT = SCREEN_HEIGHT / 3;  // Throttle, brake, steering
+
+  struct Stats {
+    uint32_t samples;
+    uint32_t pixels;
+    uint32_t scrolls;
+  };
+
+private:
+  // In rotation 3 screen x runs against the panel's line order, so the
+  // plot is at the start of the scroll axis; in rotation 1 it is at the end.
+  static const bool MIRRORED = DISPLAY_ROTATION == 3;
+  static const uint16_t TOP_FIXED = MIRRORED ? SCREEN_WIDTH - PLOT_X - PLOT_WIDTH : PLOT_X;
+  static const uint16_t BOTTOM_FIXED = SCREEN_WIDTH - TOP_FIXED - PLOT_WIDTH;
+
+  DisplayBus* bus;
+  bool active;
+  uint16_t head;          // Scroll-area line holding the newest sample
+  uint32_t drawnSamples;  // Model sample count already on the panel
+  Stats stats;
+
+  void drawSample(const TelemetryModel::InputSample& sample);
+  void scroll();
+  // VSCRDEF and VSCRSADD, inside a bus transaction.
+  void defineScrollArea(uint16_t top, uint16_t bottom);
+  void scrollTo(uint16_t line);
+
+public:
+  InputTrace();
+
+  void begin(DisplayBus* b);
+
+  // Sets up the scroll area and fills the plot from the model's history.
+  // The screen layout must already be on the panel, unscrolled.
+  void activate(const TelemetryModel& model);
+  // Back to a full-screen, unscrolled panel.
+  void deactivate();
+  bool isActive() const {
+    return active;
+  }
+
+  // Draws the samples received since the last call and scrolls them in.
+  void update(const TelemetryModel& model);
+
+  const Stats& getStats() const {
+    return stats;
+  }
+
+  // One plot column, top to bottom, SCREEN_HEIGHT pixels.
+  static void renderColumn(const TelemetryModel::InputSample& sample, uint16_t* column);
+  // Lane separators and the steering centre line, matching an empty column.
+  static void drawGuides(Adafruit_GFX* gfx);
+};
+
+#endif
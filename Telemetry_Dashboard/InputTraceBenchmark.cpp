@@ -0,0 +1,101 @@
+#include "InputTraceBenchmark.h"
+
+#if ENABLE_INPUT_TRACE_BENCHMARK
+
+#include "InputTrace.h"
+
+namespace {
+
+const uint16_t BENCHMARK_SAMPLES = 200;
+
+// VSCRSADD: command byte and a 16-bit line.
+const uint8_t SCROLL_COMMAND_BYTES = 3;
+
+// Counts what a real bus would send and throws the pixels away.
+class CountingBus : public DisplayBus {
+  uint16_t span[DISPLAY_BUS_SPAN_PIXELS];
+
+public:
+  uint32_t pixels;
+
+  void beginTransaction() override {
+    stats.transactions++;
+  }
+  void endTransaction() override {}
+  void beginRegion(int16_t, int16_t, int16_t, int16_t) override {
+    stats.regions++;
+    stats.bytes += DISPLAY_ADDR_WINDOW_BYTES;
+  }
+  uint16_t* acquireSpan() override {
+    return span;
+  }
+  void queueSpan(uint16_t count) override {
+    stats.spans++;
+    stats.bytes += count * 2;
+    pixels += count;
+  }
+  void endRegion() override {}
+};
+
+TelemetryModel::InputSample sampleAt(uint32_t n) {
+  TelemetryModel::InputSample sample;
+  sample.throttle = n % 101;
+  sample.brake = (n * 7) % 101;
+  sample.steer = (int8_t)((int32_t)(n % 201) - 100);
+  return sample;
+}
+
+void pushColumn(CountingBus& bus, int16_t x, const TelemetryModel::InputSample& sample) {
+  bus.beginRegion(x, 0, 1, SCREEN_HEIGHT);
+  InputTrace::renderColumn(sample, bus.acquireSpan());
+  bus.queueSpan(SCREEN_HEIGHT);
+  bus.endRegion();
+}
+
+void printResult(Print& out, const char* name, const CountingBus& bus, uint32_t extraBytes, uint32_t cycles) {
+  out.print(name);
+  out.print(": ");
+  out.print(bus.pixels / BENCHMARK_SAMPLES);
+  out.print(" px, ");
+  out.print((bus.getStats().bytes + extraBytes) / BENCHMARK_SAMPLES);
+  out.print(" B, ");
+  out.print(cycles / BENCHMARK_SAMPLES);
+  out.println(" cyc per sample");
+}
+
+}  // namespace
+
+void runInputTraceBenchmark(Print& out) {
+  static CountingBus bus;
+
+  out.println("Input trace benchmark:");
+
+  // Scrolled: the new sample's column, then one scroll command.
+  bus.resetStats();
+  bus.pixels = 0;
+  uint32_t start = ESP.getCycleCount();
+  for (uint32_t n = 0; n < BENCHMARK_SAMPLES; n++) {
+    bus.beginTransaction();
+    pushColumn(bus, InputTrace::PLOT_X + n % InputTrace::PLOT_WIDTH, sampleAt(n));
+    bus.endTransaction();
+  }
+  uint32_t scrolled = ESP.getCycleCount() - start;
+  printResult(out, "Scrolled column", bus, BENCHMARK_SAMPLES * SCROLL_COMMAND_BYTES, scrolled);
+
+  // Without hardware scroll every column moves left, so the whole plot
+  // is redrawn for each sample.
+  bus.resetStats();
+  bus.pixels = 0;
+  start = ESP.getCycleCount();
+  for (uint32_t n = 0; n < BENCHMARK_SAMPLES; n++) {
+    bus.beginTransaction();
+    for (int16_t x = 0; x < InputTrace::PLOT_WIDTH; x++) {
+      pushColumn(bus, InputTrace::PLOT_X + x, sampleAt(n + x));
+    }
+    bus.endTransaction();
+  }
+  uint32_t redrawn = ESP.getCycleCount() - start;
+  printResult(out, "Full redraw", bus, 0, redrawn);
+}
+
+#endif
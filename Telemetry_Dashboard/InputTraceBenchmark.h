@@ -0,0 +1,14 @@
+#ifndef INPUT_TRACE_BENCHMARK_H
+#define INPUT_TRACE_BENCHMARK_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+#if ENABLE_INPUT_TRACE_BENCHMARK
+// Pushes input trace samples through a counting bus, once as a single
+// scrolled column per sample and once redrawing every plot column, and
+// prints pixels, bus bytes and cycles per sample for each.
+void runInputTraceBenchmark(Print& out);
+#endif
+
+#endif
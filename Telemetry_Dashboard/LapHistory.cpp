@@ -0,0 +1,117 @@
+#include "LapHistory.h"
+
+LapHistory::LapHistory() {
+  clear();
+}
+
+void LapHistory::clear() {
+  for (uint8_t i = 0; i < MAX_CARS; i++) {
+    resetCar(cars[i]);
+  }
+  sessionUID = 0;
+}
+
+void LapHistory::resetCar(Car& car) {
+  car.lapCount = 0;
+  car.validCount = 0;
+  car.mean = 0.0f;
+  car.m2 = 0.0f;
+}
+
+bool LapHistory::update(const PacketSessionHistoryData* packet) {
+  if (packet->m_carIdx >= MAX_CARS) return false;
+  if (packet->m_header.m_sessionUID != sessionUID) {
+    clear();
+    sessionUID = packet->m_header.m_sessionUID;
+  }
+
+  // The last entry is the lap in progress, with no time yet, except once
+  // the car has finished.
+  uint8_t completed = packet->m_numLaps < LAP_HISTORY_LAPS ? packet->m_numLaps : LAP_HISTORY_LAPS;
+  while (completed > 0 && packet->m_lapHistoryData[completed - 1].m_lapTimeInMS == 0) {
+    completed--;
+  }
+
+  Car& car = cars[packet->m_carIdx];
+  bool changed = false;
+
+  // A flashback across the line takes laps away, and the game can
+  // invalidate a lap just after it ends. Either way the car is rebuilt;
+  // the stats cannot take a lap back out.
+  uint8_t last = car.lapCount - 1;
+  if (car.lapCount > 0 &&
+      (completed <= last || packTime(packet->m_lapHistoryData[last]) != car.laps[last].timeAndFlags)) {
+    resetCar(car);
+    changed = true;
+  }
+
+  while (car.lapCount < completed) {
+    addLap(car, packet->m_lapHistoryData[car.lapCount]);
+    changed = true;
+  }
+  return changed;
+}
+
+void LapHistory::addLap(Car& car, const LapHistoryData& data) {
+  uint8_t index = car.lapCount++;
+  Lap& lap = car.laps[index];
+  lap.timeAndFlags = packTime(data);
+  lap.sector1MS = packSector(data.m_sector1TimeInMS, data.m_sector1TimeMinutes);
+  lap.sector2MS = packSector(data.m_sector2TimeInMS, data.m_sector2TimeMinutes);
+
+  if (!(data.m_lapValidBitFlags & LAP_VALID)) return;
+
+  // Laps arrive in order, so equal times stay in lap order.
+  uint32_t time = getLapTimeMS(lap);
+  uint8_t position = car.validCount;
+  while (position > 0 && getLapTimeMS(car.laps[car.byTime[position - 1]]) > time) {
+    car.byTime[position] = car.byTime[position - 1];
+    position--;
+  }
+  car.byTime[position] = index;
+  car.validCount++;
+
+  float delta = time - car.mean;
+  car.mean += delta / car.validCount;
+  car.m2 += delta * (time - car.mean);
+}
+
+uint32_t LapHistory::packTime(const LapHistoryData& data) {
+  uint32_t time = data.m_lapTimeInMS < LAP_TIME_MASK ? data.m_lapTimeInMS : LAP_TIME_MASK;
+  return time | (uint32_t)(data.m_lapValidBitFlags & 0x0F) << 28;
+}
+
+uint16_t LapHistory::packSector(uint16_t milliseconds, uint8_t minutes) {
+  uint32_t total = (uint32_t)minutes * 60000 + milliseconds;
+  return total < SECTOR_OVERFLOW ? total : SECTOR_OVERFLOW;
+}
+
+uint16_t LapHistory::getSector3MS(const Lap& lap) {
+  if (lap.sector1MS == SECTOR_OVERFLOW || lap.sector2MS == SECTOR_OVERFLOW) return SECTOR_OVERFLOW;
+
+  uint32_t sectors = (uint32_t)lap.sector1MS + lap.sector2MS;
+  uint32_t time = getLapTimeMS(lap);
+  if (time <= sectors) return 0;
+  return time - sectors < SECTOR_OVERFLOW ? time - sectors : SECTOR_OVERFLOW;
+}
+
+void LapHistory::getStats(uint8_t car, Stats& stats) const {
+  memset(&stats, 0, sizeof(stats));
+  if (car >= MAX_CARS || cars[car].validCount == 0) return;
+
+  const Car& history = cars[car];
+  uint8_t count = history.validCount;
+  stats.laps = count;
+  stats.bestLap = history.byTime[0];
+  stats.bestMS = getLapTimeMS(history.laps[history.byTime[0]]);
+
+  uint32_t upper = getLapTimeMS(history.laps[history.byTime[count / 2]]);
+  if (count % 2 == 1) {
+    stats.medianMS = upper;
+  } else {
+    uint32_t lower = getLapTimeMS(history.laps[history.byTime[count / 2 - 1]]);
+    stats.medianMS = (lower + upper) / 2;
+  }
+
+  stats.stddevMS = count > 1 ? sqrtf(history.m2 / (count - 1)) : 0.0f;
+}
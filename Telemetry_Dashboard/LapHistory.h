@@ -0,0 +1,89 @@
+#ifndef LAP_HISTORY_H
+#define LAP_HISTORY_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// ============================================
+// Lap History
+// ============================================
+// Completed laps for every car, from the session history packet. The
+// game sends one car per packet, each time with that car's whole history,
+// so update() copies only the laps completed since the car's last packet.
+//
+// A lap is 8 bytes: the lap time and the four validity flags share one
+// word, and sectors 1 and 2 are 16-bit (sector 3 is what remains of the
+// lap). Consistency figures are kept per car as laps arrive: a running
+// mean and sum of squared deviations for the standard deviation, and the
+// valid laps in time order for the best and the median.
+class LapHistory {
+public:
+  // Validity flags, as in the packet.
+  static const uint8_t LAP_VALID = 0x01;
+  static const uint8_t SECTOR1_VALID = 0x02;
+  static const uint8_t SECTOR2_VALID = 0x04;
+  static const uint8_t SECTOR3_VALID = 0x08;
+
+  static const uint32_t LAP_TIME_MASK = 0x0FFFFFFF;  // Flags in the top four bits
+  static const uint16_t SECTOR_OVERFLOW = 0xFFFF;    // Sector of 65.535 s or more
+
+  struct Lap {
+    uint32_t timeAndFlags;
+    uint16_t sector1MS;
+    uint16_t sector2MS;
+  };
+
+  // Over valid laps only; all zero until the first one.
+  struct Stats {
+    uint8_t laps;
+    uint8_t bestLap;  // Index into the car's laps
+    uint32_t bestMS;
+    uint32_t medianMS;
+    float stddevMS;
+  };
+
+private:
+  struct Car {
+    Lap laps[LAP_HISTORY_LAPS];
+    uint8_t byTime[LAP_HISTORY_LAPS];  // Indices of the valid laps, fastest first
+    uint8_t lapCount;
+    uint8_t validCount;
+    float mean;  // Welford running mean and squared deviations, valid laps
+    float m2;
+  };
+
+  Car cars[MAX_CARS];
+  uint64_t sessionUID;
+
+  static void resetCar(Car& car);
+  static void addLap(Car& car, const LapHistoryData& data);
+  static uint32_t packTime(const LapHistoryData& data);
+  static uint16_t packSector(uint16_t milliseconds, uint8_t minutes);
+
+public:
+  LapHistory();
+
+  // Returns true if the car's laps changed.
+  bool update(const PacketSessionHistoryData* packet);
+  void clear();
+
+  uint8_t getLapCount(uint8_t car) const {
+    return car < MAX_CARS ? cars[car].lapCount : 0;
+  }
+  // lap counts from 0, the first lap of the session.
+  const Lap& getLap(uint8_t car, uint8_t lap) const {
+    return cars[car].laps[lap];
+  }
+  void getStats(uint8_t car, Stats& stats) const;
+
+  static uint32_t getLapTimeMS(const Lap& lap) {
+    return lap.timeAndFlags & LAP_TIME_MASK;
+  }
+  static uint8_t getFlags(const Lap& lap) {
+    return lap.timeAndFlags >> 28;
+  }
+  // SECTOR_OVERFLOW if either of the other sectors overflowed.
+  static uint16_t getSector3MS(const Lap& lap);
+};
+
+#endif
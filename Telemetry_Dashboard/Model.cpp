@@ -1,103 +1,96 @@
 #include "Model.h"
 
+// ============================================
+// FIELD EXPANSIONS
+// ============================================
+#define FIELD_RESET_X(pkt, id, member, getter, source, type, res, units) member = 0;
+#define FIELD_RESET_C(pkt, id, member, getter, source, type, res, units) \
+  member[0] = 0; \
+  member[1] = 0; \
+  member[2] = 0; \
+  member[3] = 0;
+#define FIELD_RESET_D(id, member, getter, type, res, units) member = 0;
+
+#define FIELD_DECODE_X(pkt, id, member, getter, source, type, res, units) \
+  setField(member, (type)data->source, res, FIELD_##id);
+#define FIELD_DECODE_P(pkt, id, member, getter, source, type, res, units) \
+  setField(member, (type)packet->source, res, FIELD_##id);
+#define FIELD_DECODE_C(pkt, id, member, getter, source, type, res, units) \
+  setField(member[0], (type)data->source[0], res, FIELD_##id##_RL); \
+  setField(member[1], (type)data->source[1], res, FIELD_##id##_RR); \
+  setField(member[2], (type)data->source[2], res, FIELD_##id##_FL); \
+  setField(member[3], (type)data->source[3], res, FIELD_##id##_FR);
+
+#define FIELD_PRINT_X(pkt, id, member, getter, source, type, res, units) printField(out, FIELD_##id, member);
+#define FIELD_PRINT_C(pkt, id, member, getter, source, type, res, units) \
+  printField(out, FIELD_##id##_RL, member[0]); \
+  printField(out, FIELD_##id##_RR, member[1]); \
+  printField(out, FIELD_##id##_FL, member[2]); \
+  printField(out, FIELD_##id##_FR, member[3]);
+#define FIELD_PRINT_D(id, member, getter, type, res, units) printField(out, FIELD_##id, member);
+
+#define FIELD_VALUE_X(pkt, id, member, getter, source, type, res, units) \
+  case FIELD_##id: return (float)member;
+#define FIELD_VALUE_C(pkt, id, member, getter, source, type, res, units) \
+  case FIELD_##id##_RL: return (float)member[0]; \
+  case FIELD_##id##_RR: return (float)member[1]; \
+  case FIELD_##id##_FL: return (float)member[2]; \
+  case FIELD_##id##_FR: return (float)member[3];
+#define FIELD_VALUE_D(id, member, getter, type, res, units) \
+  case FIELD_##id: return (float)member;
+
+#define FIELD_SERIALIZE_ONE(fieldId, value) \
+  if (mask.test(fieldId) && !appendField(buffer, size, used, fieldId, &(value), sizeof(value))) return used;
+#define FIELD_SERIALIZE_X(pkt, id, member, getter, source, type, res, units) FIELD_SERIALIZE_ONE(FIELD_##id, member)
+#define FIELD_SERIALIZE_C(pkt, id, member, getter, source, type, res, units) \
+  FIELD_SERIALIZE_ONE(FIELD_##id##_RL, member[0]) \
+  FIELD_SERIALIZE_ONE(FIELD_##id##_RR, member[1]) \
+  FIELD_SERIALIZE_ONE(FIELD_##id##_FL, member[2]) \
+  FIELD_SERIALIZE_ONE(FIELD_##id##_FR, member[3])
+#define FIELD_SERIALIZE_D(id, member, getter, type, res, units) FIELD_SERIALIZE_ONE(FIELD_##id, member)
+
 TelemetryModel::TelemetryModel() {
-  // ============================================
-  // PacketSessionData
-  // ============================================
-  weather = 0;
-  trackTemperature = 0;
-  airTemperature = 0;
+  MODEL_FIELDS(FIELD_RESET_X, FIELD_RESET_X, FIELD_RESET_C, FIELD_RESET_D)
+
   sessionType = SESSION_UNKNOWN;
-  sessionTimeLeft = 0;
-  safetyCarStatus = 0;
-  totalLaps = 0;
-
-  // ============================================
-  // LapData
-  // ============================================
-  lastLapTimeMS = 0;
-  currentLapTimeMS = 0;
-  sector1TimeMS = 0;
-  sector2TimeMS = 0;
-  deltaToCarInFrontMS = 0;
-  deltaToRaceLeaderMS = 0;
-  carPosition = 0;
-  currentLapNum = 0;
-  cornerCuttingWarnings = 0;
-  bestLapTimeMS = 0;
-  lapDistance = 0.0f;
+  diffOnThrottle = 50;
+  frontBrakeBias = 50;
+  trackId = -1;
+  fuelAtFinish = FUEL_NO_ESTIMATE;
+  fuelSavePerLap = FUEL_NO_ESTIMATE;
+  pitLossMS = STRATEGY_DEFAULT_PIT_LOSS_MS;
+
   referencePointCount = 0;
   currentRecordingCount = 0;
   trackLength = 0.0f;
   hasReferenceLap = false;
-
-  // ============================================
-  // CarSetupData
-  // ============================================
-  diffOnThrottle = 50;
-
-  // ============================================
-  // CarTelemetryData
-  // ============================================
-  speed = 0;
-  throttle = 0.0f;
-  brake = 0.0f;
-  gear = 0;
-  engineRPM = 0;
-  drs = 0;
-  revLightsPercent = 0;
-  engineTemp = 0;
-  suggestedGear = 0;
-
-  for (uint8_t i = 0; i < 4; i++) {
-    brakesTemp[i] = 0;
-    tyresSurfaceTemp[i] = 0;
-    tyresInnerTemp[i] = 0;
-    tyresPressure[i] = 0.0f;
+  recordingComplete = true;
+  lapDataArrivalMS = 0;
+  lapTimeErrorMS = 0;
+  lapDistanceError = 0.0f;
+
+  for (uint8_t i = 0; i < MAX_CARS; i++) {
+    carPositions[i].x = 0.0f;
+    carPositions[i].z = 0.0f;
   }
+  playerCarIndex = 0;
+  gForceSumLateral = 0.0f;
+  gForceSumLongitudinal = 0.0f;
+  gForceFrames = 0;
+  memset(&strategyPlan, 0, sizeof(strategyPlan));
+  usedDryCompounds = 0;
+  fuelSamplePending = false;
+  fuelLapPending = false;
+  wearSamplePending = false;
 
-  // ============================================
-  // CarStatusData
-  // ============================================
-  frontBrakeBias = 50;
-  fuelInTank = 0.0f;
-  fuelRemainingLaps = 0.0f;
-  tyresAgeLaps = 0;
-  enginePowerICE = 0.0f;
-  enginePowerMGUK = 0.0f;
-  ersStoreEnergy = 0.0f;
-  ersDeployMode = 0;
-
-  // ============================================
-  // CarDamageData
-  // ============================================
-  for (uint8_t i = 0; i < 4; i++) {
-    tyresWear[i] = 0.0f;
-    tyresDamage[i] = 0;
-    brakesDamage[i] = 0;
-  }
-
-  frontLeftWingDamage = 0;
-  frontRightWingDamage = 0;
-  rearWingDamage = 0;
-  floorDamage = 0;
-  diffuserDamage = 0;
-  sidepodDamage = 0;
-  drsFault = 0;
-  ersFault = 0;
-  gearBoxDamage = 0;
-  engineDamage = 0;
-  engineMGUHWear = 0;
-  engineESWear = 0;
-  engineCEWear = 0;
-  engineICEWear = 0;
-  engineMGUKWear = 0;
-  engineTCWear = 0;
-
-  // ============================================
-  // Utility
-  // ============================================
   packetsReceived = 0;
+  dirtyFields.clear();
+
+  packetCache = NULL;
+  for (uint8_t i = 0; i < PACKET_ID_COUNT; i++) {
+    decodedGeneration[i] = 0;
+  }
+  trackGeneration = 0;
 }
 
 // ============================================
@@ -107,48 +100,84 @@ TelemetryModel::TelemetryModel() {
 void TelemetryModel::updateSessionData(const PacketSessionData* packet) {
   if (!packet) return;
 
-  weather = packet->m_weather;
-  trackTemperature = packet->m_trackTemperature;
-  airTemperature = packet->m_airTemperature;
-  sessionType = packet->m_sessionType;
-  sessionTimeLeft = packet->m_sessionTimeLeft;
-  safetyCarStatus = packet->m_safetyCarStatus;
-  totalLaps = packet->m_totalLaps;
+  const PacketSessionData* data = packet;
+
+  SESSION_FIELDS(FIELD_DECODE_X, FIELD_DECODE_P, FIELD_DECODE_C)
 }
 
-void TelemetryModel::updateLapData(const PacketLapData* packet, uint8_t playerIndex) {
+void TelemetryModel::updateLapData(const PacketLapData* packet, uint8_t playerIndex, uint32_t nowMS) {
   if (!packet || playerIndex >= MAX_CARS) return;
 
   const LapData* data = &packet->m_lapData[playerIndex];
 
-  lastLapTimeMS = data->m_lastLapTimeInMS;
-  currentLapTimeMS = data->m_currentLapTimeInMS;
-  sector1TimeMS = data->m_sector1TimeInMS;
-  sector2TimeMS = data->m_sector2TimeInMS;
-  deltaToCarInFrontMS = data->m_deltaToCarInFrontInMS;
-  deltaToRaceLeaderMS = data->m_deltaToRaceLeaderInMS;
-  carPosition = data->m_carPosition;
-  currentLapNum = data->m_currentLapNum;
-  cornerCuttingWarnings = data->m_cornerCuttingWarnings;
-
+  uint32_t projectedTimeMS;
+  float projectedDistance;
+  projectLap(nowMS, projectedTimeMS, projectedDistance);
   float prevLapDistance = lapDistance;
-  lapDistance = data->m_lapDistance;
+  uint8_t prevLapNum = currentLapNum;
+  uint8_t prevPitStatus = pitStatus;
+  uint16_t prevPitLaneTimeMS = pitLaneTimeMS;
+
+  LAP_DATA_FIELDS(FIELD_DECODE_X, FIELD_DECODE_P, FIELD_DECODE_C)
+
+  // A new lap, a flashback or an error too big to blend out in time is
+  // taken at once.
+  int32_t timeError = (int32_t)(projectedTimeMS - currentLapTimeMS);
+  float distanceError = projectedDistance - lapDistance;
+  bool snap = lapDataArrivalMS == 0 || currentLapNum != prevLapNum || timeError >= (int32_t)LIVE_LAP_BLEND_MS ||
+              timeError <= -(int32_t)LIVE_LAP_BLEND_MS || fabsf(distanceError) > LIVE_LAP_SNAP_M;
+  lapTimeErrorMS = snap ? 0 : timeError;
+  lapDistanceError = snap ? 0.0f : distanceError;
+  lapDataArrivalMS = nowMS;
+
+  // A stop is timed by the pit lane timer's last reading before the car
+  // rejoins, less the stretch of track the lane stands in for.
+  if (prevPitStatus != 0 && pitStatus == 0 && prevPitLaneTimeMS > STRATEGY_PIT_BYPASS_MS) {
+    setField(pitLossMS, (uint16_t)(prevPitLaneTimeMS - STRATEGY_PIT_BYPASS_MS), 0, FIELD_PIT_LOSS);
+  }
 
   bool lapFinished = (lapDistance < 100.0f && prevLapDistance > 100.0f);
 
+  // Fuel and tyre wear are sampled at lap and mini-sector boundaries;
+  // only then are the slow packets they need refreshed on this path.
+  if (currentLapNum < prevLapNum) {
+    fuelModel.reset();
+    fuelLapPending = false;
+    usedDryCompounds = 0;
+  }
+  // A lap still waiting to be closed is closed first, so the stop counts
+  // against the new one.
+  if (pitStatus != 0) {
+    sampleFuel();
+    fuelModel.excludeLap();
+  }
+  syncTrack();
+  float lapFraction = trackLengthM > 0 ? lapDistance / trackLengthM : 0.0f;
+  if (lapFinished || fuelModel.crossedMiniSector(lapFraction)) {
+    // Two lines with no sample between them leave a lap without a start.
+    if (lapFinished && fuelLapPending) fuelModel.excludeLap();
+    if (lapFinished) fuelLapPending = true;
+    fuelSamplePending = true;
+    wearSamplePending = true;
+  }
+
   if (lapFinished) {
     if (lastLapTimeMS > 0) {
       if (bestLapTimeMS == 0 || lastLapTimeMS < bestLapTimeMS) {
-        bestLapTimeMS = lastLapTimeMS;
-        hasReferenceLap = true;
-        trackLength = prevLapDistance;
-        for (uint16_t i = 0; i < currentRecordingCount; i++) {
-          referenceLap[i] = currentRecording[i];
+        setField(bestLapTimeMS, lastLapTimeMS, 0, FIELD_BEST_LAP_TIME);
+        // A lap with a flashback in it keeps the previous reference.
+        if (recordingComplete) {
+          hasReferenceLap = true;
+          trackLength = prevLapDistance;
+          for (uint16_t i = 0; i < currentRecordingCount; i++) {
+            referenceLap[i] = currentRecording[i];
+          }
+          referencePointCount = currentRecordingCount;
         }
-        referencePointCount = currentRecordingCount;
       }
     }
     currentRecordingCount = 0;
+    recordingComplete = true;
   }
 
   if (currentRecordingCount < MAX_REFERENCE_POINTS && currentLapTimeMS > 0 && lapDistance > 0) {
@@ -169,6 +198,171 @@ void TelemetryModel::updateLapData(const PacketLapData* packet, uint8_t playerIn
       currentRecordingCount++;
     }
   }
+
+  extrapolateLap(nowMS);
+}
+
+// The error is blended out linearly, so the clock never runs backwards:
+// it is under LIVE_LAP_BLEND_MS by construction.
+void TelemetryModel::projectLap(uint32_t nowMS, uint32_t& timeMS, float& distance) const {
+  // Signed: a packet handled after nowMS was read is stamped later.
+  int32_t sinceArrival = (int32_t)(nowMS - lapDataArrivalMS);
+  if (lapDataArrivalMS == 0 || sinceArrival < 0) sinceArrival = 0;
+  uint32_t elapsed = sinceArrival;
+  if (elapsed > LIVE_LAP_MAX_EXTRAPOLATION_MS) elapsed = LIVE_LAP_MAX_EXTRAPOLATION_MS;
+  float blend = elapsed < LIVE_LAP_BLEND_MS ? 1.0f - (float)elapsed / LIVE_LAP_BLEND_MS : 0.0f;
+
+  int32_t time = (int32_t)(currentLapTimeMS + elapsed) + (int32_t)lroundf(lapTimeErrorMS * blend);
+  timeMS = time > 0 ? time : 0;
+
+  // km/h is metres per 3600 ms.
+  distance = lapDistance + speed * elapsed / 3600.0f + lapDistanceError * blend;
+}
+
+void TelemetryModel::extrapolateLap(uint32_t nowMS) {
+  bool deltaWasAvailable = isDeltaLiveAvailable();
+
+  uint32_t timeMS;
+  float distance;
+  projectLap(nowMS, timeMS, distance);
+  setField(liveLapTimeMS, timeMS, 0, FIELD_LIVE_LAP_TIME);
+  setField(liveLapDistance, distance, 0.1f, FIELD_LIVE_LAP_DISTANCE);
+
+  setField(deltaLive, computeDeltaLive(), 0.001f, FIELD_DELTA_LIVE);
+  if (isDeltaLiveAvailable() != deltaWasAvailable) {
+    dirtyFields.set(FIELD_DELTA_LIVE);
+  }
+}
+
+// Nothing reads the tank between boundaries unless a screen shows it;
+// the strategy refresh at each new lap and every STRATEGY_REFRESH_MS
+// otherwise brings the decode, and so the sample, soon after. The
+// sample is taken where the car is at the decode.
+void TelemetryModel::sampleFuel() {
+  if (!fuelSamplePending) return;
+  fuelSamplePending = false;
+
+  refresh(PACKET_ID_SESSION);
+  refresh(PACKET_ID_CAR_STATUS);
+  float lapFraction = trackLengthM > 0 ? lapDistance / trackLengthM : 0.0f;
+  if (safetyCarStatus != 0) fuelModel.excludeLap();
+  if (fuelLapPending) {
+    fuelModel.startLap(fuelInTank, lapFraction);
+    fuelLapPending = false;
+  }
+  updateFuelPrediction(lapFraction);
+}
+
+void TelemetryModel::updateFuelPrediction(float lapFraction) {
+  FuelModel::Prediction prediction;
+  fuelModel.predict(fuelInTank, lapFraction, currentLapNum, totalLaps, prediction);
+  setField(fuelBurnPerLap, prediction.burnPerLap, 0.01f, FIELD_FUEL_BURN_PER_LAP);
+  setField(fuelAtFinish, prediction.fuelAtFinish, 0.1f, FIELD_FUEL_AT_FINISH);
+  setField(fuelSavePerLap, prediction.savePerLap, 0.01f, FIELD_FUEL_SAVE_PER_LAP);
+}
+
+// As with the fuel, at the car's position when the decode comes.
+void TelemetryModel::sampleTyreWear() {
+  if (!wearSamplePending) return;
+  wearSamplePending = false;
+
+  refresh(PACKET_ID_CAR_STATUS);
+  refresh(PACKET_ID_CAR_DAMAGE);
+  float lapFraction = trackLengthM > 0 ? lapDistance / trackLengthM : 0.0f;
+
+  float temperature[4];
+  for (uint8_t i = 0; i < 4; i++) {
+    temperature[i] = (tyresSurfaceTemp[i] + tyresInnerTemp[i]) / 2.0f;
+  }
+
+  float progress = (currentLapNum > 0 ? currentLapNum - 1 : 0) + constrain(lapFraction, 0.0f, 1.0f);
+  if (tyreWear.sample(progress, tyresWear, temperature, tyresAgeLaps)) {
+    setField(tyreDegradationVersion, (uint16_t)(tyreDegradationVersion + 1), 0, FIELD_TYRE_DEGRADATION);
+  }
+}
+
+// ============================================
+// PIT STRATEGY
+// ============================================
+
+void TelemetryModel::buildStrategyInputs(StrategyPlanner::Inputs& inputs) {
+  refresh(PACKET_ID_SESSION);
+  refresh(PACKET_ID_CAR_STATUS);
+  refresh(PACKET_ID_CAR_DAMAGE);
+  refresh(PACKET_ID_TYRE_SETS);
+
+  memset(&inputs, 0, sizeof(inputs));
+  bool race = sessionType == SESSION_RACE || sessionType == SESSION_RACE2 || sessionType == SESSION_RACE3;
+  if (!race || totalLaps == 0 || currentLapNum == 0) return;
+
+  inputs.currentLap = currentLapNum;
+  inputs.totalLaps = totalLaps;
+  inputs.pitLossMS = pitLossMS;
+  inputs.compound = visualTyreCompound;
+
+  LapHistory::Stats stats;
+  lapHistory.getStats(playerCarIndex, stats);
+  inputs.paceMS = stats.medianMS;
+
+  // The worst corner decides the stint.
+  for (uint8_t i = 0; i < 4; i++) {
+    if (tyresWear[i] > inputs.wear) inputs.wear = tyresWear[i];
+    if (tyreWear.getRatePerLap(i) > inputs.wearRate) inputs.wearRate = tyreWear.getRatePerLap(i);
+  }
+
+  uint8_t fittedLife = 0;
+  for (uint8_t i = 0; i < tyreSets.getCount(); i++) {
+    if (tyreSets.getSet(i).fitted) fittedLife = tyreSets.getSet(i).usableLife;
+  }
+  // Until the wear fit has a lap in it, the game's usable life stands in
+  // for the trend.
+  if (inputs.wearRate == 0.0f && fittedLife > 0) inputs.wearRate = TYRE_WEAR_CLIFF / fittedLife;
+
+  // One option per compound, its freshest set. Other compounds wear at
+  // the fitted one's rate scaled by the ratio of usable lives.
+  for (uint8_t i = 0; i < tyreSets.getCount(); i++) {
+    const TyreSetTable::TyreSet& set = tyreSets.getSet(i);
+    if (set.fitted) continue;
+
+    uint8_t o = 0;
+    while (o < inputs.optionCount && inputs.options[o].compound != set.visualCompound) o++;
+    if (o == STRATEGY_MAX_OPTIONS) continue;
+
+    StrategyPlanner::Option& option = inputs.options[o];
+    option.sets++;
+    if (o == inputs.optionCount) {
+      inputs.optionCount++;
+    } else if (set.wear >= option.wear) {
+      continue;
+    }
+
+    option.compound = set.visualCompound;
+    option.deltaMS = set.lapDeltaMS;
+    option.wear = set.wear;
+    if (set.usableLife == 0) {
+      option.wearRate = inputs.wearRate;
+    } else if (fittedLife > 0 && inputs.wearRate > 0.0f) {
+      option.wearRate = inputs.wearRate * fittedLife / set.usableLife;
+    } else {
+      option.wearRate = TYRE_WEAR_CLIFF / set.usableLife;
+    }
+  }
+
+  bool dry = visualTyreCompound >= 16 && visualTyreCompound <= 18;
+  if (dry) usedDryCompounds |= 1 << (visualTyreCompound - 16);
+  inputs.needsOtherCompound = dry && (usedDryCompounds & (usedDryCompounds - 1)) == 0;
+}
+
+// Redrawn when the plan or its times change at display resolution; the
+// predicted race time moves a little with every search.
+void TelemetryModel::updateStrategy(const StrategyPlanner::Plan& plan) {
+  const StrategyPlanner::Plan& shown = strategyPlan;
+  bool changed = plan.valid != shown.valid || plan.stops != shown.stops ||
+                 memcmp(plan.pitLap, shown.pitLap, sizeof(plan.pitLap)) != 0 ||
+                 memcmp(plan.compound, shown.compound, sizeof(plan.compound)) != 0 ||
+                 plan.raceTimeMS / 1000 != shown.raceTimeMS / 1000 || plan.marginMS / 100 != shown.marginMS / 100;
+  strategyPlan = plan;
+  if (changed) setField(strategyPlanVersion, (uint16_t)(strategyPlanVersion + 1), 0, FIELD_STRATEGY_PLAN);
 }
 
 void TelemetryModel::updateCarSetup(const PacketCarSetupData* packet, uint8_t playerIndex) {
@@ -176,7 +370,7 @@ void TelemetryModel::updateCarSetup(const PacketCarSetupData* packet, uint8_t pl
 
   const CarSetupData* data = &packet->m_carSetups[playerIndex];
 
-  diffOnThrottle = data->m_onThrottle;
+  CAR_SETUPS_FIELDS(FIELD_DECODE_X, FIELD_DECODE_P, FIELD_DECODE_C)
 }
 
 void TelemetryModel::updateTelemetry(const PacketCarTelemetryData* packet, uint8_t playerIndex) {
@@ -184,22 +378,13 @@ void TelemetryModel::updateTelemetry(const PacketCarTelemetryData* packet, uint8
 
   const CarTelemetryData* data = &packet->m_carTelemetryData[playerIndex];
 
-  speed = data->m_speed;
-  throttle = data->m_throttle;
-  brake = data->m_brake;
-  gear = data->m_gear;
-  engineRPM = data->m_engineRPM;
-  drs = data->m_drs;
-  revLightsPercent = data->m_revLightsPercent;
-  engineTemp = data->m_engineTemperature;
-  suggestedGear = packet->m_suggestedGear;
+  CAR_TELEMETRY_FIELDS(FIELD_DECODE_X, FIELD_DECODE_P, FIELD_DECODE_C)
 
-  for (uint8_t i = 0; i < 4; i++) {
-    brakesTemp[i] = data->m_brakesTemperature[i];
-    tyresSurfaceTemp[i] = data->m_tyresSurfaceTemperature[i];
-    tyresInnerTemp[i] = data->m_tyresInnerTemperature[i];
-    tyresPressure[i] = data->m_tyresPressure[i];
-  }
+  InputSample& sample = inputHistory[inputSamples % INPUT_HISTORY_SAMPLES];
+  sample.throttle = (uint8_t)lroundf(constrain(throttle, 0.0f, 1.0f) * 100.0f);
+  sample.brake = (uint8_t)lroundf(constrain(brake, 0.0f, 1.0f) * 100.0f);
+  sample.steer = (int8_t)lroundf(constrain(steer, -1.0f, 1.0f) * 100.0f);
+  setField(inputSamples, inputSamples + 1, 0, FIELD_INPUT_SAMPLES);
 
   packetsReceived++;
 }
@@ -209,14 +394,7 @@ void TelemetryModel::updateCarStatus(const PacketCarStatusData* packet, uint8_t
 
   const CarStatusData* data = &packet->m_carStatusData[playerIndex];
 
-  frontBrakeBias = data->m_frontBrakeBias;
-  fuelInTank = data->m_fuelInTank;
-  fuelRemainingLaps = data->m_fuelRemainingLaps;
-  tyresAgeLaps = data->m_tyresAgeLaps;
-  enginePowerICE = data->m_enginePowerICE;
-  enginePowerMGUK = data->m_enginePowerMGUK;
-  ersStoreEnergy = data->m_ersStoreEnergy;
-  ersDeployMode = data->m_ersDeployMode;
+  CAR_STATUS_FIELDS(FIELD_DECODE_X, FIELD_DECODE_P, FIELD_DECODE_C)
 }
 
 void TelemetryModel::updateCarDamage(const PacketCarDamageData* packet, uint8_t playerIndex) {
@@ -224,39 +402,198 @@ void TelemetryModel::updateCarDamage(const PacketCarDamageData* packet, uint8_t
 
   const CarDamageData* data = &packet->m_carDamageData[playerIndex];
 
-  for (uint8_t i = 0; i < 4; i++) {
-    tyresWear[i] = data->m_tyresWear[i];
-    tyresDamage[i] = data->m_tyresDamage[i];
-    brakesDamage[i] = data->m_brakesDamage[i];
+  CAR_DAMAGE_FIELDS(FIELD_DECODE_X, FIELD_DECODE_P, FIELD_DECODE_C)
+}
+
+// The packet cycles through the cars; only the player's is cached.
+void TelemetryModel::updateTyreSets(const PacketTyreSetsData* packet, uint8_t playerIndex) {
+  if (!packet || packet->m_carIdx != playerIndex) return;
+
+  if (tyreSets.update(packet)) {
+    setField(tyreSetsVersion, (uint16_t)(tyreSetsVersion + 1), 0, FIELD_TYRE_SETS);
   }
+}
 
-  frontLeftWingDamage = data->m_frontLeftWingDamage;
-  frontRightWingDamage = data->m_frontRightWingDamage;
-  rearWingDamage = data->m_rearWingDamage;
-  floorDamage = data->m_floorDamage;
-  diffuserDamage = data->m_diffuserDamage;
-  sidepodDamage = data->m_sidepodDamage;
-  drsFault = data->m_drsFault;
-  ersFault = data->m_ersFault;
-  gearBoxDamage = data->m_gearBoxDamage;
-  engineDamage = data->m_engineDamage;
-  engineMGUHWear = data->m_engineMGUHWear;
-  engineESWear = data->m_engineESWear;
-  engineCEWear = data->m_engineCEWear;
-  engineICEWear = data->m_engineICEWear;
-  engineMGUKWear = data->m_engineMGUKWear;
-  engineTCWear = data->m_engineTCWear;
+// Motion arrives at the telemetry rate. Positions are kept for every car
+// and the map redraw is driven by motionFrames rather than per-car fields;
+// G-forces are decoded for the player only.
+void TelemetryModel::updateMotion(const PacketMotionData* packet, uint8_t playerIndex) {
+  if (!packet || playerIndex >= MAX_CARS) return;
+
+  for (uint8_t i = 0; i < MAX_CARS; i++) {
+    carPositions[i].x = packet->m_carMotionData[i].m_worldPositionX;
+    carPositions[i].z = packet->m_carMotionData[i].m_worldPositionZ;
+  }
+  playerCarIndex = playerIndex;
+  setField(motionFrames, motionFrames + 1, 0, FIELD_MOTION_FRAMES);
+
+  const CarMotionData* data = &packet->m_carMotionData[playerIndex];
+
+  MOTION_FIELDS(FIELD_DECODE_X, FIELD_DECODE_P, FIELD_DECODE_C)
+
+  // Averaging rather than picking every Nth frame keeps kerb strikes
+  // from aliasing into the trail.
+  gForceSumLateral += gForceLateral;
+  gForceSumLongitudinal += gForceLongitudinal;
+  if (++gForceFrames == GFORCE_DECIMATION) {
+    GForceSample& sample = gForceHistory[gForceSamples % GFORCE_HISTORY_POINTS];
+    sample.lateral = (int16_t)lroundf(gForceSumLateral * 100.0f / GFORCE_DECIMATION);
+    sample.longitudinal = (int16_t)lroundf(gForceSumLongitudinal * 100.0f / GFORCE_DECIMATION);
+    gForceSumLateral = 0.0f;
+    gForceSumLongitudinal = 0.0f;
+    gForceFrames = 0;
+    setField(gForceSamples, gForceSamples + 1, 0, FIELD_GFORCE_SAMPLES);
+  }
+
+  syncTrack();
+  const CarPosition& player = carPositions[playerIndex];
+  TrackMap::State state = trackMap.getState();
+  if (trackMap.addSample(lapDistance, player.x, player.z)) {
+    setField(trackMapVersion, (uint16_t)(trackMapVersion + 1), 0, FIELD_TRACK_MAP_VERSION);
+  }
+  setField(trackMapProgress, trackMap.getRecordingProgress(), 0, FIELD_TRACK_MAP_PROGRESS);
+  // Waiting and recording both start at 0%; the status text still changes.
+  if (trackMap.getState() != state) {
+    dirtyFields.set(FIELD_TRACK_MAP_PROGRESS);
+  }
+}
+
+void TelemetryModel::updateParticipants(const PacketParticipantsData* packet) {
+  if (!packet) return;
+
+  if (participants.update(packet)) {
+    setField(participantsVersion, (uint16_t)(participantsVersion + 1), 0, FIELD_PARTICIPANTS);
+  }
+}
+
+// Every car's packet is ingested; only the player's marks the field dirty.
+void TelemetryModel::updateSessionHistory(const PacketSessionHistoryData* packet, uint8_t playerIndex) {
+  if (!packet) return;
+
+  if (lapHistory.update(packet) && packet->m_carIdx == playerIndex) {
+    setField(lapHistoryVersion, (uint16_t)(lapHistoryVersion + 1), 0, FIELD_LAP_HISTORY);
+  }
+}
+
+// The delta recording may now hold points from a future that never
+// happened, the map recording a jump and the fuel lap a refill; none of
+// them can be repaired.
+void TelemetryModel::handleFlashback() {
+  recordingComplete = false;
+  trackMap.abortRecording();
+  sampleFuel();
+  fuelModel.excludeLap();
+}
+
+// ============================================
+// LAZY DECODE
+// ============================================
+
+void TelemetryModel::attachCache(const PacketCache* cache) {
+  packetCache = cache;
+}
+
+// The map records and the lap is split into mini-sectors whatever the
+// screen, so both need the track on every packet. Only the two fields
+// they use are read, and only once per session packet; the rest waits
+// for a screen that shows it.
+void TelemetryModel::syncTrack() {
+  if (!packetCache) return;
+
+  uint32_t generation = packetCache->getGeneration(PACKET_ID_SESSION);
+  if (generation == trackGeneration) return;
+  trackGeneration = generation;
+
+  const PacketSessionData* data = (const PacketSessionData*)packetCache->get(PACKET_ID_SESSION);
+  if (!data) return;
+  setField(trackId, data->m_trackId, 0, FIELD_TRACK_ID);
+  setField(trackLengthM, data->m_trackLength, 0, FIELD_TRACK_LENGTH);
+  if (trackMap.selectTrack(trackId, trackLengthM)) {
+    setField(trackMapVersion, (uint16_t)(trackMapVersion + 1), 0, FIELD_TRACK_MAP_VERSION);
+  }
+}
+
+void TelemetryModel::refresh(uint8_t packetId) {
+  if (!packetCache || packetId >= PACKET_ID_COUNT) return;
+
+  uint32_t generation = packetCache->getGeneration(packetId);
+  if (generation == decodedGeneration[packetId]) return;
+  decodedGeneration[packetId] = generation;
+
+  const uint8_t* data = packetCache->get(packetId);
+  if (!data) return;
+
+  uint8_t playerIndex = ((const PacketHeader*)data)->m_playerCarIndex;
+
+  switch (packetId) {
+    case PACKET_ID_SESSION:
+      updateSessionData((const PacketSessionData*)data);
+      break;
+    case PACKET_ID_CAR_SETUPS:
+      updateCarSetup((const PacketCarSetupData*)data, playerIndex);
+      break;
+    case PACKET_ID_CAR_STATUS:
+      updateCarStatus((const PacketCarStatusData*)data, playerIndex);
+      sampleFuel();
+      break;
+    case PACKET_ID_CAR_DAMAGE:
+      updateCarDamage((const PacketCarDamageData*)data, playerIndex);
+      sampleTyreWear();
+      break;
+    case PACKET_ID_TYRE_SETS:
+      updateTyreSets((const PacketTyreSetsData*)data, playerIndex);
+      break;
+    default:
+      break;
+  }
 }
 
 // ============================================
-// UTILITY
+// LOGGING & DEBUG OUTPUT
 // ============================================
 
-void TelemetryModel::formatLapTime(uint32_t timeMS, char* buffer) {
-  uint32_t totalSeconds = timeMS / 1000;
-  uint32_t minutes = totalSeconds / 60;
-  uint32_t seconds = totalSeconds % 60;
-  uint32_t millis = (timeMS % 1000) / 10;
+template <typename T>
+void TelemetryModel::printField(Print& out, ModelField id, T value) const {
+  const FieldDescriptor& desc = FIELD_DESCRIPTORS[id];
+
+  out.print(desc.name);
+  out.print(" = ");
+  if (desc.type == FIELD_TYPE_FLOAT) {
+    uint8_t decimals = desc.resolution >= 1.0f ? 0 : (desc.resolution >= 0.1f ? 1 : (desc.resolution >= 0.01f ? 2 : 3));
+    out.print((float)value, decimals);
+  } else {
+    out.print((long)value);
+  }
+  if (desc.units[0] != '\0') {
+    out.print(" ");
+    out.print(desc.units);
+  }
+  out.println();
+}
+
+void TelemetryModel::printFields(Print& out) const {
+  MODEL_FIELDS(FIELD_PRINT_X, FIELD_PRINT_X, FIELD_PRINT_C, FIELD_PRINT_D)
+}
+
+float TelemetryModel::getFieldValue(ModelField id) const {
+  switch (id) {
+    MODEL_FIELDS(FIELD_VALUE_X, FIELD_VALUE_X, FIELD_VALUE_C, FIELD_VALUE_D)
+    default: return 0.0f;
+  }
+}
 
-  sprintf(buffer, "%d:%02d.%02d", minutes, seconds, millis);
-}
\ No newline at end of file
+bool TelemetryModel::appendField(uint8_t* buffer, size_t size, size_t& used, ModelField id, const void* value, size_t length) const {
+  if (used + 1 + length > size) {
+    return false;
+  }
+  buffer[used++] = id;
+  memcpy(buffer + used, value, length);
+  used += length;
+  return true;
+}
+
+size_t TelemetryModel::serializeFields(uint8_t* buffer, size_t size, const DirtyMask& mask) const {
+  size_t used = 0;
+  MODEL_FIELDS(FIELD_SERIALIZE_X, FIELD_SERIALIZE_X, FIELD_SERIALIZE_C, FIELD_SERIALIZE_D)
+  return used;
+}
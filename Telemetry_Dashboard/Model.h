@@ -3,34 +3,42 @@
 
 #include <Arduino.h>
 #include "Config.h"
+#include "ModelFields.h"
+#include "PacketCache.h"
+#include "TrackMap.h"
+#include "Participants.h"
+#include "LapHistory.h"
+#include "TyreSets.h"
+#include "FuelModel.h"
+#include "TyreWear.h"
+#include "Strategy.h"
+
+#define FIELD_STORAGE_X(pkt, id, member, getter, source, type, res, units) type member;
+#define FIELD_STORAGE_C(pkt, id, member, getter, source, type, res, units) type member[4];
+#define FIELD_STORAGE_D(id, member, getter, type, res, units) type member;
+
+#define FIELD_GETTER_X(pkt, id, member, getter, source, type, res, units) \
+  type get##getter() const { \
+    return member; \
+  }
+#define FIELD_GETTER_C(pkt, id, member, getter, source, type, res, units) \
+  type get##getter(uint8_t corner) const { \
+    return member[corner]; \
+  }
+#define FIELD_GETTER_D(id, member, getter, type, res, units) \
+  type get##getter() const { \
+    return member; \
+  }
 
 class TelemetryModel {
   // ============================================
-  // PacketSessionData
+  // Decoded Fields (see ModelFields.h)
   // ============================================
-  uint8_t weather;
-  int8_t trackTemperature;
-  int8_t airTemperature;
-  uint8_t sessionType;
-  uint16_t sessionTimeLeft;
-  uint8_t safetyCarStatus;
-  uint8_t totalLaps;
+  MODEL_FIELDS(FIELD_STORAGE_X, FIELD_STORAGE_X, FIELD_STORAGE_C, FIELD_STORAGE_D)
 
   // ============================================
-  // LapData
+  // Live Delta Reference
   // ============================================
-  uint32_t lastLapTimeMS;
-  uint32_t currentLapTimeMS;
-  uint16_t sector1TimeMS;
-  uint16_t sector2TimeMS;
-  uint16_t deltaToCarInFrontMS;
-  uint16_t deltaToRaceLeaderMS;
-  uint8_t carPosition;
-  uint8_t currentLapNum;
-  uint8_t cornerCuttingWarnings;
-  float lapDistance;
-  uint32_t bestLapTimeMS;
-
 #define MAX_REFERENCE_POINTS 300
   struct ReferencePoint {
     float distance;
@@ -42,160 +50,240 @@ class TelemetryModel {
   uint16_t currentRecordingCount;
   float trackLength;
   bool hasReferenceLap;
+  bool recordingComplete;  // False once a flashback cuts into the lap
 
-  // ============================================
-  // CarSetupData
-  // ============================================
-  uint8_t diffOnThrottle;
+  // The LIVE_LAP_* fields are the last packet's lap time and distance
+  // carried forward to the current frame. The gap between the
+  // extrapolation and each new packet is blended out over
+  // LIVE_LAP_BLEND_MS instead of jumped.
+  uint32_t lapDataArrivalMS;
+  int32_t lapTimeErrorMS;  // Extrapolated minus packet, at arrival
+  float lapDistanceError;
+  void projectLap(uint32_t nowMS, uint32_t& timeMS, float& distance) const;
 
   // ============================================
-  // CarTelemetryData
+  // Input History
   // ============================================
-  uint16_t speed;
-  float throttle;
-  float brake;
-  int8_t gear;
-  uint16_t engineRPM;
-  uint8_t drs;
-  uint8_t revLightsPercent;
-  uint16_t brakesTemp[4];
-  uint8_t tyresSurfaceTemp[4];
-  uint8_t tyresInnerTemp[4];
-  uint16_t engineTemp;
-  float tyresPressure[4];
-  int8_t suggestedGear;
+  // One sample per telemetry packet for the input trace; inputSamples
+  // counts them all, so the newest is at (inputSamples - 1) % size.
+public:
+  struct InputSample {
+    uint8_t throttle;  // 0-100
+    uint8_t brake;     // 0-100
+    int8_t steer;      // -100 (full left) to 100
+  };
+
+private:
+  InputSample inputHistory[INPUT_HISTORY_SAMPLES];
 
   // ============================================
-  // CarStatusData
+  // Track Map
   // ============================================
-  uint8_t frontBrakeBias;
-  float fuelInTank;
-  float fuelRemainingLaps;
-  uint8_t tyresAgeLaps;
-  float enginePowerICE;
-  float enginePowerMGUK;
-  float ersStoreEnergy;
-  uint8_t ersDeployMode;
+  // World X/Z of every car from the motion packet; the player's lap is
+  // recorded into the outline.
+public:
+  struct CarPosition {
+    float x;
+    float z;
+  };
+
+private:
+  TrackMap trackMap;
+  CarPosition carPositions[MAX_CARS];
+  uint8_t playerCarIndex;
 
   // ============================================
-  // CarDamageData
+  // G-Force Trail
   // ============================================
-  float tyresWear[4];
-  uint8_t tyresDamage[4];
-  uint8_t brakesDamage[4];
-  uint8_t frontLeftWingDamage;
-  uint8_t frontRightWingDamage;
-  uint8_t rearWingDamage;
-  uint8_t floorDamage;
-  uint8_t diffuserDamage;
-  uint8_t sidepodDamage;
-  uint8_t drsFault;
-  uint8_t ersFault;
-  uint8_t gearBoxDamage;
-  uint8_t engineDamage;
-  uint8_t engineMGUHWear;
-  uint8_t engineESWear;
-  uint8_t engineCEWear;
-  uint8_t engineICEWear;
-  uint8_t engineMGUKWear;
-  uint8_t engineTCWear;
+  // Averages of GFORCE_DECIMATION motion frames; gForceSamples counts
+  // them all, as inputSamples does for the input history.
+public:
+  struct GForceSample {
+    int16_t lateral;  // Hundredths of a g
+    int16_t longitudinal;
+  };
+
+private:
+  GForceSample gForceHistory[GFORCE_HISTORY_POINTS];
+  float gForceSumLateral;
+  float gForceSumLongitudinal;
+  uint8_t gForceFrames;
+
+  // Names per car index; participantsVersion changes on every rebuild.
+  ParticipantTable participants;
+
+  // Completed laps of every car; lapHistoryVersion changes when the
+  // player's do.
+  LapHistory lapHistory;
+
+  // The player's tyre sets; tyreSetsVersion changes with the table.
+  TyreSetTable tyreSets;
+
+  // Burn per lap and the prediction to the flag, published through the
+  // FUEL_* derived fields. Lap data only marks a sample due; it is taken
+  // at the next Car Status decode.
+  FuelModel fuelModel;
+  bool fuelSamplePending;
+  bool fuelLapPending;  // The pending sample also closes a lap
+  void sampleFuel();
+  void updateFuelPrediction(float lapFraction);
+
+  // Wear trend per corner, due with the fuel and taken at the next Car
+  // Damage decode; tyreDegradationVersion changes when a prediction does.
+  TyreWearModel tyreWear;
+  bool wearSamplePending;
+  void sampleTyreWear();
+
+  // The best plan from the controller's StrategyPlanner;
+  // strategyPlanVersion changes when it does. usedDryCompounds has a bit
+  // per dry compound run this session, for the two-compound rule.
+  StrategyPlanner::Plan strategyPlan;
+  uint8_t usedDryCompounds;
 
   // ============================================
   // Utility
   // ============================================
   uint32_t packetsReceived;
+  DirtyMask dirtyFields;
+
+  // Slow packets are decoded from the cache only when something reads them.
+  const PacketCache* packetCache;
+  uint32_t decodedGeneration[PACKET_ID_COUNT];
+  uint32_t trackGeneration;  // Session generation the track map last read
+
+  void syncTrack();
+
+  template <typename T>
+  void setField(T& field, T value, float, ModelField id) {
+    if (field != value) {
+      field = value;
+      dirtyFields.set(id);
+    }
+  }
+
+  // Floats are compared at display resolution so sensor noise below one
+  // step does not trigger a redraw.
+  void setField(float& field, float value, float resolution, ModelField id) {
+    if (lroundf(field / resolution) != lroundf(value / resolution)) {
+      dirtyFields.set(id);
+    }
+    field = value;
+  }
+
+  template <typename T>
+  void printField(Print& out, ModelField id, T value) const;
+  bool appendField(uint8_t* buffer, size_t size, size_t& used, ModelField id, const void* value, size_t length) const;
 
 public:
   TelemetryModel();
 
   void updateSessionData(const PacketSessionData* packet);
-  void updateLapData(const PacketLapData* packet, uint8_t playerIndex);
+  void updateLapData(const PacketLapData* packet, uint8_t playerIndex, uint32_t nowMS);
   void updateCarSetup(const PacketCarSetupData* packet, uint8_t playerIndex);
   void updateTelemetry(const PacketCarTelemetryData* packet, uint8_t playerIndex);
   void updateCarStatus(const PacketCarStatusData* packet, uint8_t playerIndex);
   void updateCarDamage(const PacketCarDamageData* packet, uint8_t playerIndex);
+  void updateMotion(const PacketMotionData* packet, uint8_t playerIndex);
+  void updateTyreSets(const PacketTyreSetsData* packet, uint8_t playerIndex);
+
+  void updateParticipants(const PacketParticipantsData* packet);
+  void updateSessionHistory(const PacketSessionHistoryData* packet, uint8_t playerIndex);
+
+  // Fills in the planner's inputs from the latest packets. Outside a race,
+  // or before the lap count is known, they have no laps and the planner
+  // publishes no plan.
+  void buildStrategyInputs(StrategyPlanner::Inputs& inputs);
+  void updateStrategy(const StrategyPlanner::Plan& plan);
+
+  // Moves the live lap time, distance and delta on to nowMS. Called once
+  // a frame and on every Lap Data packet.
+  void extrapolateLap(uint32_t nowMS);
+
+  // The game rewound time: laps being recorded now have gaps.
+  void handleFlashback();
+
+  // Decodes the cached copy of packetId if it is newer than the last one
+  // decoded. Callers refresh the groups they are about to read.
+  void attachCache(const PacketCache* cache);
+  void refresh(uint8_t packetId);
 
   // ============================================
-  // Getters - PacketSessionData
+  // Getters - generated from ModelFields.h
   // ============================================
-  uint8_t getWeather() const {
-    return weather;
-  }
-  int8_t getTrackTemperature() const {
-    return trackTemperature;
-  }
-  int8_t getAirTemperature() const {
-    return airTemperature;
-  }
-  uint8_t getSessionType() const {
-    return sessionType;
-  }
-  uint16_t getSessionTimeLeft() const {
-    return sessionTimeLeft;
-  }
-  uint8_t getSafetyCarStatus() const {
-    return safetyCarStatus;
-  }
-  uint8_t getTotalLaps() const {
-    return totalLaps;
-  }
+  MODEL_FIELDS(FIELD_GETTER_X, FIELD_GETTER_X, FIELD_GETTER_C, FIELD_GETTER_D)
 
   // ============================================
-  // Getters - LapData
+  // Getters - Derived
   // ============================================
-  uint32_t getLastLapTimeMS() const {
-    return lastLapTimeMS;
+  float getERSPercent() const {
+    return (ersStoreEnergy / 4000000.0f) * 100.0f;
   }
-  uint32_t getCurrentLapTimeMS() const {
-    return currentLapTimeMS;
+
+  // index counts from 0 up to getInputSamples() - 1; only the last
+  // INPUT_HISTORY_SAMPLES are kept.
+  const InputSample& getInputSample(uint32_t index) const {
+    return inputHistory[index % INPUT_HISTORY_SAMPLES];
   }
-  uint16_t getSector1TimeMS() const {
-    return sector1TimeMS;
+
+  const TrackMap& getTrackMap() const {
+    return trackMap;
   }
-  uint16_t getSector2TimeMS() const {
-    return sector2TimeMS;
+  // (0, 0) for cars not on track.
+  const CarPosition& getCarPosition(uint8_t carIndex) const {
+    return carPositions[carIndex];
   }
-  uint16_t getDeltaToCarInFrontMS() const {
-    return deltaToCarInFrontMS;
+  uint8_t getPlayerCarIndex() const {
+    return playerCarIndex;
   }
-  uint16_t getDeltaToRaceLeaderMS() const {
-    return deltaToRaceLeaderMS;
+
+  const ParticipantTable& getParticipants() const {
+    return participants;
   }
-  uint8_t getCarPosition() const {
-    return carPosition;
+
+  const LapHistory& getLapHistory() const {
+    return lapHistory;
   }
-  uint8_t getCurrentLapNum() const {
-    return currentLapNum;
+
+  const TyreSetTable& getTyreSets() const {
+    return tyreSets;
   }
-  uint8_t getCornerCuttingWarnings() const {
-    return cornerCuttingWarnings;
+
+  const TyreWearModel& getTyreWear() const {
+    return tyreWear;
   }
-  uint32_t getBestLapTimeMS() const {
-    return bestLapTimeMS;
+
+  const StrategyPlanner::Plan& getStrategyPlan() const {
+    return strategyPlan;
   }
 
-  float getLapDistance() const {
-    return lapDistance;
+  // index counts from 0 up to getGForceSamples() - 1; only the last
+  // GFORCE_HISTORY_POINTS are kept.
+  const GForceSample& getGForceSample(uint32_t index) const {
+    return gForceHistory[index % GFORCE_HISTORY_POINTS];
   }
 
-  float getDeltaLive() const {
+private:
+  bool isDeltaLiveAvailable() const {
+    return bestLapTimeMS > 0 && liveLapDistance >= 10.0f;
+  }
+
+  float computeDeltaLive() const {
     if (!hasReferenceLap || bestLapTimeMS == 0 || referencePointCount < 2) {
       return 0.0f;
     }
 
-    if (lapDistance < 10.0f || currentLapTimeMS == 0) {
+    if (liveLapDistance < 10.0f || liveLapTimeMS == 0) {
       return 0.0f;
     }
 
-    uint32_t referenceTimeMS = interpolateReferenceTime(lapDistance);
+    uint32_t referenceTimeMS = interpolateReferenceTime(liveLapDistance);
     if (referenceTimeMS == 0) {
       return 0.0f;
     }
 
-    return ((int32_t)currentLapTimeMS - (int32_t)referenceTimeMS) / 1000.0f;
+    return ((int32_t)liveLapTimeMS - (int32_t)referenceTimeMS) / 1000.0f;
   }
 
-private:
   uint32_t interpolateReferenceTime(float distance) const {
     if (referencePointCount < 2) return 0;
 
@@ -208,154 +296,39 @@ private:
 
     return 0;
   }
-public:
-
-  // ============================================
-  // Getters - CarSetupData
-  // ============================================
-  uint8_t getDiffOnThrottle() const {
-    return diffOnThrottle;
-  }
 
+public:
   // ============================================
-  // Getters - CarTelemetryData
+  // Utility
   // ============================================
-  uint16_t getSpeed() const {
-    return speed;
-  }
-  float getThrottle() const {
-    return throttle;
-  }
-  float getBrake() const {
-    return brake;
-  }
-  int8_t getGear() const {
-    return gear;
-  }
-  uint16_t getEngineRPM() const {
-    return engineRPM;
-  }
-  uint8_t getDRS() const {
-    return drs;
-  }
-  uint8_t getRevLightsPercent() const {
-    return revLightsPercent;
-  }
-  uint16_t getBrakeTemp(uint8_t corner) const {
-    return brakesTemp[corner];
-  }
-  uint8_t getTyreSurfaceTemp(uint8_t corner) const {
-    return tyresSurfaceTemp[corner];
-  }
-  uint8_t getTyreInnerTemp(uint8_t corner) const {
-    return tyresInnerTemp[corner];
-  }
-  uint16_t getEngineTemp() const {
-    return engineTemp;
+  uint32_t getPacketsReceived() const {
+    return packetsReceived;
   }
-  float getTyrePressure(uint8_t corner) const {
-    return tyresPressure[corner];
+  bool hasDirtyFields() const {
+    return dirtyFields.any();
   }
-  int8_t getSuggestedGear() const {
-    return suggestedGear;
+  DirtyMask consumeDirtyFields() {
+    DirtyMask dirty = dirtyFields;
+    dirtyFields.clear();
+    return dirty;
   }
 
-  // ============================================
-  // Getters - CarStatusData
-  // ============================================
-  uint8_t getFrontBrakeBias() const {
-    return frontBrakeBias;
-  }
-  float getFuelInTank() const {
-    return fuelInTank;
-  }
-  float getFuelRemainingLaps() const {
-    return fuelRemainingLaps;
-  }
-  uint8_t getTyresAgeLaps() const {
-    return tyresAgeLaps;
-  }
-  float getEnginePowerICE() const {
-    return enginePowerICE;
-  }
-  float getEnginePowerMGUK() const {
-    return enginePowerMGUK;
-  }
-  uint8_t getERSDeployMode() const {
-    return ersDeployMode;
-  }
-  float getERSPercent() const {
-    return (ersStoreEnergy / 4000000.0f) * 100.0f;
-  }
+  // Any field by id, for the table-driven widgets in View.cpp.
+  float getFieldValue(ModelField id) const;
 
-  // ============================================
-  // Getters - CarDamageData
-  // ============================================
-  float getTyreWear(uint8_t corner) const {
-    return tyresWear[corner];
-  }
-  uint8_t getTyreDamage(uint8_t corner) const {
-    return tyresDamage[corner];
-  }
-  uint8_t getBrakeDamage(uint8_t corner) const {
-    return brakesDamage[corner];
-  }
-  uint8_t getFrontLeftWingDamage() const {
-    return frontLeftWingDamage;
-  }
-  uint8_t getFrontRightWingDamage() const {
-    return frontRightWingDamage;
-  }
-  uint8_t getRearWingDamage() const {
-    return rearWingDamage;
-  }
-  uint8_t getFloorDamage() const {
-    return floorDamage;
-  }
-  uint8_t getDiffuserDamage() const {
-    return diffuserDamage;
-  }
-  uint8_t getSidepodDamage() const {
-    return sidepodDamage;
-  }
-  uint8_t getDRSFault() const {
-    return drsFault;
-  }
-  uint8_t getERSFault() const {
-    return ersFault;
-  }
-  uint8_t getGearBoxDamage() const {
-    return gearBoxDamage;
-  }
-  uint8_t getEngineDamage() const {
-    return engineDamage;
-  }
-  uint8_t getEngineMGUHWear() const {
-    return engineMGUHWear;
-  }
-  uint8_t getEngineESWear() const {
-    return engineESWear;
-  }
-  uint8_t getEngineCEWear() const {
-    return engineCEWear;
-  }
-  uint8_t getEngineICEWear() const {
-    return engineICEWear;
-  }
-  uint8_t getEngineMGUKWear() const {
-    return engineMGUKWear;
-  }
-  uint8_t getEngineTCWear() const {
-    return engineTCWear;
-  }
+  // Writes "name = value units" for every field, for the serial console.
+  void printFields(Print& out) const;
 
-  // ============================================
-  // Utility
-  // ============================================
-  uint32_t getPacketsReceived() const {
-    return packetsReceived;
-  }
-  void formatLapTime(uint32_t timeMS, char* buffer);
+  // Packs the fields selected by mask as [id][raw little-endian value]
+  // records for logging. Returns the bytes written; stops before overflow.
+  size_t serializeFields(uint8_t* buffer, size_t size, const DirtyMask& mask) const;
 };
 
-#endif
\ No newline at end of file
+#undef FIELD_STORAGE_X
+#undef FIELD_STORAGE_C
+#undef FIELD_STORAGE_D
+#undef FIELD_GETTER_X
+#undef FIELD_GETTER_C
+#undef FIELD_GETTER_D
+
+#endif
@@ -0,0 +1,166 @@
+#include "ModelBenchmark.h"
+
+#if ENABLE_MODEL_BENCHMARK
+
+#include "Model.h"
+
+namespace {
+
+const uint16_t BENCHMARK_ITERATIONS = 2000;
+
+// Hand-written reference: the copy-and-compare the model did before the
+// field table existed, kept here only for comparison.
+struct ReferenceFields {
+  uint16_t speed;
+  float throttle;
+  float brake;
+  float steer;
+  int8_t gear;
+  uint16_t engineRPM;
+  uint8_t drs;
+  uint8_t revLightsPercent;
+  uint16_t engineTemp;
+  int8_t suggestedGear;
+  uint16_t brakesTemp[4];
+  uint8_t tyresSurfaceTemp[4];
+  uint8_t tyresInnerTemp[4];
+  float tyresPressure[4];
+
+  float tyresWear[4];
+  uint8_t tyresDamage[4];
+  uint8_t brakesDamage[4];
+  uint8_t damage[16];
+
+  DirtyMask dirty;
+};
+
+template <typename T>
+inline void referenceSet(ReferenceFields& ref, T& field, T value, uint8_t id) {
+  if (field != value) {
+    field = value;
+    ref.dirty.set(id);
+  }
+}
+
+inline void referenceSet(ReferenceFields& ref, float& field, float value, float resolution, uint8_t id) {
+  if (lroundf(field / resolution) != lroundf(value / resolution)) {
+    ref.dirty.set(id);
+  }
+  field = value;
+}
+
+void referenceTelemetry(ReferenceFields& ref, const PacketCarTelemetryData* packet, uint8_t playerIndex) {
+  const CarTelemetryData* data = &packet->m_carTelemetryData[playerIndex];
+
+  referenceSet(ref, ref.speed, data->m_speed, FIELD_SPEED);
+  referenceSet(ref, ref.throttle, data->m_throttle, 0.01f, FIELD_THROTTLE);
+  referenceSet(ref, ref.brake, data->m_brake, 0.01f, FIELD_BRAKE);
+  referenceSet(ref, ref.steer, data->m_steer, 0.01f, FIELD_STEER);
+  referenceSet(ref, ref.gear, data->m_gear, FIELD_GEAR);
+  referenceSet(ref, ref.engineRPM, data->m_engineRPM, FIELD_ENGINE_RPM);
+  referenceSet(ref, ref.drs, data->m_drs, FIELD_DRS);
+  referenceSet(ref, ref.revLightsPercent, data->m_revLightsPercent, FIELD_REV_LIGHTS_PERCENT);
+  referenceSet(ref, ref.engineTemp, data->m_engineTemperature, FIELD_ENGINE_TEMP);
+  referenceSet(ref, ref.suggestedGear, packet->m_suggestedGear, FIELD_SUGGESTED_GEAR);
+
+  for (uint8_t i = 0; i < 4; i++) {
+    referenceSet(ref, ref.brakesTemp[i], data->m_brakesTemperature[i], FIELD_BRAKE_TEMP_RL + i);
+    referenceSet(ref, ref.tyresSurfaceTemp[i], data->m_tyresSurfaceTemperature[i], FIELD_TYRE_SURFACE_TEMP_RL + i);
+    referenceSet(ref, ref.tyresInnerTemp[i], data->m_tyresInnerTemperature[i], FIELD_TYRE_INNER_TEMP_RL + i);
+    referenceSet(ref, ref.tyresPressure[i], data->m_tyresPressure[i], 0.01f, FIELD_TYRE_PRESSURE_RL + i);
+  }
+}
+
+void referenceDamage(ReferenceFields& ref, const PacketCarDamageData* packet, uint8_t playerIndex) {
+  const CarDamageData* data = &packet->m_carDamageData[playerIndex];
+
+  for (uint8_t i = 0; i < 4; i++) {
+    referenceSet(ref, ref.tyresWear[i], data->m_tyresWear[i], 0.1f, FIELD_TYRE_WEAR_RL + i);
+    referenceSet(ref, ref.tyresDamage[i], data->m_tyresDamage[i], FIELD_TYRE_DAMAGE_RL + i);
+    referenceSet(ref, ref.brakesDamage[i], data->m_brakesDamage[i], FIELD_BRAKE_DAMAGE_RL + i);
+  }
+
+  const uint8_t* scalars = &data->m_frontLeftWingDamage;
+  for (uint8_t i = 0; i < 16; i++) {
+    referenceSet(ref, ref.damage[i], scalars[i], FIELD_FRONT_LEFT_WING_DAMAGE + i);
+  }
+}
+
+// Alternates two payloads so every iteration exercises change detection.
+void fillTelemetry(PacketCarTelemetryData& packet, uint16_t seed) {
+  memset(&packet, 0, sizeof(packet));
+  CarTelemetryData& car = packet.m_carTelemetryData[0];
+  car.m_speed = 200 + (seed & 1);
+  car.m_throttle = (seed & 1) ? 0.8f : 0.2f;
+  car.m_engineRPM = 11000 + seed;
+  car.m_gear = 5 + (seed & 1);
+  for (uint8_t i = 0; i < 4; i++) {
+    car.m_brakesTemperature[i] = 500 + seed;
+    car.m_tyresPressure[i] = 22.0f + (seed & 1) * 0.5f;
+  }
+}
+
+void fillDamage(PacketCarDamageData& packet, uint16_t seed) {
+  memset(&packet, 0, sizeof(packet));
+  CarDamageData& car = packet.m_carDamageData[0];
+  for (uint8_t i = 0; i < 4; i++) {
+    car.m_tyresWear[i] = 10.0f + (seed & 1);
+    car.m_tyresDamage[i] = seed & 1;
+  }
+  car.m_frontLeftWingDamage = seed & 1;
+  car.m_engineICEWear = 20 + (seed & 1);
+}
+
+void printResult(Print& out, const char* label, uint32_t tableCycles, uint32_t referenceCycles) {
+  out.print(label);
+  out.print(": table ");
+  out.print(tableCycles / BENCHMARK_ITERATIONS);
+  out.print(" cyc, hand-written ");
+  out.print(referenceCycles / BENCHMARK_ITERATIONS);
+  out.println(" cyc");
+}
+
+}  // namespace
+
+void runModelBenchmark(Print& out) {
+  static TelemetryModel model;
+  static ReferenceFields reference;
+  static PacketCarTelemetryData telemetry[2];
+  static PacketCarDamageData damage[2];
+
+  memset(&reference, 0, sizeof(reference));
+  for (uint8_t i = 0; i < 2; i++) {
+    fillTelemetry(telemetry[i], i);
+    fillDamage(damage[i], i);
+  }
+
+  uint32_t start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+    model.updateTelemetry(&telemetry[i & 1], 0);
+  }
+  uint32_t tableTelemetry = ESP.getCycleCount() - start;
+
+  start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+    referenceTelemetry(reference, &telemetry[i & 1], 0);
+  }
+  uint32_t referenceTelemetryCycles = ESP.getCycleCount() - start;
+
+  start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+    model.updateCarDamage(&damage[i & 1], 0);
+  }
+  uint32_t tableDamage = ESP.getCycleCount() - start;
+
+  start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+    referenceDamage(reference, &damage[i & 1], 0);
+  }
+  uint32_t referenceDamageCycles = ESP.getCycleCount() - start;
+
+  out.println("Model decode benchmark (cycles per packet):");
+  printResult(out, "Car Telemetry", tableTelemetry, referenceTelemetryCycles);
+  printResult(out, "Car Damage", tableDamage, referenceDamageCycles);
+}
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef MODEL_BENCHMARK_H
+#define MODEL_BENCHMARK_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+#if ENABLE_MODEL_BENCHMARK
+// Times the table-generated decode in TelemetryModel against a hand-written
+// copy of the same fields and prints cycles per packet.
+void runModelBenchmark(Print& out);
+#endif
+
+#endif
@@ -0,0 +1,283 @@
+#ifndef MODEL_FIELDS_H
+#define MODEL_FIELDS_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include "Config.h"
+
+// ============================================
+// FIELD TABLE
+// ============================================
+// Single definition of every value the model decodes. Each list is expanded
+// with caller-supplied macros into the ModelField enum, the model storage,
+// the getters, the descriptor table and the straight-line decode code.
+//
+//   X(packet, ID, member, Getter, source, type, resolution, units)
+//       scalar read from the per-car struct
+//   P(packet, ID, member, Getter, source, type, resolution, units)
+//       scalar read from the packet itself, outside the per-car array
+//   C(packet, ID, member, Getter, source, type, resolution, units)
+//       4-wheel array in packet order (RL, RR, FL, FR), one field per wheel
+//   D(ID, member, Getter, type, resolution, units)
+//       derived by the model, not copied from a packet
+//
+// resolution is the display step used for change detection (0 = exact).
+
+#define SESSION_FIELDS(X, P, C) \
+  X(SESSION, WEATHER,              weather,           Weather,           m_weather,               uint8_t,  0, "") \
+  X(SESSION, TRACK_TEMPERATURE,    trackTemperature,  TrackTemperature,  m_trackTemperature,      int8_t,   0, "C") \
+  X(SESSION, AIR_TEMPERATURE,      airTemperature,    AirTemperature,    m_airTemperature,        int8_t,   0, "C") \
+  X(SESSION, SESSION_TYPE,         sessionType,       SessionType,       m_sessionType,           uint8_t,  0, "") \
+  X(SESSION, SESSION_TIME_LEFT,    sessionTimeLeft,   SessionTimeLeft,   m_sessionTimeLeft,       uint16_t, 0, "s") \
+  X(SESSION, SAFETY_CAR_STATUS,    safetyCarStatus,   SafetyCarStatus,   m_safetyCarStatus,       uint8_t,  0, "") \
+  X(SESSION, TOTAL_LAPS,           totalLaps,         TotalLaps,         m_totalLaps,             uint8_t,  0, "laps") \
+  X(SESSION, TRACK_ID,             trackId,           TrackId,           m_trackId,               int8_t,   0, "") \
+  X(SESSION, TRACK_LENGTH,         trackLengthM,      TrackLengthM,      m_trackLength,           uint16_t, 0, "m") \
+  X(SESSION, PIT_WINDOW_IDEAL_LAP, pitWindowIdealLap, PitWindowIdealLap, m_pitStopWindowIdealLap, uint8_t,  0, "")
+
+#define LAP_DATA_FIELDS(X, P, C) \
+  X(LAP_DATA, LAST_LAP_TIME,           lastLapTimeMS,         LastLapTimeMS,         m_lastLapTimeInMS,         uint32_t, 0,    "ms") \
+  X(LAP_DATA, CURRENT_LAP_TIME,        currentLapTimeMS,      CurrentLapTimeMS,      m_currentLapTimeInMS,      uint32_t, 0,    "ms") \
+  X(LAP_DATA, SECTOR1_TIME,            sector1TimeMS,         Sector1TimeMS,         m_sector1TimeInMS,         uint16_t, 0,    "ms") \
+  X(LAP_DATA, SECTOR2_TIME,            sector2TimeMS,         Sector2TimeMS,         m_sector2TimeInMS,         uint16_t, 0,    "ms") \
+  X(LAP_DATA, DELTA_TO_CAR_IN_FRONT,   deltaToCarInFrontMS,   DeltaToCarInFrontMS,   m_deltaToCarInFrontInMS,   uint16_t, 0,    "ms") \
+  X(LAP_DATA, DELTA_TO_RACE_LEADER,    deltaToRaceLeaderMS,   DeltaToRaceLeaderMS,   m_deltaToRaceLeaderInMS,   uint16_t, 0,    "ms") \
+  X(LAP_DATA, CAR_POSITION,            carPosition,           CarPosition,           m_carPosition,             uint8_t,  0,    "") \
+  X(LAP_DATA, CURRENT_LAP_NUM,         currentLapNum,         CurrentLapNum,         m_currentLapNum,           uint8_t,  0,    "") \
+  X(LAP_DATA, CORNER_CUTTING_WARNINGS, cornerCuttingWarnings, CornerCuttingWarnings, m_cornerCuttingWarnings,   uint8_t,  0,    "") \
+  X(LAP_DATA, PIT_STATUS,              pitStatus,             PitStatus,             m_pitStatus,               uint8_t,  0,    "") \
+  X(LAP_DATA, PIT_LANE_TIME,           pitLaneTimeMS,         PitLaneTimeMS,         m_pitLaneTimeInLaneInMS,   uint16_t, 0,    "ms") \
+  X(LAP_DATA, LAP_DISTANCE,            lapDistance,           LapDistance,           m_lapDistance,             float,    1.0f, "m")
+
+#define DERIVED_FIELDS(D) \
+  D(BEST_LAP_TIME,      bestLapTimeMS,          BestLapTimeMS,          uint32_t, 0,      "ms") \
+  D(DELTA_LIVE,         deltaLive,              DeltaLive,              float,    0.001f, "s") \
+  D(LIVE_LAP_TIME,      liveLapTimeMS,          LiveLapTimeMS,          uint32_t, 0,      "ms") \
+  D(LIVE_LAP_DISTANCE,  liveLapDistance,        LiveLapDistance,        float,    0.1f,   "m") \
+  D(INPUT_SAMPLES,      inputSamples,           InputSamples,           uint32_t, 0,      "") \
+  D(MOTION_FRAMES,      motionFrames,           MotionFrames,           uint32_t, 0,      "") \
+  D(TRACK_MAP_VERSION,  trackMapVersion,        TrackMapVersion,        uint16_t, 0,      "") \
+  D(TRACK_MAP_PROGRESS, trackMapProgress,       TrackMapProgress,       uint8_t,  0,      "%") \
+  D(GFORCE_SAMPLES,     gForceSamples,          GForceSamples,          uint32_t, 0,      "") \
+  D(PARTICIPANTS,       participantsVersion,    ParticipantsVersion,    uint16_t, 0,      "") \
+  D(LAP_HISTORY,        lapHistoryVersion,      LapHistoryVersion,      uint16_t, 0,      "") \
+  D(TYRE_SETS,          tyreSetsVersion,        TyreSetsVersion,        uint16_t, 0,      "") \
+  D(FUEL_BURN_PER_LAP,  fuelBurnPerLap,         FuelBurnPerLap,         float,    0.01f,  "kg") \
+  D(FUEL_AT_FINISH,     fuelAtFinish,           FuelAtFinish,           float,    0.1f,   "kg") \
+  D(FUEL_SAVE_PER_LAP,  fuelSavePerLap,         FuelSavePerLap,         float,    0.01f,  "kg") \
+  D(TYRE_DEGRADATION,   tyreDegradationVersion, TyreDegradationVersion, uint16_t, 0,      "") \
+  D(PIT_LOSS,           pitLossMS,              PitLossMS,              uint16_t, 0,      "ms") \
+  D(STRATEGY_PLAN,      strategyPlanVersion,    StrategyPlanVersion,    uint16_t, 0,      "")
+
+#define CAR_SETUPS_FIELDS(X, P, C) \
+  X(CAR_SETUPS, DIFF_ON_THROTTLE, diffOnThrottle, DiffOnThrottle, m_onThrottle, uint8_t, 0, "%")
+
+#define CAR_TELEMETRY_FIELDS(X, P, C) \
+  X(CAR_TELEMETRY, SPEED,              speed,            Speed,            m_speed,                   uint16_t, 0,     "km/h") \
+  X(CAR_TELEMETRY, THROTTLE,           throttle,         Throttle,         m_throttle,                float,    0.01f, "") \
+  X(CAR_TELEMETRY, BRAKE,              brake,            Brake,            m_brake,                   float,    0.01f, "") \
+  X(CAR_TELEMETRY, STEER,              steer,            Steer,            m_steer,                   float,    0.01f, "") \
+  X(CAR_TELEMETRY, GEAR,               gear,             Gear,             m_gear,                    int8_t,   0,     "") \
+  X(CAR_TELEMETRY, ENGINE_RPM,         engineRPM,        EngineRPM,        m_engineRPM,               uint16_t, 0,     "rpm") \
+  X(CAR_TELEMETRY, DRS,                drs,              DRS,              m_drs,                     uint8_t,  0,     "") \
+  X(CAR_TELEMETRY, REV_LIGHTS_PERCENT, revLightsPercent, RevLightsPercent, m_revLightsPercent,       uint8_t,  0,     "%") \
+  X(CAR_TELEMETRY, ENGINE_TEMP,        engineTemp,       EngineTemp,       m_engineTemperature,       uint16_t, 0,     "C") \
+  P(CAR_TELEMETRY, SUGGESTED_GEAR,     suggestedGear,    SuggestedGear,    m_suggestedGear,           int8_t,   0,     "") \
+  C(CAR_TELEMETRY, BRAKE_TEMP,         brakesTemp,       BrakeTemp,        m_brakesTemperature,       uint16_t, 0,     "C") \
+  C(CAR_TELEMETRY, TYRE_SURFACE_TEMP,  tyresSurfaceTemp, TyreSurfaceTemp,  m_tyresSurfaceTemperature, uint8_t,  0,     "C") \
+  C(CAR_TELEMETRY, TYRE_INNER_TEMP,    tyresInnerTemp,   TyreInnerTemp,    m_tyresInnerTemperature,   uint8_t,  0,     "C") \
+  C(CAR_TELEMETRY, TYRE_PRESSURE,      tyresPressure,    TyrePressure,     m_tyresPressure,           float,    0.01f, "psi")
+
+#define MOTION_FIELDS(X, P, C) \
+  X(MOTION, G_FORCE_LATERAL,      gForceLateral,      GForceLateral,      m_gForceLateral,      float, 0.1f, "g") \
+  X(MOTION, G_FORCE_LONGITUDINAL, gForceLongitudinal, GForceLongitudinal, m_gForceLongitudinal, float, 0.1f, "g") \
+  X(MOTION, G_FORCE_VERTICAL,     gForceVertical,     GForceVertical,     m_gForceVertical,     float, 0.1f, "g")
+
+#define CAR_STATUS_FIELDS(X, P, C) \
+  X(CAR_STATUS, FRONT_BRAKE_BIAS,     frontBrakeBias,     FrontBrakeBias,     m_frontBrakeBias,     uint8_t, 0,       "%") \
+  X(CAR_STATUS, FUEL_IN_TANK,         fuelInTank,         FuelInTank,         m_fuelInTank,         float,   0.1f,    "kg") \
+  X(CAR_STATUS, FUEL_REMAINING_LAPS,  fuelRemainingLaps,  FuelRemainingLaps,  m_fuelRemainingLaps,  float,   0.1f,    "laps") \
+  X(CAR_STATUS, ACTUAL_TYRE_COMPOUND, actualTyreCompound, ActualTyreCompound, m_actualTyreCompound, uint8_t, 0,       "") \
+  X(CAR_STATUS, VISUAL_TYRE_COMPOUND, visualTyreCompound, VisualTyreCompound, m_visualTyreCompound, uint8_t, 0,       "") \
+  X(CAR_STATUS, TYRES_AGE_LAPS,       tyresAgeLaps,       TyresAgeLaps,       m_tyresAgeLaps,       uint8_t, 0,       "laps") \
+  X(CAR_STATUS, ENGINE_POWER_ICE,     enginePowerICE,     EnginePowerICE,     m_enginePowerICE,     float,   1.0f,    "W") \
+  X(CAR_STATUS, ENGINE_POWER_MGUK,    enginePowerMGUK,    EnginePowerMGUK,    m_enginePowerMGUK,    float,   1.0f,    "W") \
+  X(CAR_STATUS, ERS_STORE_ENERGY,     ersStoreEnergy,     ERSStoreEnergy,     m_ersStoreEnergy,     float,   4000.0f, "J") \
+  X(CAR_STATUS, ERS_DEPLOY_MODE,      ersDeployMode,      ERSDeployMode,      m_ersDeployMode,      uint8_t, 0,       "")
+
+#define CAR_DAMAGE_FIELDS(X, P, C) \
+  C(CAR_DAMAGE, TYRE_WEAR,               tyresWear,            TyreWear,             m_tyresWear,            float,   0.1f, "%") \
+  C(CAR_DAMAGE, TYRE_DAMAGE,             tyresDamage,          TyreDamage,           m_tyresDamage,          uint8_t, 0,    "%") \
+  C(CAR_DAMAGE, BRAKE_DAMAGE,            brakesDamage,         BrakeDamage,          m_brakesDamage,         uint8_t, 0,    "%") \
+  X(CAR_DAMAGE, FRONT_LEFT_WING_DAMAGE,  frontLeftWingDamage,  FrontLeftWingDamage,  m_frontLeftWingDamage,  uint8_t, 0,    "%") \
+  X(CAR_DAMAGE, FRONT_RIGHT_WING_DAMAGE, frontRightWingDamage, FrontRightWingDamage, m_frontRightWingDamage, uint8_t, 0,    "%") \
+  X(CAR_DAMAGE, REAR_WING_DAMAGE,        rearWingDamage,       RearWingDamage,       m_rearWingDamage,       uint8_t, 0,    "%") \
+  X(CAR_DAMAGE, FLOOR_DAMAGE,            floorDamage,          FloorDamage,          m_floorDamage,          uint8_t, 0,    "%") \
+  X(CAR_DAMAGE, DIFFUSER_DAMAGE,         diffuserDamage,       DiffuserDamage,       m_diffuserDamage,       uint8_t, 0,    "%") \
+  X(CAR_DAMAGE, SIDEPOD_DAMAGE,          sidepodDamage,        SidepodDamage,        m_sidepodDamage,        uint8_t, 0,    "%") \
+  X(CAR_DAMAGE, DRS_FAULT,               drsFault,             DRSFault,             m_drsFault,             uint8_t, 0,    "") \
+  X(CAR_DAMAGE, ERS_FAULT,               ersFault,             ERSFault,             m_ersFault,             uint8_t, 0,    "") \
+  X(CAR_DAMAGE, GEARBOX_DAMAGE,          gearBoxDamage,        GearBoxDamage,        m_gearBoxDamage,        uint8_t, 0,    "%") \
+  X(CAR_DAMAGE, ENGINE_DAMAGE,           engineDamage,         EngineDamage,         m_engineDamage,         uint8_t, 0,    "%") \
+  X(CAR_DAMAGE, ENGINE_MGUH_WEAR,        engineMGUHWear,       EngineMGUHWear,       m_engineMGUHWear,       uint8_t, 0,    "%") \
+  X(CAR_DAMAGE, ENGINE_ES_WEAR,          engineESWear,         EngineESWear,         m_engineESWear,         uint8_t, 0,    "%") \
+  X(CAR_DAMAGE, ENGINE_CE_WEAR,          engineCEWear,         EngineCEWear,         m_engineCEWear,         uint8_t, 0,    "%") \
+  X(CAR_DAMAGE, ENGINE_ICE_WEAR,         engineICEWear,        EngineICEWear,        m_engineICEWear,        uint8_t, 0,    "%") \
+  X(CAR_DAMAGE, ENGINE_MGUK_WEAR,        engineMGUKWear,       EngineMGUKWear,       m_engineMGUKWear,       uint8_t, 0,    "%") \
+  X(CAR_DAMAGE, ENGINE_TC_WEAR,          engineTCWear,         EngineTCWear,         m_engineTCWear,         uint8_t, 0,    "%")
+
+#define MODEL_FIELDS(X, P, C, D) \
+  SESSION_FIELDS(X, P, C) \
+  LAP_DATA_FIELDS(X, P, C) \
+  DERIVED_FIELDS(D) \
+  CAR_SETUPS_FIELDS(X, P, C) \
+  CAR_TELEMETRY_FIELDS(X, P, C) \
+  MOTION_FIELDS(X, P, C) \
+  CAR_STATUS_FIELDS(X, P, C) \
+  CAR_DAMAGE_FIELDS(X, P, C)
+
+// ============================================
+// Packet Layouts
+// ============================================
+// Maps a packet ID to its packet struct and the per-car struct the X/C
+// entries are read from. Session data has no per-car array.
+template <uint8_t Id> struct PacketLayout;
+template <> struct PacketLayout<PACKET_ID_MOTION> {
+  typedef PacketMotionData Packet;
+  typedef CarMotionData Car;
+};
+template <> struct PacketLayout<PACKET_ID_SESSION> {
+  typedef PacketSessionData Packet;
+  typedef PacketSessionData Car;
+};
+template <> struct PacketLayout<PACKET_ID_LAP_DATA> {
+  typedef PacketLapData Packet;
+  typedef LapData Car;
+};
+template <> struct PacketLayout<PACKET_ID_CAR_SETUPS> {
+  typedef PacketCarSetupData Packet;
+  typedef CarSetupData Car;
+};
+template <> struct PacketLayout<PACKET_ID_CAR_TELEMETRY> {
+  typedef PacketCarTelemetryData Packet;
+  typedef CarTelemetryData Car;
+};
+template <> struct PacketLayout<PACKET_ID_CAR_STATUS> {
+  typedef PacketCarStatusData Packet;
+  typedef CarStatusData Car;
+};
+template <> struct PacketLayout<PACKET_ID_CAR_DAMAGE> {
+  typedef PacketCarDamageData Packet;
+  typedef CarDamageData Car;
+};
+
+const uint8_t PACKET_ID_NONE = 255;
+
+// ============================================
+// Field IDs
+// ============================================
+#define FIELD_ENUM_X(pkt, id, member, getter, source, type, res, units) FIELD_##id,
+#define FIELD_ENUM_C(pkt, id, member, getter, source, type, res, units) \
+  FIELD_##id##_RL, FIELD_##id##_RR, FIELD_##id##_FL, FIELD_##id##_FR,
+#define FIELD_ENUM_D(id, member, getter, type, res, units) FIELD_##id,
+
+enum ModelField : uint8_t {
+  MODEL_FIELDS(FIELD_ENUM_X, FIELD_ENUM_X, FIELD_ENUM_C, FIELD_ENUM_D)
+  FIELD_COUNT
+};
+
+#undef FIELD_ENUM_X
+#undef FIELD_ENUM_C
+#undef FIELD_ENUM_D
+
+// ============================================
+// Field Descriptors
+// ============================================
+enum FieldType : uint8_t {
+  FIELD_TYPE_U8,
+  FIELD_TYPE_I8,
+  FIELD_TYPE_U16,
+  FIELD_TYPE_U32,
+  FIELD_TYPE_FLOAT
+};
+
+template <typename T> struct FieldTypeOf;
+template <> struct FieldTypeOf<uint8_t> { static const FieldType value = FIELD_TYPE_U8; };
+template <> struct FieldTypeOf<int8_t> { static const FieldType value = FIELD_TYPE_I8; };
+template <> struct FieldTypeOf<uint16_t> { static const FieldType value = FIELD_TYPE_U16; };
+template <> struct FieldTypeOf<uint32_t> { static const FieldType value = FIELD_TYPE_U32; };
+template <> struct FieldTypeOf<float> { static const FieldType value = FIELD_TYPE_FLOAT; };
+
+struct FieldDescriptor {
+  const char* name;
+  uint8_t packetId;
+  uint16_t offset;  // Byte offset of the source in the per-car struct (P: in the packet)
+  FieldType type;
+  float resolution;
+  const char* units;
+};
+
+#define FIELD_DESC_X(pkt, id, member, getter, source, type, res, units) \
+  { #member, PACKET_ID_##pkt, (uint16_t)offsetof(PacketLayout<PACKET_ID_##pkt>::Car, source), \
+    FieldTypeOf<type>::value, res, units },
+#define FIELD_DESC_P(pkt, id, member, getter, source, type, res, units) \
+  { #member, PACKET_ID_##pkt, (uint16_t)offsetof(PacketLayout<PACKET_ID_##pkt>::Packet, source), \
+    FieldTypeOf<type>::value, res, units },
+#define FIELD_DESC_CORNER(pkt, member, source, type, res, units, corner, index) \
+  { #member "[" corner "]", PACKET_ID_##pkt, \
+    (uint16_t)(offsetof(PacketLayout<PACKET_ID_##pkt>::Car, source) + index * sizeof(type)), \
+    FieldTypeOf<type>::value, res, units },
+#define FIELD_DESC_C(pkt, id, member, getter, source, type, res, units) \
+  FIELD_DESC_CORNER(pkt, member, source, type, res, units, "RL", 0) \
+  FIELD_DESC_CORNER(pkt, member, source, type, res, units, "RR", 1) \
+  FIELD_DESC_CORNER(pkt, member, source, type, res, units, "FL", 2) \
+  FIELD_DESC_CORNER(pkt, member, source, type, res, units, "FR", 3)
+#define FIELD_DESC_D(id, member, getter, type, res, units) \
+  { #member, PACKET_ID_NONE, 0, FieldTypeOf<type>::value, res, units },
+
+constexpr FieldDescriptor FIELD_DESCRIPTORS[] = {
+  MODEL_FIELDS(FIELD_DESC_X, FIELD_DESC_P, FIELD_DESC_C, FIELD_DESC_D)
+};
+
+#undef FIELD_DESC_X
+#undef FIELD_DESC_P
+#undef FIELD_DESC_CORNER
+#undef FIELD_DESC_C
+#undef FIELD_DESC_D
+
+static_assert(sizeof(FIELD_DESCRIPTORS) / sizeof(FIELD_DESCRIPTORS[0]) == FIELD_COUNT,
+              "descriptor table out of sync with ModelField");
+static_assert(FIELD_DESCRIPTORS[FIELD_TYRE_WEAR_FL].offset == offsetof(CarDamageData, m_tyresWear) + 2 * sizeof(float),
+              "corner descriptors must follow packet array order");
+
+// ============================================
+// Dirty Mask
+// ============================================
+// One bit per ModelField, set by the model on change and consumed by the view.
+struct DirtyMask {
+  static const uint8_t WORDS = (FIELD_COUNT + 31) / 32;
+  uint32_t words[WORDS];
+
+  void clear() {
+    for (uint8_t i = 0; i < WORDS; i++) words[i] = 0;
+  }
+  void setAll() {
+    for (uint8_t i = 0; i < WORDS; i++) words[i] = 0xFFFFFFFFUL;
+  }
+  void set(uint8_t field) {
+    words[field >> 5] |= (1UL << (field & 31));
+  }
+  bool test(uint8_t field) const {
+    return (words[field >> 5] & (1UL << (field & 31))) != 0;
+  }
+  void merge(const DirtyMask& other) {
+    for (uint8_t i = 0; i < WORDS; i++) words[i] |= other.words[i];
+  }
+  bool any() const {
+    uint32_t bits = 0;
+    for (uint8_t i = 0; i < WORDS; i++) bits |= words[i];
+    return bits != 0;
+  }
+};
+
+#endif
@@ -0,0 +1,43 @@
+#include "PacketCache.h"
+
+PacketCache::PacketCache() {
+  for (uint8_t i = 0; i < PACKET_ID_COUNT; i++) {
+    slots[i].data = NULL;
+    slots[i].capacity = 0;
+    slots[i].generation = 0;
+  }
+
+  attach(PACKET_ID_SESSION, sessionBuffer, sizeof(sessionBuffer));
+  attach(PACKET_ID_CAR_SETUPS, carSetupsBuffer, sizeof(carSetupsBuffer));
+  attach(PACKET_ID_CAR_STATUS, carStatusBuffer, sizeof(carStatusBuffer));
+  attach(PACKET_ID_CAR_DAMAGE, carDamageBuffer, sizeof(carDamageBuffer));
+  attach(PACKET_ID_TYRE_SETS, tyreSetsBuffer, sizeof(tyreSetsBuffer));
+}
+
+void PacketCache::attach(uint8_t packetId, uint8_t* buffer, uint16_t capacity) {
+  slots[packetId].data = buffer;
+  slots[packetId].capacity = capacity;
+}
+
+bool PacketCache::store(const uint8_t* buffer, size_t size) {
+  if (size < sizeof(PacketHeader)) {
+    return false;
+  }
+
+  uint8_t packetId = ((const PacketHeader*)buffer)->m_packetId;
+  if (!isCached(packetId)) {
+    return false;
+  }
+
+  Slot& slot = slots[packetId];
+  if (size < slot.capacity) {
+    return false;
+  }
+
+  memcpy(slot.data, buffer, slot.capacity);
+  slot.generation++;
+  if (slot.generation == 0) {
+    slot.generation = 1;
+  }
+  return true;
+}
@@ -0,0 +1,48 @@
+#ifndef PACKET_CACHE_H
+#define PACKET_CACHE_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// ============================================
+// Latest-Packet Cache
+// ============================================
+// Holds the most recent raw copy of each slow packet type. Every store
+// bumps that packet's generation, so readers can tell whether they have
+// already decoded the current copy. Generation 0 means nothing stored.
+class PacketCache {
+  struct Slot {
+    uint8_t* data;
+    uint16_t capacity;
+    uint32_t generation;
+  };
+
+  Slot slots[PACKET_ID_COUNT];
+
+  uint8_t sessionBuffer[sizeof(PacketSessionData)];
+  uint8_t carSetupsBuffer[sizeof(PacketCarSetupData)];
+  uint8_t carStatusBuffer[sizeof(PacketCarStatusData)];
+  uint8_t carDamageBuffer[sizeof(PacketCarDamageData)];
+  uint8_t tyreSetsBuffer[sizeof(PacketTyreSetsData)];
+
+  void attach(uint8_t packetId, uint8_t* buffer, uint16_t capacity);
+
+public:
+  PacketCache();
+
+  bool isCached(uint8_t packetId) const {
+    return packetId < PACKET_ID_COUNT && slots[packetId].data != NULL;
+  }
+
+  // Copies the packet in; short packets are rejected.
+  bool store(const uint8_t* buffer, size_t size);
+
+  const uint8_t* get(uint8_t packetId) const {
+    return isCached(packetId) && slots[packetId].generation != 0 ? slots[packetId].data : NULL;
+  }
+  uint32_t getGeneration(uint8_t packetId) const {
+    return isCached(packetId) ? slots[packetId].generation : 0;
+  }
+};
+
+#endif
@@ -0,0 +1,92 @@
+#include "Participants.h"
+#include "Format.h"
+
+ParticipantTable::ParticipantTable() {
+  clear();
+}
+
+void ParticipantTable::clear() {
+  pool[0] = '\0';
+  poolUsed = 1;
+  count = 0;
+  sessionUID = 0;
+}
+
+bool ParticipantTable::update(const PacketParticipantsData* packet) {
+  uint8_t active = packet->m_numActiveCars < MAX_CARS ? packet->m_numActiveCars : MAX_CARS;
+  if (active == count && packet->m_header.m_sessionUID == sessionUID) return false;
+
+  clear();
+  sessionUID = packet->m_header.m_sessionUID;
+  for (uint8_t i = 0; i < active; i++) {
+    const ParticipantData& data = packet->m_participants[i];
+    Entry& entry = entries[i];
+
+    char name[PARTICIPANT_NAME_LENGTH + 1];
+    sanitize(data.m_name, name);
+    entry.nameOffset = intern(name);
+    makeCode(name, data.m_raceNumber, entry.code);
+    entry.teamId = data.m_teamId;
+    entry.raceNumber = data.m_raceNumber;
+  }
+  count = active;
+  return true;
+}
+
+// ============================================
+// STRINGS
+// ============================================
+
+// Keeps printable ASCII; each multi-byte UTF-8 character becomes one '?',
+// which the panel font can draw.
+uint8_t ParticipantTable::sanitize(const char* name, char* out) {
+  uint8_t length = 0;
+  for (uint8_t i = 0; i < sizeof(ParticipantData::m_name) && name[i] != '\0'; i++) {
+    uint8_t c = (uint8_t)name[i];
+    if (length == PARTICIPANT_NAME_LENGTH) break;
+    if (c >= 0x80 && c < 0xC0) continue;  // UTF-8 continuation byte
+    out[length++] = c >= 0xC0 ? '?' : (c < ' ' ? ' ' : (char)c);
+  }
+  out[length] = '\0';
+  return length;
+}
+
+// Returns the offset of name in the pool, adding it if it is not there.
+// A full pool gives the empty name.
+uint16_t ParticipantTable::intern(const char* name) {
+  if (name[0] == '\0') return 0;
+
+  for (uint16_t offset = 1; offset < poolUsed; offset += strlen(&pool[offset]) + 1) {
+    if (strcmp(&pool[offset], name) == 0) return offset;
+  }
+
+  uint16_t length = strlen(name) + 1;
+  if (poolUsed + length > PARTICIPANT_POOL_BYTES) return 0;
+
+  uint16_t offset = poolUsed;
+  memcpy(&pool[offset], name, length);
+  poolUsed += length;
+  return offset;
+}
+
+// First three letters of the last word, upper-cased: "Max Verstappen"
+// gives "VER". Names with fewer letters fall back to the race number.
+void ParticipantTable::makeCode(const char* name, uint8_t raceNumber, char* code) {
+  const char* word = name;
+  for (const char* p = name; *p; p++) {
+    if (*p == ' ' && p[1] != '\0' && p[1] != ' ') word = p + 1;
+  }
+
+  uint8_t length = 0;
+  for (const char* p = word; *p && length < 3; p++) {
+    char c = *p >= 'a' && *p <= 'z' ? *p - 'a' + 'A' : *p;
+    if (c >= 'A' && c <= 'Z') code[length++] = c;
+  }
+  if (length == 3) {
+    code[3] = '\0';
+    return;
+  }
+
+  code[0] = '#';
+  formatFixed(code + 1, raceNumber % 100, 0);
+}
@@ -0,0 +1,62 @@
+#ifndef PARTICIPANTS_H
+#define PARTICIPANTS_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// ============================================
+// Participant Table
+// ============================================
+// Names, team IDs and race numbers per car index, decoded from the
+// participants packet. The packet repeats every few seconds, but the
+// table is rebuilt only when the session UID or the number of active
+// cars changes; otherwise update() is a two-field compare.
+//
+// Names are stored once each in a fixed pool (identical names share an
+// entry), reduced to printable ASCII and cut to PARTICIPANT_NAME_LENGTH.
+// Each car also gets a three-letter code from its surname, so screens can
+// print names with no per-frame string work.
+class ParticipantTable {
+  struct Entry {
+    uint16_t nameOffset;  // Into pool; 0 is the empty name
+    char code[4];
+    uint8_t teamId;
+    uint8_t raceNumber;
+  };
+
+  Entry entries[MAX_CARS];
+  char pool[PARTICIPANT_POOL_BYTES];
+  uint16_t poolUsed;
+  uint8_t count;
+  uint64_t sessionUID;
+
+  uint16_t intern(const char* name);
+  static uint8_t sanitize(const char* name, char* out);
+  static void makeCode(const char* name, uint8_t raceNumber, char* code);
+
+public:
+  ParticipantTable();
+
+  // Returns true if the table was rebuilt.
+  bool update(const PacketParticipantsData* packet);
+  void clear();
+
+  uint8_t getCount() const {
+    return count;
+  }
+  // "" for cars without a participant entry.
+  const char* getName(uint8_t car) const {
+    return car < count ? &pool[entries[car].nameOffset] : "";
+  }
+  const char* getCode(uint8_t car) const {
+    return car < count ? entries[car].code : "";
+  }
+  uint8_t getTeamId(uint8_t car) const {
+    return car < count ? entries[car].teamId : 255;
+  }
+  uint8_t getRaceNumber(uint8_t car) const {
+    return car < count ? entries[car].raceNumber : 0;
+  }
+};
+
+#endif
@@ -0,0 +1,86 @@
+#include "SimDisplayBus.h"
+
+SimDisplayBus::SimDisplayBus(ClockNanos c, uint32_t hz, uint32_t overhead, uint8_t count, uint16_t scale) {
+  clock = c;
+  spiHz = hz;
+  transactionNanos = overhead;
+  bufferCount = (count >= 2) ? 2 : 1;
+  cpuScale = scale;
+
+  bufferFreeAt[0] = 0;
+  bufferFreeAt[1] = 0;
+  nextBuffer = 0;
+
+  lastReal = clock();
+  simNow = 0;
+  busFreeAt = 0;
+  wireNanos = 0;
+}
+
+uint64_t SimDisplayBus::now() {
+  uint64_t real = clock();
+  simNow += (real - lastReal) * cpuScale;
+  lastReal = real;
+  return simNow;
+}
+
+void SimDisplayBus::waitUntil(uint64_t t) {
+  uint64_t current = now();
+  if (t > current) {
+    stats.waitMicros += (uint32_t)((t - current) / 1000);
+    simNow = t;
+  }
+}
+
+// Starts once both the CPU has queued it and the previous transfer ended.
+void SimDisplayBus::transmit(uint32_t bytes) {
+  uint64_t start = now();
+  if (busFreeAt > start) start = busFreeAt;
+
+  uint64_t duration = transactionNanos + (uint64_t)bytes * 8 * 1000000000ULL / spiHz;
+  busFreeAt = start + duration;
+  wireNanos += duration;
+}
+
+void SimDisplayBus::beginTransaction() {
+  stats.transactions++;
+}
+
+void SimDisplayBus::endTransaction() {
+  waitUntil(busFreeAt);
+}
+
+void SimDisplayBus::beginRegion(int16_t, int16_t, int16_t, int16_t) {
+  // Window commands are sent blocking after the queue drains, as on the
+  // device.
+  waitUntil(busFreeAt);
+  transmit(DISPLAY_ADDR_WINDOW_BYTES);
+  waitUntil(busFreeAt);
+  stats.regions++;
+}
+
+uint16_t* SimDisplayBus::acquireSpan() {
+  waitUntil(bufferFreeAt[nextBuffer]);
+  return buffers[nextBuffer];
+}
+
+void SimDisplayBus::queueSpan(uint16_t count) {
+  transmit((uint32_t)count * 2);
+  bufferFreeAt[nextBuffer] = busFreeAt;
+  nextBuffer = (nextBuffer + 1) % bufferCount;
+
+  stats.spans++;
+  stats.bytes += (uint32_t)count * 2;
+}
+
+void SimDisplayBus::endRegion() {}
+
+void SimDisplayBus::sendCommand(uint8_t, const uint8_t*, uint8_t length) {
+  waitUntil(busFreeAt);
+  transmit(1 + length);
+  waitUntil(busFreeAt);
+}
+
+uint64_t SimDisplayBus::getElapsedNanos() {
+  return now();
+}
@@ -0,0 +1,56 @@
+#ifndef SIM_DISPLAY_BUS_H
+#define SIM_DISPLAY_BUS_H
+
+#include "DisplayBus.h"
+
+// ============================================
+// Simulated Transport
+// ============================================
+// Host stand-in for benchmarking the transport off-device. Wire time is
+// modelled from the SPI clock and a fixed per-transaction cost; CPU time
+// between calls is measured with the supplied clock and multiplied by
+// cpuScale to approximate the slower target. Waiting for a busy buffer
+// advances the simulated clock instead of sleeping.
+class SimDisplayBus : public DisplayBus {
+public:
+  typedef uint64_t (*ClockNanos)();
+
+  SimDisplayBus(ClockNanos clock, uint32_t spiHz, uint32_t transactionNanos, uint8_t bufferCount, uint16_t cpuScale);
+
+  void beginTransaction() override;
+  void endTransaction() override;
+  void beginRegion(int16_t x, int16_t y, int16_t w, int16_t h) override;
+  uint16_t* acquireSpan() override;
+  void queueSpan(uint16_t count) override;
+  void endRegion() override;
+  void sendCommand(uint8_t command, const uint8_t* data, uint8_t length) override;
+
+  // Simulated time since construction, and how much of it the bus was
+  // transmitting.
+  uint64_t getElapsedNanos();
+  uint64_t getWireNanos() const {
+    return wireNanos;
+  }
+
+private:
+  ClockNanos clock;
+  uint32_t spiHz;
+  uint32_t transactionNanos;
+  uint8_t bufferCount;
+  uint16_t cpuScale;
+
+  uint16_t buffers[2][DISPLAY_BUS_SPAN_PIXELS];
+  uint64_t bufferFreeAt[2];
+  uint8_t nextBuffer;
+
+  uint64_t lastReal;
+  uint64_t simNow;
+  uint64_t busFreeAt;
+  uint64_t wireNanos;
+
+  uint64_t now();
+  void waitUntil(uint64_t t);
+  void transmit(uint32_t bytes);
+};
+
+#endif
@@ -0,0 +1,95 @@
+#include "Sprite.h"
+#include "DisplayBus.h"
+
+Sprite::Sprite()
+  : Adafruit_GFX(SCREEN_WIDTH, SCREEN_HEIGHT) {
+  paletteSize = 0;
+  paletteOverflow = false;
+  originX = 0;
+  originY = 0;
+  windowWidth = 0;
+  windowHeight = 0;
+  stride = 0;
+  pixels = NULL;
+  directBytes = 0;
+  directWindows = 0;
+}
+
+void Sprite::begin(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t* buffer, uint16_t background) {
+  pixels = buffer;
+  originX = x;
+  originY = y;
+  windowWidth = w;
+  windowHeight = h;
+  stride = (w + 1) / 2;
+
+  // Index 0 is the background, so clearing is a plain memset.
+  palette[0] = background;
+  paletteSize = 1;
+  paletteOverflow = false;
+  memset(pixels, 0, (uint32_t)stride * h);
+
+  directBytes += DISPLAY_ADDR_WINDOW_BYTES + (uint32_t)w * h * 2;
+  directWindows++;
+}
+
+uint8_t Sprite::colorIndex(uint16_t color) {
+  for (uint8_t i = 0; i < paletteSize; i++) {
+    if (palette[i] == color) return i;
+  }
+  if (paletteSize < SPRITE_PALETTE_SIZE) {
+    palette[paletteSize] = color;
+    return paletteSize++;
+  }
+  paletteOverflow = true;
+  return SPRITE_PALETTE_SIZE - 1;
+}
+
+void Sprite::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  x -= originX;
+  y -= originY;
+  if (x < 0 || y < 0 || x >= windowWidth || y >= windowHeight) return;
+
+  uint8_t index = colorIndex(color);
+  uint8_t* cell = &pixels[y * stride + (x >> 1)];
+  if (x & 1) {
+    *cell = (*cell & 0xF0) | index;
+  } else {
+    *cell = (*cell & 0x0F) | (index << 4);
+  }
+
+  directBytes += DISPLAY_ADDR_WINDOW_BYTES + 2;
+  directWindows++;
+}
+
+void Sprite::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  int16_t x0 = max((int16_t)(x - originX), (int16_t)0);
+  int16_t y0 = max((int16_t)(y - originY), (int16_t)0);
+  int16_t x1 = min((int16_t)(x - originX + w), windowWidth);
+  int16_t y1 = min((int16_t)(y - originY + h), windowHeight);
+  if (x0 >= x1 || y0 >= y1) return;
+
+  uint8_t index = colorIndex(color);
+  for (int16_t row = y0; row < y1; row++) {
+    uint8_t* rowStart = &pixels[row * stride];
+    for (int16_t col = x0; col < x1; col++) {
+      uint8_t* cell = &rowStart[col >> 1];
+      if (col & 1) {
+        *cell = (*cell & 0xF0) | index;
+      } else {
+        *cell = (*cell & 0x0F) | (index << 4);
+      }
+    }
+  }
+
+  directBytes += DISPLAY_ADDR_WINDOW_BYTES + (uint32_t)(x1 - x0) * (y1 - y0) * 2;
+  directWindows++;
+}
+
+void Sprite::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+void Sprite::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
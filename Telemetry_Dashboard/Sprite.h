@@ -0,0 +1,72 @@
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include <Adafruit_GFX.h>
+#include "Config.h"
+
+// ============================================
+// Off-screen Widget Sprite
+// ============================================
+// A 4bpp palette canvas that takes screen coordinates. begin() opens a
+// window over one widget's region in a caller-supplied buffer, and the
+// widget draws into it exactly as it would onto the panel. The
+// Compositor owns the buffers and sends the finished pixels, so the panel
+// never shows the cleared background and updates do not flicker.
+//
+// At most SPRITE_PALETTE_SIZE distinct colours per widget; extra colours
+// reuse the last palette entry and set paletteOverflow.
+class Sprite : public Adafruit_GFX {
+  uint8_t* pixels;
+  uint16_t palette[SPRITE_PALETTE_SIZE];
+  uint8_t paletteSize;
+  bool paletteOverflow;
+
+  int16_t originX, originY;
+  int16_t windowWidth, windowHeight;
+  uint16_t stride;
+
+  // What the same primitives would have cost drawn straight to the
+  // ILI9341: one address window and its pixel data each.
+  uint32_t directBytes;
+  uint32_t directWindows;
+
+  uint8_t colorIndex(uint16_t color);
+
+public:
+  Sprite();
+
+  static uint32_t bufferSize(int16_t w, int16_t h) {
+    return (uint32_t)((w + 1) / 2) * h;
+  }
+
+  // buffer must hold bufferSize(w, h) bytes.
+  void begin(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t* buffer, uint16_t background = COLOR_BLACK);
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+
+  const uint16_t* getPalette() const {
+    return palette;
+  }
+  uint8_t getPaletteSize() const {
+    return paletteSize;
+  }
+  bool hasPaletteOverflow() const {
+    return paletteOverflow;
+  }
+
+  uint32_t getDirectBytes() const {
+    return directBytes;
+  }
+  uint32_t getDirectWindows() const {
+    return directWindows;
+  }
+  void resetStats() {
+    directBytes = 0;
+    directWindows = 0;
+  }
+};
+
+#endif
@@ -0,0 +1,216 @@
+#include "Strategy.h"
+
+StrategyPlanner::StrategyPlanner() {
+#if defined(ESP32) && ENABLE_STRATEGY_TASK
+  portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+  lock = unlocked;
+#endif
+  memset(&pendingInputs, 0, sizeof(pendingInputs));
+  memset(&published, 0, sizeof(published));
+  inputsPending = false;
+  publishPending = false;
+  searching = false;
+}
+
+bool StrategyPlanner::begin() {
+#if defined(ESP32) && ENABLE_STRATEGY_TASK
+  return xTaskCreatePinnedToCore(taskMain, "strategy", STRATEGY_TASK_STACK, this, STRATEGY_TASK_PRIORITY, NULL,
+                                 STRATEGY_TASK_CORE) == pdPASS;
+#else
+  return false;
+#endif
+}
+
+#if defined(ESP32) && ENABLE_STRATEGY_TASK
+void StrategyPlanner::taskMain(void* arg) {
+  StrategyPlanner* planner = (StrategyPlanner*)arg;
+  for (;;) {
+    // At least a tick between slices, so core 0's idle task still runs
+    // and feeds the watchdog.
+    vTaskDelay(planner->runSlice() ? 1 : pdMS_TO_TICKS(STRATEGY_IDLE_MS));
+  }
+}
+#endif
+
+void StrategyPlanner::lockShared() {
+#if defined(ESP32) && ENABLE_STRATEGY_TASK
+  portENTER_CRITICAL(&lock);
+#endif
+}
+
+void StrategyPlanner::unlockShared() {
+#if defined(ESP32) && ENABLE_STRATEGY_TASK
+  portEXIT_CRITICAL(&lock);
+#endif
+}
+
+void StrategyPlanner::submit(const Inputs& next) {
+  lockShared();
+  pendingInputs = next;
+  inputsPending = true;
+  unlockShared();
+}
+
+bool StrategyPlanner::poll(Plan& plan) {
+  lockShared();
+  bool ready = publishPending;
+  if (ready) plan = published;
+  publishPending = false;
+  unlockShared();
+  return ready;
+}
+
+bool StrategyPlanner::runSlice() {
+  lockShared();
+  bool fresh = inputsPending;
+  if (fresh) inputs = pendingInputs;
+  inputsPending = false;
+  unlockShared();
+
+  if (fresh) startSearch();
+  if (!searching) return false;
+
+  for (uint16_t i = 0; i < STRATEGY_SLICE_PLANS && searching; i++) {
+    score();
+    advance();
+  }
+  if (!searching) publish();
+  return searching;
+}
+
+// ============================================
+// SEARCH
+// ============================================
+
+void StrategyPlanner::startSearch() {
+  for (uint8_t i = 0; i < 3; i++) {
+    best[i].valid = false;
+    bestCost[i] = 0.0f;
+  }
+
+  memset(&cursor, 0, sizeof(cursor));
+  option[0] = 0;
+  option[1] = 0;
+
+  searching = inputs.totalLaps > 0 && inputs.currentLap > 0 && inputs.currentLap <= inputs.totalLaps;
+  if (!searching) publish();
+}
+
+// Plans in order: stay out; each in-lap by each option; each pair of
+// in-laps by each pair of options. Stops come at the end of a lap from
+// the current one to the one before the last.
+void StrategyPlanner::advance() {
+  uint8_t first = inputs.currentLap;
+  uint8_t last = inputs.totalLaps - 1;
+  uint8_t options = inputs.optionCount;
+
+  switch (cursor.stops) {
+    case 0:
+      if (options == 0 || last < first) {
+        searching = false;
+        return;
+      }
+      cursor.stops = 1;
+      cursor.pitLap[0] = first;
+      return;
+
+    case 1:
+      if (++option[0] < options) return;
+      option[0] = 0;
+      if (++cursor.pitLap[0] <= last) return;
+      if (last < first + 1) {
+        searching = false;
+        return;
+      }
+      cursor.stops = 2;
+      cursor.pitLap[0] = first;
+      cursor.pitLap[1] = first + 1;
+      return;
+
+    default:
+      if (++option[1] < options) return;
+      option[1] = 0;
+      if (++option[0] < options) return;
+      option[0] = 0;
+      if (++cursor.pitLap[1] <= last) return;
+      if (++cursor.pitLap[0] < last) {
+        cursor.pitLap[1] = cursor.pitLap[0] + 1;
+        return;
+      }
+      searching = false;
+      return;
+  }
+}
+
+// Wear at the start of lap k of the stint is wear + k * wearRate; the
+// sums over the stint are closed form.
+float StrategyPlanner::stintCost(uint8_t laps, float wear, float wearRate, int16_t deltaMS) const {
+  float wearSum = laps * wear + wearRate * laps * (laps - 1) / 2.0f;
+
+  float pastCliff = 0.0f;
+  if (wear >= TYRE_WEAR_CLIFF) {
+    pastCliff = laps;
+  } else if (wearRate > 0.0f) {
+    float firstLap = ceilf((TYRE_WEAR_CLIFF - wear) / wearRate);
+    if (firstLap < laps) pastCliff = laps - firstLap;
+  }
+
+  return laps * (float)deltaMS + STRATEGY_WEAR_COST_MS * wearSum + STRATEGY_CLIFF_COST_MS * pastCliff;
+}
+
+void StrategyPlanner::score() {
+  uint8_t stops = cursor.stops;
+  uint8_t lap = inputs.currentLap;
+  bool otherCompound = false;
+
+  float cost = 0.0f;
+  if (stops == 0) {
+    cost = stintCost(inputs.totalLaps - lap + 1, inputs.wear, inputs.wearRate, 0);
+  } else {
+    cost = stintCost(cursor.pitLap[0] - lap + 1, inputs.wear, inputs.wearRate, 0);
+    if (stops == 2 && option[0] == option[1] && inputs.options[option[0]].sets < 2) return;
+
+    for (uint8_t i = 0; i < stops; i++) {
+      const Option& fitted = inputs.options[option[i]];
+      uint8_t end = i + 1 < stops ? cursor.pitLap[i + 1] : inputs.totalLaps;
+      cost += inputs.pitLossMS + stintCost(end - cursor.pitLap[i], fitted.wear, fitted.wearRate, fitted.deltaMS);
+      cursor.compound[i] = fitted.compound;
+      if (fitted.compound != inputs.compound && fitted.compound >= 16 && fitted.compound <= 18) otherCompound = true;
+    }
+  }
+  if (inputs.needsOtherCompound && !otherCompound) return;
+
+  if (!best[stops].valid || cost < bestCost[stops]) {
+    best[stops] = cursor;
+    best[stops].valid = true;
+    bestCost[stops] = cost;
+  }
+}
+
+void StrategyPlanner::publish() {
+  int8_t winner = -1;
+  for (uint8_t i = 0; i < 3; i++) {
+    if (best[i].valid && (winner < 0 || bestCost[i] < bestCost[winner])) winner = i;
+  }
+
+  Plan plan;
+  memset(&plan, 0, sizeof(plan));
+  if (winner >= 0) {
+    plan = best[winner];
+    float cost = bestCost[winner];
+    uint8_t laps = inputs.totalLaps - inputs.currentLap + 1;
+    plan.raceTimeMS = inputs.paceMS > 0 ? (uint32_t)lroundf(inputs.paceMS * (float)laps + cost) : 0;
+
+    float runnerUp = -1.0f;
+    for (uint8_t i = 0; i < 3; i++) {
+      if (i == winner || !best[i].valid) continue;
+      if (runnerUp < 0.0f || bestCost[i] < runnerUp) runnerUp = bestCost[i];
+    }
+    plan.marginMS = runnerUp >= 0.0f ? (uint32_t)lroundf(runnerUp - cost) : 0;
+  }
+
+  lockShared();
+  published = plan;
+  publishPending = true;
+  unlockShared();
+}
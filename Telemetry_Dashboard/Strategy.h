@@ -0,0 +1,106 @@
+#ifndef STRATEGY_H
+#define STRATEGY_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// ============================================
+// Pit Strategy Planner
+// ============================================
+// Scores every plan for the rest of the race with no stop, one stop or
+// two: the in-lap of each stop and the compound fitted there. A stint of
+// n laps costs
+//
+//   n * compound delta + STRATEGY_WEAR_COST_MS * (wear summed over the laps)
+//     + STRATEGY_CLIFF_COST_MS * (laps run past TYRE_WEAR_CLIFF)
+//
+// with wear growing linearly from the set's starting wear, which is
+// closed form, so a plan costs the same however long the race. Each
+// stop adds the pit loss. The base pace is the same for every plan and
+// only goes into the predicted race time.
+//
+// The search is a cursor over the plan space that runSlice() advances by
+// STRATEGY_SLICE_PLANS at a time; the whole space for a 70-lap race is
+// about 25,000 plans. submit() and poll() are the only calls that touch
+// state shared with runSlice(), and copy under a spinlock, so on ESP32
+// runSlice() can run on its own task while the loop goes on.
+class StrategyPlanner {
+public:
+  // A compound that can be fitted at a stop: its freshest set.
+  struct Option {
+    uint8_t compound;  // Visual
+    uint8_t sets;      // Available sets of the compound
+    int16_t deltaMS;   // Lap delta against the fitted set
+    float wear;        // % on the freshest set
+    float wearRate;    // % per lap
+  };
+
+  struct Inputs {
+    uint8_t currentLap;
+    uint8_t totalLaps;
+    uint32_t paceMS;        // Median clean lap; 0 if none yet
+    uint16_t pitLossMS;
+    uint8_t compound;       // Fitted, visual
+    float wear;             // Worst corner, %
+    float wearRate;         // Worst corner, % per lap
+    bool needsOtherCompound;  // Race rules: a second dry compound is still owed
+    uint8_t optionCount;
+    Option options[STRATEGY_MAX_OPTIONS];
+  };
+
+  struct Plan {
+    uint8_t stops;        // 0 to 2
+    uint8_t pitLap[2];    // In-laps
+    uint8_t compound[2];  // Visual
+    bool valid;           // False until a search has finished with a legal plan
+    uint32_t raceTimeMS;  // From the start of the current lap to the flag
+    uint32_t marginMS;    // Ahead of the best plan with a different stop count; 0 if none
+  };
+
+private:
+  // Shared between submit()/poll() and runSlice().
+  Inputs pendingInputs;
+  bool inputsPending;
+  Plan published;
+  bool publishPending;
+
+  // Owned by runSlice().
+  Inputs inputs;
+  bool searching;
+  Plan cursor;  // Next plan to score
+  uint8_t option[2];  // Option indices of the cursor's compounds
+  Plan best[3];       // Per stop count
+  float bestCost[3];
+
+#if defined(ESP32) && ENABLE_STRATEGY_TASK
+  portMUX_TYPE lock;
+  static void taskMain(void* arg);
+#endif
+
+  void lockShared();
+  void unlockShared();
+
+  void startSearch();
+  void advance();
+  void score();
+  void publish();
+  float stintCost(uint8_t laps, float wear, float wearRate, int16_t deltaMS) const;
+
+public:
+  StrategyPlanner();
+
+  // Starts the planner task where there is one. Returns true if slices
+  // run on it; otherwise the owner calls runSlice() itself.
+  bool begin();
+
+  // Restarts the search on new inputs.
+  void submit(const Inputs& next);
+  // Copies out the best plan of a search finished since the last poll.
+  bool poll(Plan& plan);
+
+  // Scores up to STRATEGY_SLICE_PLANS plans. Returns true if the search
+  // has more to do.
+  bool runSlice();
+};
+
+#endif
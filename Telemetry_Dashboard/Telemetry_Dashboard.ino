@@ -9,6 +9,7 @@
 #include "Model.h"
 #include "View.h"
 #include "Controller.h"
+#include "Trace.h"
 
 Adafruit_ILI9341 tft = Adafruit_ILI9341(PIN_TFT_CS, PIN_TFT_DC, PIN_TFT_RST);
 Adafruit_NeoPixel pixels = Adafruit_NeoPixel(NUM_LEDS, PIN_LED_STRIP, NEO_GRB + NEO_KHZ800);
@@ -25,5 +26,6 @@ void setup() {
 }
 
 void loop() {
+  TRACE_SCOPE(TRACE_LOOP);
   controller.update();
 }
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "TftDisplayBus.h"
+
+// ============================================
+// BLOCKING TRANSPORT
+// ============================================
+
+BlockingDisplayBus::BlockingDisplayBus() {
+  display = NULL;
+}
+
+void BlockingDisplayBus::begin(Adafruit_SPITFT* d) {
+  display = d;
+}
+
+void BlockingDisplayBus::beginTransaction() {
+  display->startWrite();
+  stats.transactions++;
+}
+
+void BlockingDisplayBus::endTransaction() {
+  display->endWrite();
+}
+
+void BlockingDisplayBus::beginRegion(int16_t x, int16_t y, int16_t w, int16_t h) {
+  display->setAddrWindow(x, y, w, h);
+  stats.regions++;
+}
+
+uint16_t* BlockingDisplayBus::acquireSpan() {
+  return span;
+}
+
+void BlockingDisplayBus::queueSpan(uint16_t count) {
+  uint32_t start = micros();
+  display->writePixels(span, count);
+  stats.waitMicros += micros() - start;
+  stats.spans++;
+  stats.bytes += (uint32_t)count * 2;
+}
+
+void BlockingDisplayBus::endRegion() {}
+
+void BlockingDisplayBus::sendCommand(uint8_t command, const uint8_t* data, uint8_t length) {
+  display->writeCommand(command);
+  for (uint8_t i = 0; i < length; i++) {
+    display->spiWrite(data[i]);
+  }
+}
+
+#if defined(ESP32)
+// ============================================
+// DMA TRANSPORT
+// ============================================
+
+DmaDisplayBus::DmaDisplayBus() {
+  device = NULL;
+  nextBuffer = 0;
+  inFlight = 0;
+}
+
+bool DmaDisplayBus::begin() {
+  spi_bus_config_t bus = {};
+  bus.mosi_io_num = PIN_TFT_MOSI;
+  bus.miso_io_num = -1;
+  bus.sclk_io_num = PIN_TFT_SCLK;
+  bus.quadwp_io_num = -1;
+  bus.quadhd_io_num = -1;
+  bus.max_transfer_sz = DISPLAY_BUS_SPAN_PIXELS * 2;
+
+  if (spi_bus_initialize(VSPI_HOST, &bus, SPI_DMA_CH_AUTO) != ESP_OK) {
+    return false;
+  }
+
+  spi_device_interface_config_t config = {};
+  config.mode = 0;
+  config.clock_speed_hz = DISPLAY_SPI_FREQUENCY;
+  config.spics_io_num = -1;
+  config.queue_size = 2;
+  config.flags = SPI_DEVICE_NO_DUMMY;
+
+  if (spi_bus_add_device(VSPI_HOST, &config, &device) != ESP_OK) {
+    spi_bus_free(VSPI_HOST);
+    return false;
+  }
+
+  memset(transactions, 0, sizeof(transactions));
+  pinMode(PIN_TFT_CS, OUTPUT);
+  digitalWrite(PIN_TFT_CS, HIGH);
+  return true;
+}
+
+void DmaDisplayBus::beginTransaction() {
+  spi_device_acquire_bus(device, portMAX_DELAY);
+  digitalWrite(PIN_TFT_CS, LOW);
+  stats.transactions++;
+}
+
+void DmaDisplayBus::endTransaction() {
+  waitForAll();
+  digitalWrite(PIN_TFT_CS, HIGH);
+  spi_device_release_bus(device);
+}
+
+void DmaDisplayBus::sendCommand(uint8_t command, const uint8_t* data, uint8_t length) {
+  // DC cannot change under a queued span.
+  waitForAll();
+
+  spi_transaction_t t = {};
+  t.flags = SPI_TRANS_USE_TXDATA;
+  t.length = 8;
+  t.tx_data[0] = command;
+
+  digitalWrite(PIN_TFT_DC, LOW);
+  spi_device_polling_transmit(device, &t);
+  digitalWrite(PIN_TFT_DC, HIGH);
+
+  // tx_data holds four bytes.
+  while (length > 0) {
+    uint8_t chunk = length < 4 ? length : 4;
+    t.length = (size_t)chunk * 8;
+    memcpy(t.tx_data, data, chunk);
+    spi_device_polling_transmit(device, &t);
+    data += chunk;
+    length -= chunk;
+  }
+}
+
+void DmaDisplayBus::beginRegion(int16_t x, int16_t y, int16_t w, int16_t h) {
+  uint16_t x1 = x + w - 1;
+  uint16_t y1 = y + h - 1;
+  uint8_t columns[4] = { (uint8_t)(x >> 8), (uint8_t)x, (uint8_t)(x1 >> 8), (uint8_t)x1 };
+  uint8_t rows[4] = { (uint8_t)(y >> 8), (uint8_t)y, (uint8_t)(y1 >> 8), (uint8_t)y1 };
+
+  sendCommand(ILI9341_CASET, columns, 4);
+  sendCommand(ILI9341_PASET, rows, 4);
+  sendCommand(ILI9341_RAMWR, NULL, 0);
+  stats.regions++;
+}
+
+void DmaDisplayBus::waitForOne() {
+  spi_transaction_t* done;
+  uint32_t start = micros();
+  spi_device_get_trans_result(device, &done, portMAX_DELAY);
+  stats.waitMicros += micros() - start;
+  inFlight--;
+}
+
+void DmaDisplayBus::waitForAll() {
+  while (inFlight > 0) {
+    waitForOne();
+  }
+}
+
+uint16_t* DmaDisplayBus::acquireSpan() {
+  // Results come back in queue order, so with both buffers in flight the
+  // oldest one is the buffer handed out next.
+  if (inFlight == 2) {
+    waitForOne();
+  }
+  return buffers[nextBuffer];
+}
+
+void DmaDisplayBus::queueSpan(uint16_t count) {
+  uint16_t* span = buffers[nextBuffer];
+  for (uint16_t i = 0; i < count; i++) {
+    span[i] = __builtin_bswap16(span[i]);
+  }
+
+  spi_transaction_t& t = transactions[nextBuffer];
+  t.length = (size_t)count * 16;
+  t.tx_buffer = span;
+  spi_device_queue_trans(device, &t, portMAX_DELAY);
+
+  inFlight++;
+  nextBuffer ^= 1;
+  stats.spans++;
+  stats.bytes += (uint32_t)count * 2;
+}
+
+// Spans may still be on the wire; the next region or the end of the
+// transaction waits for them.
+void DmaDisplayBus::endRegion() {}
+#endif
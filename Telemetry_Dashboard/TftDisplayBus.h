@@ -0,0 +1,78 @@
+#ifndef TFT_DISPLAY_BUS_H
+#define TFT_DISPLAY_BUS_H
+
+#include <Adafruit_ILI9341.h>
+#include "Config.h"
+#include "DisplayBus.h"
+
+#if defined(ESP32)
+#include <driver/spi_master.h>
+#endif
+
+// ============================================
+// Blocking Transport
+// ============================================
+// One span buffer, sent with Adafruit writePixels. Used off-ESP32 and
+// whenever the DMA device cannot be set up.
+class BlockingDisplayBus : public DisplayBus {
+  Adafruit_SPITFT* display;
+  uint16_t span[DISPLAY_BUS_SPAN_PIXELS];
+
+public:
+  BlockingDisplayBus();
+
+  void begin(Adafruit_SPITFT* d);
+
+  void beginTransaction() override;
+  void endTransaction() override;
+  void beginRegion(int16_t x, int16_t y, int16_t w, int16_t h) override;
+  uint16_t* acquireSpan() override;
+  void queueSpan(uint16_t count) override;
+  void endRegion() override;
+  void sendCommand(uint8_t command, const uint8_t* data, uint8_t length) override;
+};
+
+#if defined(ESP32)
+// ============================================
+// DMA Transport (ESP32)
+// ============================================
+// Everything goes through an IDF spi_master device on the panel's SPI
+// host: commands as short polling writes, pixel spans from two
+// alternating DMA buffers. CS and DC are driven by hand, CS held low for
+// the whole transaction.
+//
+// Once begin() has taken the host, Adafruit's SPIClass must not touch it
+// again: its beginTransaction() reprograms the clock and mode, which the
+// driver only sets when another of its own devices used the bus last.
+// The view therefore draws everything through the bus, including what
+// would otherwise go straight to the panel (see BusCanvas).
+class DmaDisplayBus : public DisplayBus {
+  spi_device_handle_t device;
+
+  spi_transaction_t transactions[2];
+  uint16_t buffers[2][DISPLAY_BUS_SPAN_PIXELS] __attribute__((aligned(4)));
+  uint8_t nextBuffer;
+  uint8_t inFlight;
+
+  void waitForOne();
+  void waitForAll();
+
+public:
+  DmaDisplayBus();
+
+  // Must run after the panel is initialised; the panel is then only
+  // reached through this bus. Returns false if the SPI host cannot take
+  // a DMA device, leaving it to Adafruit.
+  bool begin();
+
+  void beginTransaction() override;
+  void endTransaction() override;
+  void beginRegion(int16_t x, int16_t y, int16_t w, int16_t h) override;
+  uint16_t* acquireSpan() override;
+  void queueSpan(uint16_t count) override;
+  void endRegion() override;
+  void sendCommand(uint8_t command, const uint8_t* data, uint8_t length) override;
+};
+#endif
+
+#endif
@@ -0,0 +1,158 @@
+#include "Trace.h"
+
+#if ENABLE_TRACE
+
+Trace trace;
+
+static const char* const STAGE_NAMES[TRACE_STAGE_COUNT] = { "loop", "network", "packet", "render" };
+
+Trace::Trace() {
+  cyclesPerMicro = 240;
+  reset();
+}
+
+void Trace::reset() {
+  nextEvent = 0;
+  eventCount = 0;
+  for (uint8_t i = 0; i < TRACE_STAGE_COUNT; i++) {
+    StageStats& stats = stages[i];
+    stats.count = 0;
+    stats.minCycles = 0xFFFFFFFFUL;
+    stats.maxCycles = 0;
+    stats.totalCycles = 0;
+    for (uint8_t b = 0; b < HISTOGRAM_BUCKETS; b++) {
+      stats.histogram[b] = 0;
+    }
+  }
+
+  windowStartMS = millis();
+  windowFrames = 0;
+  windowPackets = 0;
+  windowDrops = 0;
+  windowRenders = 0;
+  windowRenderCycles = 0;
+  windows = 0;
+  rates.framesPerSecond = 0;
+  rates.packetsPerSecond = 0;
+  rates.drops = 0;
+  rates.renderMicros = 0;
+}
+
+// ============================================
+// HISTOGRAM BUCKETS
+// ============================================
+
+uint8_t Trace::bucketFor(uint32_t micros) {
+  if (micros < 4) return micros;
+
+  uint8_t msb = 31 - __builtin_clz(micros);
+  uint8_t bucket = 4 + (msb - 2) * 4 + ((micros >> (msb - 2)) & 3);
+  return bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1;
+}
+
+uint32_t Trace::bucketLimit(uint8_t bucket) {
+  if (bucket < 4) return bucket + 1;
+
+  uint8_t shift = (bucket - 4) / 4;
+  uint8_t step = (bucket - 4) % 4;
+  return (uint32_t)(5 + step) << shift;
+}
+
+// ============================================
+// RECORDING
+// ============================================
+
+void Trace::record(uint8_t stage, uint32_t startCycles, uint32_t endCycles) {
+  uint32_t cycles = endCycles - startCycles;
+
+  Event& event = events[nextEvent];
+  event.startCycles = startCycles;
+  event.cycles = cycles;
+  event.stage = stage;
+  nextEvent = (nextEvent + 1) % TRACE_BUFFER_EVENTS;
+  eventCount++;
+
+  StageStats& stats = stages[stage];
+  stats.count++;
+  stats.totalCycles += cycles;
+  if (cycles < stats.minCycles) stats.minCycles = cycles;
+  if (cycles > stats.maxCycles) stats.maxCycles = cycles;
+  stats.histogram[bucketFor(cycles / cyclesPerMicro)]++;
+
+  if (stage == TRACE_RENDER) {
+    windowRenders++;
+    windowRenderCycles += cycles;
+  }
+}
+
+void Trace::tick(uint32_t nowMS) {
+  uint32_t elapsed = nowMS - windowStartMS;
+  if (elapsed < 1000) return;
+
+  // Read here rather than in the constructor, which runs before the
+  // clock is configured.
+  cyclesPerMicro = ESP.getCpuFreqMHz();
+
+  rates.framesPerSecond = windowFrames * 1000UL / elapsed;
+  rates.packetsPerSecond = windowPackets * 1000UL / elapsed;
+  rates.drops = windowDrops;
+  rates.renderMicros = windowRenders ? (uint32_t)(windowRenderCycles / windowRenders / cyclesPerMicro) : 0;
+
+  windowStartMS = nowMS;
+  windowFrames = 0;
+  windowPackets = 0;
+  windowDrops = 0;
+  windowRenders = 0;
+  windowRenderCycles = 0;
+  windows++;
+}
+
+uint32_t Trace::percentileMicros(uint8_t stage, uint16_t perMille) const {
+  const StageStats& stats = stages[stage];
+  if (stats.count == 0) return 0;
+
+  // Smallest bucket whose cumulative count reaches the rank.
+  uint32_t rank = (uint64_t)stats.count * perMille / 1000;
+  if (rank == 0) rank = 1;
+  uint32_t seen = 0;
+  for (uint8_t b = 0; b < HISTOGRAM_BUCKETS; b++) {
+    seen += stats.histogram[b];
+    if (seen >= rank) return bucketLimit(b);
+  }
+  return bucketLimit(HISTOGRAM_BUCKETS - 1);
+}
+
+// ============================================
+// SERIAL DUMP
+// ============================================
+
+void Trace::dump(Print& out) {
+  out.println("Stage     count  min_us  avg_us  p99_us  max_us");
+  for (uint8_t i = 0; i < TRACE_STAGE_COUNT; i++) {
+    const StageStats& stats = stages[i];
+    if (stats.count == 0) continue;
+
+    out.printf("%-8s %6lu %7lu %7lu %7lu %7lu\n", STAGE_NAMES[i], (unsigned long)stats.count,
+               (unsigned long)(stats.minCycles / cyclesPerMicro),
+               (unsigned long)(stats.totalCycles / stats.count / cyclesPerMicro),
+               (unsigned long)percentileMicros(i, 990), (unsigned long)(stats.maxCycles / cyclesPerMicro));
+  }
+
+  out.printf("Rates: %u fps, %u packets/s, %u drops, render %lu us\n", rates.framesPerSecond,
+             rates.packetsPerSecond, rates.drops, (unsigned long)rates.renderMicros);
+
+  // In completion order, timed from the first listed event. An enclosing
+  // stage ends after the stages inside it but starts before them, so its
+  // start can be negative.
+  uint16_t count = eventCount < TRACE_BUFFER_EVENTS ? eventCount : TRACE_BUFFER_EVENTS;
+  uint16_t first = (nextEvent + TRACE_BUFFER_EVENTS - count) % TRACE_BUFFER_EVENTS;
+  uint32_t origin = events[first].startCycles;
+  out.println("Event  start_us  duration_us  stage");
+  for (uint16_t n = 0; n < count; n++) {
+    const Event& event = events[(first + n) % TRACE_BUFFER_EVENTS];
+    out.printf("%5u %9ld %12lu  %s\n", n, (long)((int32_t)(event.startCycles - origin) / (int32_t)cyclesPerMicro),
+               (unsigned long)(event.cycles / cyclesPerMicro), STAGE_NAMES[event.stage]);
+  }
+}
+
+#endif
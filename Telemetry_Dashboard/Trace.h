@@ -0,0 +1,132 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// ============================================
+// Stage Tracing
+// ============================================
+// TRACE_SCOPE(stage) times the rest of the enclosing block with the CPU
+// cycle counter. Every sample goes into a ring buffer of recent events and
+// into the stage's histogram; the packet and frame counters feed the
+// once-a-second rates shown by the overlay. With ENABLE_TRACE off the
+// macros expand to nothing and none of this is built.
+enum TraceStage {
+  TRACE_LOOP = 0,
+  TRACE_NETWORK = 1,  // handleNetworkPackets(), including processPacket()
+  TRACE_PACKET = 2,
+  TRACE_RENDER = 3,
+  TRACE_STAGE_COUNT = 4
+};
+
+#if ENABLE_TRACE
+
+class Trace {
+public:
+  // Log-linear microsecond buckets: exact below 4 us, then four per
+  // power of two, so a percentile is within 25% of the true value.
+  static const uint8_t HISTOGRAM_BUCKETS = 92;
+
+  struct StageStats {
+    uint32_t count;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint64_t totalCycles;
+    uint32_t histogram[HISTOGRAM_BUCKETS];
+  };
+
+  // Last complete one-second window.
+  struct Rates {
+    uint16_t framesPerSecond;
+    uint16_t packetsPerSecond;
+    uint16_t drops;
+    uint32_t renderMicros;  // Mean render() time
+  };
+
+private:
+  struct Event {
+    uint32_t startCycles;
+    uint32_t cycles;
+    uint8_t stage;
+  };
+
+  Event events[TRACE_BUFFER_EVENTS];
+  uint16_t nextEvent;
+  uint32_t eventCount;
+
+  StageStats stages[TRACE_STAGE_COUNT];
+  uint32_t cyclesPerMicro;
+
+  uint32_t windowStartMS;
+  uint32_t windowFrames;
+  uint32_t windowPackets;
+  uint32_t windowDrops;
+  uint32_t windowRenders;
+  uint64_t windowRenderCycles;
+  uint32_t windows;
+  Rates rates;
+
+  static uint8_t bucketFor(uint32_t micros);
+  static uint32_t bucketLimit(uint8_t bucket);
+
+public:
+  Trace();
+
+  void reset();
+
+  void record(uint8_t stage, uint32_t startCycles, uint32_t endCycles);
+  void countPacket() {
+    windowPackets++;
+  }
+  void countDrop() {
+    windowDrops++;
+  }
+  void countFrame() {
+    windowFrames++;
+  }
+
+  // Closes the rate window once a second has passed.
+  void tick(uint32_t nowMS);
+
+  // Changes each time tick() publishes new rates.
+  uint32_t getWindow() const {
+    return windows;
+  }
+  const Rates& getRates() const {
+    return rates;
+  }
+
+  // Upper bound of the bucket holding the given fraction of samples.
+  uint32_t percentileMicros(uint8_t stage, uint16_t perMille) const;
+
+  void dump(Print& out);
+};
+
+extern Trace trace;
+
+class TraceScope {
+  uint8_t stage;
+  uint32_t start;
+
+public:
+  explicit TraceScope(uint8_t s)
+    : stage(s), start(ESP.getCycleCount()) {}
+  ~TraceScope() {
+    trace.record(stage, start, ESP.getCycleCount());
+  }
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(stage) TraceScope TRACE_CONCAT(traceScope, __LINE__)(stage)
+#define TRACE_COUNT(counter) trace.counter()
+
+#else
+
+#define TRACE_SCOPE(stage)
+#define TRACE_COUNT(counter)
+
+#endif
+
+#endif
@@ -0,0 +1,259 @@
+#include "TrackMap.h"
+
+// Fewer points than this is not a lap (pit exit, flashback, restart).
+static const uint16_t MIN_LAP_POINTS = 32;
+// A jump back by more than this without crossing the line is a
+// flashback or a reset to the garage.
+static const float REWIND_DISTANCE = 50.0f;
+
+TrackMap::TrackMap() {
+  for (uint8_t i = 0; i < TRACK_MAP_CACHE_SIZE; i++) {
+    outlines[i].trackId = -1;
+    outlines[i].count = 0;
+    outlines[i].lastUsed = 0;
+  }
+  active = NULL;
+  trackId = -1;
+  trackLength = 0;
+  state = STATE_NO_TRACK;
+  uses = 0;
+
+  rawCount = 0;
+  spacing = 0.0f;
+  nextDistance = 0.0f;
+  lastDistance = 0.0f;
+}
+
+bool TrackMap::selectTrack(int8_t id, uint16_t lengthM) {
+  if (id == trackId) return false;
+
+  trackId = id;
+  trackLength = lengthM;
+  rawCount = 0;
+  active = NULL;
+
+  if (id < 0) {
+    state = STATE_NO_TRACK;
+    return true;
+  }
+
+  for (uint8_t i = 0; i < TRACK_MAP_CACHE_SIZE; i++) {
+    if (outlines[i].trackId == id) {
+      active = &outlines[i];
+      active->lastUsed = ++uses;
+      state = STATE_READY;
+      return true;
+    }
+  }
+  state = STATE_WAITING;
+  return true;
+}
+
+// ============================================
+// RECORDING
+// ============================================
+
+bool TrackMap::addSample(float lapDistance, float x, float z) {
+  // Crossing the line, or the first lap's start from behind it.
+  bool lapStarted = (lastDistance > 100.0f && lapDistance < 100.0f) || (lastDistance < 0.0f && lapDistance >= 0.0f);
+  bool rewound = lapDistance < lastDistance - REWIND_DISTANCE && !lapStarted;
+  lastDistance = lapDistance;
+
+  if (state == STATE_WAITING && lapStarted) {
+    beginRecording();
+  }
+  if (state != STATE_RECORDING) return false;
+
+  if (rewound) {
+    state = STATE_WAITING;
+    return false;
+  }
+  if (lapStarted && rawCount > 0) {
+    finishRecording();
+    return state == STATE_READY;
+  }
+
+  if (lapDistance >= nextDistance && rawCount < TRACK_RAW_POINTS) {
+    raw[rawCount].x = x;
+    raw[rawCount].z = z;
+    rawCount++;
+    nextDistance = lapDistance + spacing;
+  }
+  return false;
+}
+
+void TrackMap::abortRecording() {
+  if (state == STATE_RECORDING) {
+    state = STATE_WAITING;
+  }
+}
+
+uint8_t TrackMap::getRecordingProgress() const {
+  if (state != STATE_RECORDING || trackLength == 0 || lastDistance <= 0.0f) return 0;
+  float progress = lastDistance * 100.0f / trackLength;
+  return progress < 100.0f ? (uint8_t)progress : 100;
+}
+
+// Spacing leaves a little headroom for laps longer than the reported
+// track length (pit lane, off-track excursions).
+void TrackMap::beginRecording() {
+  float length = trackLength > 0 ? trackLength : 7000.0f;
+  spacing = length / (TRACK_RAW_POINTS - 16);
+  if (spacing < 5.0f) spacing = 5.0f;
+
+  rawCount = 0;
+  nextDistance = 0.0f;
+  state = STATE_RECORDING;
+}
+
+void TrackMap::finishRecording() {
+  if (rawCount < MIN_LAP_POINTS) {
+    // Too short to be a lap; this crossing starts the next attempt.
+    beginRecording();
+    return;
+  }
+
+  // Reuse this track's slot, else a free one, else the least recently used.
+  Outline* slot = &outlines[0];
+  for (uint8_t i = 0; i < TRACK_MAP_CACHE_SIZE; i++) {
+    if (outlines[i].trackId == trackId) {
+      slot = &outlines[i];
+      break;
+    }
+    if (outlines[i].trackId < 0 || outlines[i].lastUsed < slot->lastUsed) {
+      slot = &outlines[i];
+    }
+  }
+
+  uint16_t kept[TRACK_OUTLINE_POINTS];
+  uint8_t count = simplify(kept);
+  fit(*slot, kept, count);
+  slot->trackId = trackId;
+  slot->lastUsed = ++uses;
+
+  active = slot;
+  rawCount = 0;
+  state = STATE_READY;
+}
+
+// ============================================
+// SIMPLIFICATION
+// ============================================
+
+static float segmentDistance(float px, float pz, float ax, float az, float bx, float bz) {
+  float dx = bx - ax;
+  float dz = bz - az;
+  float lengthSquared = dx * dx + dz * dz;
+  float t = 0.0f;
+  if (lengthSquared > 0.0f) {
+    t = ((px - ax) * dx + (pz - az) * dz) / lengthSquared;
+    if (t < 0.0f) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+  }
+  float ex = ax + t * dx - px;
+  float ez = az + t * dz - pz;
+  return sqrtf(ex * ex + ez * ez);
+}
+
+// Douglas-Peucker on the closed loop, splitting the worst segment first
+// so the result stops at exactly TRACK_OUTLINE_POINTS when the tolerance
+// is not reached: every pass adds the recorded point farthest from the
+// outline so far. Writes the kept raw indices in lap order.
+uint8_t TrackMap::simplify(uint16_t* kept) const {
+  static bool keep[TRACK_RAW_POINTS];
+  for (uint16_t i = 0; i < rawCount; i++) {
+    keep[i] = false;
+  }
+
+  // A loop has no end points; seed with the start and the point farthest
+  // from it.
+  uint16_t farthest = 0;
+  float farthestDistance = 0.0f;
+  for (uint16_t i = 1; i < rawCount; i++) {
+    float dx = raw[i].x - raw[0].x;
+    float dz = raw[i].z - raw[0].z;
+    float distance = dx * dx + dz * dz;
+    if (distance > farthestDistance) {
+      farthestDistance = distance;
+      farthest = i;
+    }
+  }
+  keep[0] = true;
+  keep[farthest] = true;
+  uint8_t count = farthest > 0 ? 2 : 1;
+
+  while (count < TRACK_OUTLINE_POINTS) {
+    int32_t worst = -1;
+    float worstDistance = TRACK_OUTLINE_TOLERANCE;
+
+    // Segments between consecutive kept points; i == rawCount closes the
+    // loop back to point 0.
+    uint16_t from = 0;
+    for (uint16_t i = 1; i <= rawCount; i++) {
+      if (i < rawCount && !keep[i]) continue;
+
+      const WorldPoint& a = raw[from];
+      const WorldPoint& b = raw[i % rawCount];
+      for (uint16_t j = from + 1; j < i; j++) {
+        float distance = segmentDistance(raw[j].x, raw[j].z, a.x, a.z, b.x, b.z);
+        if (distance > worstDistance) {
+          worstDistance = distance;
+          worst = j;
+        }
+      }
+      from = i;
+    }
+
+    if (worst < 0) break;
+    keep[worst] = true;
+    count++;
+  }
+
+  uint8_t n = 0;
+  for (uint16_t i = 0; i < rawCount; i++) {
+    if (keep[i]) kept[n++] = i;
+  }
+  return n;
+}
+
+// Scales the kept points into the map area, centred, preserving aspect.
+// The bounds come from every recorded point, so nothing the simplified
+// outline cuts off falls outside the map.
+void TrackMap::fit(Outline& outline, const uint16_t* kept, uint8_t count) {
+  float minX = raw[0].x, maxX = raw[0].x;
+  float minZ = raw[0].z, maxZ = raw[0].z;
+  for (uint16_t i = 1; i < rawCount; i++) {
+    if (raw[i].x < minX) minX = raw[i].x;
+    if (raw[i].x > maxX) maxX = raw[i].x;
+    if (raw[i].z < minZ) minZ = raw[i].z;
+    if (raw[i].z > maxZ) maxZ = raw[i].z;
+  }
+
+  // A 2-pixel border keeps markers on the outline's edge inside the area.
+  float width = maxX - minX > 1.0f ? maxX - minX : 1.0f;
+  float height = maxZ - minZ > 1.0f ? maxZ - minZ : 1.0f;
+  float scaleX = (MAP_WIDTH - 5) / width;
+  float scaleZ = (MAP_HEIGHT - 5) / height;
+  outline.scale = scaleX < scaleZ ? scaleX : scaleZ;
+  outline.originX = minX - (MAP_WIDTH - width * outline.scale) / 2 / outline.scale;
+  outline.originZ = maxZ + (MAP_HEIGHT - height * outline.scale) / 2 / outline.scale;
+
+  outline.count = count;
+  for (uint8_t i = 0; i < count; i++) {
+    const WorldPoint& point = raw[kept[i]];
+    outline.points[i].x = MAP_X + (int16_t)((point.x - outline.originX) * outline.scale);
+    outline.points[i].y = MAP_Y + (int16_t)((outline.originZ - point.z) * outline.scale);
+  }
+}
+
+bool TrackMap::toScreen(float x, float z, int16_t& screenX, int16_t& screenY) const {
+  if (!active) return false;
+
+  float sx = (x - active->originX) * active->scale;
+  float sy = (active->originZ - z) * active->scale;
+  sx = constrain(sx, 2.0f, MAP_WIDTH - 3.0f);
+  sy = constrain(sy, 2.0f, MAP_HEIGHT - 3.0f);
+  screenX = MAP_X + (int16_t)sx;
+  screenY = MAP_Y + (int16_t)sy;
+  return true;
+}
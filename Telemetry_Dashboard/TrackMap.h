@@ -0,0 +1,100 @@
+#ifndef TRACK_MAP_H
+#define TRACK_MAP_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// ============================================
+// Track Outline
+// ============================================
+// Records the player's world X/Z position over one full lap, simplifies
+// the loop with Douglas-Peucker to at most TRACK_OUTLINE_POINTS, and
+// scales it into the map area. Outlines are cached per track ID, so
+// returning to a track already driven this session needs no new lap.
+class TrackMap {
+public:
+  // Screen rectangle the outline is fitted into; the friction circle
+  // takes the right of the screen.
+  static const int16_t MAP_X = 6;
+  static const int16_t MAP_Y = 28;
+  static const int16_t MAP_WIDTH = 212;
+  static const int16_t MAP_HEIGHT = 206;
+
+  struct Point {
+    int16_t x;
+    int16_t y;
+  };
+
+  enum State {
+    STATE_NO_TRACK,  // No session packet yet
+    STATE_WAITING,   // For the start of the next lap
+    STATE_RECORDING,
+    STATE_READY
+  };
+
+private:
+  struct Outline {
+    int8_t trackId;  // -1 = free slot
+    uint8_t count;
+    uint32_t lastUsed;
+    // World to screen: x right, z up.
+    float originX;
+    float originZ;
+    float scale;
+    Point points[TRACK_OUTLINE_POINTS];
+  };
+
+  struct WorldPoint {
+    float x;
+    float z;
+  };
+
+  Outline outlines[TRACK_MAP_CACHE_SIZE];
+  Outline* active;
+  int8_t trackId;
+  uint16_t trackLength;
+  State state;
+  uint32_t uses;
+
+  WorldPoint raw[TRACK_RAW_POINTS];
+  uint16_t rawCount;
+  float spacing;
+  float nextDistance;
+  float lastDistance;
+
+  void beginRecording();
+  void finishRecording();
+  uint8_t simplify(uint16_t* kept) const;
+  void fit(Outline& outline, const uint16_t* kept, uint8_t count);
+
+public:
+  TrackMap();
+
+  // From the session packet; returns true if the shown outline changed.
+  bool selectTrack(int8_t id, uint16_t lengthM);
+
+  // Player position at lapDistance metres into the lap (negative before
+  // the line on the first lap). Returns true when a new outline is ready.
+  bool addSample(float lapDistance, float x, float z);
+  // A flashback breaks the lap being recorded; recording restarts at the
+  // next lap start.
+  void abortRecording();
+
+  State getState() const {
+    return state;
+  }
+  // 0-100 while recording.
+  uint8_t getRecordingProgress() const;
+
+  uint8_t getOutlineCount() const {
+    return active ? active->count : 0;
+  }
+  const Point* getOutline() const {
+    return active ? active->points : NULL;
+  }
+
+  // False without an outline.
+  bool toScreen(float x, float z, int16_t& screenX, int16_t& screenY) const;
+};
+
+#endif
@@ -0,0 +1,84 @@
+#include "TyreSets.h"
+
+TyreSetTable::TyreSetTable() {
+  clear();
+}
+
+void TyreSetTable::clear() {
+  count = 0;
+  suggestionCount = 0;
+}
+
+bool TyreSetTable::update(const PacketTyreSetsData* packet) {
+  TyreSet next[TYRE_SET_COUNT];
+  uint8_t nextCount = 0;
+
+  for (uint8_t i = 0; i < TYRE_SET_COUNT; i++) {
+    const TyreSetData& data = packet->m_tyreSetData[i];
+    bool fitted = i == packet->m_fittedIdx;
+    if (!data.m_available && !fitted) continue;
+
+    TyreSet& set = next[nextCount++];
+    set.lapDeltaMS = data.m_lapDeltaTime;
+    set.actualCompound = data.m_actualTyreCompound;
+    set.visualCompound = data.m_visualTyreCompound;
+    set.wear = data.m_wear;
+    set.lifeSpan = data.m_lifeSpan;
+    set.usableLife = data.m_usableLife;
+    set.fitted = fitted;
+  }
+
+  if (nextCount == count && memcmp(next, sets, nextCount * sizeof(TyreSet)) == 0) return false;
+
+  memcpy(sets, next, nextCount * sizeof(TyreSet));
+  count = nextCount;
+  suggest();
+  return true;
+}
+
+bool TyreSetTable::isFresher(const TyreSet& a, const TyreSet& b) {
+  return a.wear != b.wear ? a.wear < b.wear : a.lifeSpan > b.lifeSpan;
+}
+
+void TyreSetTable::suggest() {
+  // Freshest unfitted set of each compound. There are at most five
+  // compounds, so the candidate list is searched linearly.
+  uint8_t candidates[TYRE_SET_COUNT];
+  uint8_t candidateCount = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    if (sets[i].fitted) continue;
+
+    uint8_t c = 0;
+    while (c < candidateCount && sets[candidates[c]].visualCompound != sets[i].visualCompound) c++;
+    if (c == candidateCount) {
+      candidates[candidateCount++] = i;
+    } else if (isFresher(sets[i], sets[candidates[c]])) {
+      candidates[c] = i;
+    }
+  }
+
+  // Insertion sort by lap delta.
+  for (uint8_t i = 1; i < candidateCount; i++) {
+    uint8_t set = candidates[i];
+    uint8_t j = i;
+    while (j > 0 && sets[candidates[j - 1]].lapDeltaMS > sets[set].lapDeltaMS) {
+      candidates[j] = candidates[j - 1];
+      j--;
+    }
+    candidates[j] = set;
+  }
+
+  suggestionCount = candidateCount < TYRE_SUGGESTIONS ? candidateCount : TYRE_SUGGESTIONS;
+  memcpy(suggestions, candidates, suggestionCount);
+}
+
+const char* TyreSetTable::compoundName(uint8_t visualCompound) {
+  switch (visualCompound) {
+    case 16: return "SOFT";
+    case 17: return "MEDIUM";
+    case 18: return "HARD";
+    case 7: return "INTER";
+    case 8: return "WET";
+    default: return "?";
+  }
+}
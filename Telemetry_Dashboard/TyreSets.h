@@ -0,0 +1,65 @@
+#ifndef TYRE_SETS_H
+#define TYRE_SETS_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// ============================================
+// Tyre Set Table
+// ============================================
+// The player's tyre allocation from the tyre sets packet, cut down to the
+// sets still available plus the fitted one. The controller only caches a
+// packet whose sets differ from the last, so update() runs once per
+// change, and the next-set suggestions are worked out there rather than
+// on every redraw.
+//
+// A suggestion is the freshest available set of one compound (least
+// wear, then most laps left); the compounds are ranked by the game's lap
+// delta against the fitted set, quickest first.
+class TyreSetTable {
+public:
+  // No padding, so tables compare with memcmp.
+  struct TyreSet {
+    int16_t lapDeltaMS;  // Against the fitted set
+    uint8_t actualCompound;
+    uint8_t visualCompound;
+    uint8_t wear;        // %
+    uint8_t lifeSpan;    // Laps left
+    uint8_t usableLife;  // Laps recommended for the compound
+    bool fitted;
+  };
+
+private:
+  TyreSet sets[TYRE_SET_COUNT];
+  uint8_t count;
+  uint8_t suggestions[TYRE_SUGGESTIONS];  // Indices into sets
+  uint8_t suggestionCount;
+
+  static bool isFresher(const TyreSet& a, const TyreSet& b);
+  void suggest();
+
+public:
+  TyreSetTable();
+
+  // Returns true if the table changed.
+  bool update(const PacketTyreSetsData* packet);
+  void clear();
+
+  uint8_t getCount() const {
+    return count;
+  }
+  const TyreSet& getSet(uint8_t index) const {
+    return sets[index];
+  }
+  uint8_t getSuggestionCount() const {
+    return suggestionCount;
+  }
+  const TyreSet& getSuggestion(uint8_t rank) const {
+    return sets[suggestions[rank]];
+  }
+
+  // "SOFT", "MEDIUM", ... from a visual compound; "?" if unknown.
+  static const char* compoundName(uint8_t visualCompound);
+};
+
+#endif
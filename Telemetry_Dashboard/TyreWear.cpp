@@ -0,0 +1,84 @@
+#include "TyreWear.h"
+
+TyreWearModel::TyreWearModel() {
+  reset();
+}
+
+void TyreWearModel::reset() {
+  for (uint8_t i = 0; i < 4; i++) {
+    Fit& fit = fits[i];
+    fit.samples = 0;
+    fit.load = 0.0f;
+    fit.meanLoad = 0.0f;
+    fit.meanWear = 0.0f;
+    fit.loadLoad = 0.0f;
+    fit.loadWear = 0.0f;
+    lastWear[i] = 0.0f;
+    ratePerLap[i] = 0.0f;
+    lapsToCliff[i] = -1.0f;
+  }
+  lastProgress = 0.0f;
+  lastTyreAge = 0;
+  started = false;
+}
+
+// Never below a fifth of a lap, so a cold corner still wears.
+float TyreWearModel::temperatureFactor(float temperature) {
+  float factor = 1.0f + (temperature - TYRE_REFERENCE_TEMP) * TYRE_TEMP_WEAR_FACTOR;
+  return factor > 0.2f ? factor : 0.2f;
+}
+
+bool TyreWearModel::sample(float progress, const float wear[4], const float temperature[4], uint8_t tyreAge) {
+  // A younger set, or wear well down on any corner, is a pit stop.
+  bool newSet = tyreAge < lastTyreAge;
+  for (uint8_t i = 0; i < 4; i++) {
+    if (wear[i] < lastWear[i] - 5.0f) newSet = true;
+  }
+  if (started && newSet) reset();
+
+  // Flashbacks run progress backwards; those samples are skipped rather
+  // than unwound from the fit.
+  float laps = progress - lastProgress;
+  bool skip = started && laps <= 0.0f;
+  if (!started) laps = 0.0f;
+
+  started = true;
+  lastProgress = progress;
+  lastTyreAge = tyreAge;
+  if (skip) return false;
+
+  bool changed = false;
+  for (uint8_t i = 0; i < 4; i++) {
+    Fit& fit = fits[i];
+    float factor = temperatureFactor(temperature[i]);
+    fit.load += laps * factor;
+    lastWear[i] = wear[i];
+
+    // Welford update of means and co-moments.
+    fit.samples++;
+    float loadDelta = fit.load - fit.meanLoad;
+    float wearDelta = wear[i] - fit.meanWear;
+    fit.meanLoad += loadDelta / fit.samples;
+    fit.meanWear += wearDelta / fit.samples;
+    fit.loadLoad += loadDelta * (fit.load - fit.meanLoad);
+    fit.loadWear += loadDelta * (wear[i] - fit.meanWear);
+
+    float rate = 0.0f;
+    float cliff = -1.0f;
+    if (fit.samples >= TYRE_WEAR_MIN_SAMPLES && fit.loadLoad > 0.0f) {
+      float slope = fit.loadWear / fit.loadLoad;
+      if (slope > 0.0f) {
+        rate = slope * factor;
+        cliff = wear[i] < TYRE_WEAR_CLIFF ? (TYRE_WEAR_CLIFF - wear[i]) / rate : 0.0f;
+      }
+    }
+
+    if (lroundf(rate * 100.0f) != lroundf(ratePerLap[i] * 100.0f) ||
+        lroundf(cliff * 10.0f) != lroundf(lapsToCliff[i] * 10.0f)) {
+      changed = true;
+    }
+    ratePerLap[i] = rate;
+    lapsToCliff[i] = cliff;
+  }
+  return changed;
+}
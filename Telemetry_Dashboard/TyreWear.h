@@ -0,0 +1,59 @@
+#ifndef TYRE_WEAR_H
+#define TYRE_WEAR_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// ============================================
+// Tyre Wear Model
+// ============================================
+// A straight-line fit per corner of wear against temperature-weighted
+// laps on the current set. A lap at TYRE_REFERENCE_TEMP counts as one;
+// every degree of carcass temperature (the mean of surface and inner)
+// above or below adds or takes off TYRE_TEMP_WEAR_FACTOR of a lap. The fit
+// is kept as running means and co-moments, so a sample costs the same
+// however long the stint, and the slope is the wear per reference lap.
+//
+// The prediction scales that slope by the corner's current temperature
+// and divides the wear left before TYRE_WEAR_CLIFF by it. The fits start
+// again on a new set.
+//
+// Corners are in packet order: RL, RR, FL, FR.
+class TyreWearModel {
+  struct Fit {
+    uint16_t samples;
+    float load;  // Temperature-weighted laps on the set
+    float meanLoad;
+    float meanWear;
+    float loadLoad;  // Sums of squared and cross deviations
+    float loadWear;
+  };
+
+  Fit fits[4];
+  float lastProgress;  // Laps into the session at the last sample
+  float lastWear[4];
+  uint8_t lastTyreAge;
+  bool started;
+
+  float ratePerLap[4];   // % per lap at the latest temperature; 0 with no fit
+  float lapsToCliff[4];  // -1 with no fit
+
+  static float temperatureFactor(float temperature);
+
+public:
+  TyreWearModel();
+  void reset();
+
+  // progress is laps into the session (lap number - 1 + lap fraction).
+  // Returns true if a prediction changed at display resolution.
+  bool sample(float progress, const float wear[4], const float temperature[4], uint8_t tyreAge);
+
+  float getRatePerLap(uint8_t corner) const {
+    return ratePerLap[corner];
+  }
+  float getLapsToCliff(uint8_t corner) const {
+    return lapsToCliff[corner];
+  }
+};
+
+#endif
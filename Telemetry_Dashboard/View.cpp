@@ -1,4 +1,6 @@
 #include "View.h"
+#include "Glyphs.h"
+#include "Format.h"
 
 // ============================================
 // CONSTRUCTOR
@@ -7,132 +9,57 @@ TelemetryView::TelemetryView(Adafruit_ILI9341* display, Adafruit_NeoPixel* leds,
   tft = display;
   pixels = leds;
   model = m;
+  gfx = display;
+  panel = display;
+  bus = &blockingBus;
 
   // Screen Management
   currentScreen = SCREEN_GENERAL;
   screenChanged = true;
   bootInfoDrawn = false;
 
-  // ============================================
-  // SCREEN 1: GENERAL - Initialize Dirty Tracking
-  // ============================================
-  lastPosition = 255;
-  lastDeltaFront = 65535;
-  lastDeltaLeader = 65535;
-  lastDeltaLive = -999.0f;
-  lastLapTime = 0;
-  lastCurrentLapTime = 0;
-  lastSector1 = 65535;
-  lastSector2 = 65535;
-  lastCurrentLapNum = 255;
-  lastCornerCuttingWarnings = 255;
-
-  lastSpeed = 65535;
-  lastThrottle = -999.0f;
-  lastBrake = -999.0f;
-  lastGear = -99;
-  lastRPM = 65535;
-
-  lastDRS = 255;
-  lastRevLightsPercent = 255;
-  lastSuggestedGear = -99;
-  lastFrontBrakeBias = 255;
-  lastDiffOnThrottle = 255;
-
-  lastFuelInTank = -999.0f;
-  lastFuelRemainingLaps = -999.0f;
-  lastERSEnergy = -999.0f;
-  lastERSMode = 255;
-
+  // Rendering State
+  drawnThrottleHeight = -1;
+  drawnBrakeHeight = -1;
+  drawnERSWidth = -1;
   lastLedsOn = 255;
-
-  // ============================================
-  // SCREEN 2: TYRE INFO - Initialize Dirty Tracking
-  // ============================================
-  lastTyresAgeLaps = 255;
-
-  lastBrakeTempFL = 65535;
-  lastBrakeTempFR = 65535;
-  lastBrakeTempRL = 65535;
-  lastBrakeTempRR = 65535;
-
-  lastTyreSurfTempFL = 255;
-  lastTyreSurfTempFR = 255;
-  lastTyreSurfTempRL = 255;
-  lastTyreSurfTempRR = 255;
-
-  lastTyreInnerTempFL = 255;
-  lastTyreInnerTempFR = 255;
-  lastTyreInnerTempRL = 255;
-  lastTyreInnerTempRR = 255;
-
-  lastTyrePressureFL = -1.0f;
-  lastTyrePressureFR = -1.0f;
-  lastTyrePressureRL = -1.0f;
-  lastTyrePressureRR = -1.0f;
-
-  lastTyreWearFL = -1.0f;
-  lastTyreWearFR = -1.0f;
-  lastTyreWearRL = -1.0f;
-  lastTyreWearRR = -1.0f;
-
-  lastTyreDamageFL = 255;
-  lastTyreDamageFR = 255;
-  lastTyreDamageRL = 255;
-  lastTyreDamageRR = 255;
-
-  lastBrakeDamageFL = 255;
-  lastBrakeDamageFR = 255;
-  lastBrakeDamageRL = 255;
-  lastBrakeDamageRR = 255;
-
-  // ============================================
-  // SCREEN 3: CAR INFO - Initialize Dirty Tracking
-  // ============================================
-  lastICEPower = -1.0f;
-  lastMGUKPower = -1.0f;
-  lastERSPercent = -1.0f;
-  lastEngineTemp = 65535;
-  lastDRSFault = 255;
-  lastERSFault = 255;
-
-  lastWingDamageFL = 255;
-  lastWingDamageFR = 255;
-  lastWingDamageRear = 255;
-  lastFloorDamage = 255;
-  lastDiffuserDamage = 255;
-  lastSidepodDamage = 255;
-
-  lastGearboxDamage = 255;
-  lastICEDamage = 255;
-  lastMGUHDamage = 255;
-  lastMGUKDamage = 255;
-  lastTCDamage = 255;
-  lastERSDamage = 255;
-  lastCEDamage = 255;
-
-  // ============================================
-  // SCREEN 4: RACE OVERVIEW - Initialize Dirty Tracking
-  // ============================================
-  lastWeather = 255;
-  lastTrackTemp = -99;
-  lastAirTemp = -99;
-
-  lastSessionType = 255;
-  lastCurrentLapInfo = 255;
-  lastTotalLaps = 255;
-  lastSessionTimeLeft = 65535;
-  lastSafetyCarStatus = 255;
-
-  lastBestLapTime = 0;
-  lastLastLapTime = 0;
-  lastSector1Time = 65535;
-  lastSector2Time = 65535;
-
-  lastFuelRemaining = -1.0f;
-  lastTyresAge = 255;
-  lastEngineTempCritical = 65535;
-  lastOverallDamage = 255;
+  for (uint8_t i = 0; i < MAX_CARS; i++) {
+    drawnMarkers[i].x = -1;
+  }
+  drawnGForceSamples = 0;
+  gForceTrailDrawn = false;
+  bannerState = BANNER_IDLE;
+  bannerStartMS = 0;
+
+  for (uint8_t i = 0; i < SCREEN_COUNT; i++) {
+    renderStats[i].frames = 0;
+    renderStats[i].totalMicros = 0;
+    renderStats[i].maxMicros = 0;
+    renderStats[i].busWaitMicros = 0;
+    renderStats[i].pushedBytes = 0;
+    renderStats[i].directBytes = 0;
+    renderStats[i].tiles = 0;
+    renderStats[i].regions = 0;
+    renderStats[i].transactions = 0;
+    renderStats[i].directWindows = 0;
+    renderStats[i].switches = 0;
+    renderStats[i].switchMicros = 0;
+    renderStats[i].maxSwitchMicros = 0;
+
+    for (uint8_t j = 0; j < MAX_SCREEN_WIDGETS; j++) {
+      widgetStats[i][j].runs = 0;
+      widgetStats[i][j].deferrals = 0;
+      widgetStats[i][j].totalLatencyMicros = 0;
+      widgetStats[i][j].maxLatencyMicros = 0;
+      widgetStats[i][j].costMicros = 0;
+    }
+  }
+  dueWidgets = 0;
+  widgetsHeld = false;
+  heldWidgetMS = 0;
+#if ENABLE_TRACE && ENABLE_TRACE_OVERLAY
+  drawnTraceWindow = 0;
+#endif
 }
 
 // ============================================
@@ -143,102 +70,837 @@ void TelemetryView::init() {
   tft->setRotation(DISPLAY_ROTATION);
   tft->fillScreen(COLOR_BLACK);
 
+  blockingBus.begin(tft);
+#if defined(ESP32) && ENABLE_DMA_DISPLAY
+  if (dmaBus.begin()) {
+    bus = &dmaBus;
+    busCanvas.begin(bus);
+    panel = &busCanvas;
+    gfx = panel;
+  }
+#endif
+  compositor.attachBus(bus);
+  captureBackgrounds();
+  inputTrace.begin(bus);
+
   pixels->begin();
   pixels->setBrightness(LED_BRIGHTNESS_DEFAULT);
   pixels->clear();
   pixels->show();
 }
 
+// ============================================
+// VALUE WIDGETS
+// ============================================
+// Widgets that show one field as text, a labelled state or a bar are data;
+// drawSpec() renders them all. Coordinates are screen pixels.
+
+static constexpr EnumLabel DRS_LABELS[] = {
+  { "---", COLOR_DARKGREY },
+  { "DRS", COLOR_GREEN },
+  { "---", COLOR_DARKGREY },
+};
+
+static constexpr EnumLabel ERS_MODE_LABELS[] = {
+  { "NONE", COLOR_YELLOW },
+  { "MED", COLOR_YELLOW },
+  { "HOT", COLOR_YELLOW },
+  { "OVR", COLOR_YELLOW },
+  { "--", COLOR_YELLOW },
+};
+
+static constexpr EnumLabel WEATHER_LABELS[] = {
+  { "CLEAR", COLOR_CYAN },
+  { "LT CLOUD", COLOR_WHITE },
+  { "OVERCAST", COLOR_DARKGREY },
+  { "LT RAIN", COLOR_YELLOW },
+  { "HVY RAIN", COLOR_YELLOW },
+  { "STORM", COLOR_RED },
+  { "UNKNOWN", COLOR_WHITE },
+};
+
+static constexpr EnumLabel SESSION_TYPE_LABELS[] = {
+  { "UNKNOWN", COLOR_MAGENTA },
+  { "FP1", COLOR_MAGENTA },
+  { "FP2", COLOR_MAGENTA },
+  { "FP3", COLOR_MAGENTA },
+  { "FP SHORT", COLOR_MAGENTA },
+  { "Q1", COLOR_MAGENTA },
+  { "Q2", COLOR_MAGENTA },
+  { "Q3", COLOR_MAGENTA },
+  { "Q SHORT", COLOR_MAGENTA },
+  { "OSQ", COLOR_MAGENTA },
+  { "RACE", COLOR_MAGENTA },
+  { "RACE 2", COLOR_MAGENTA },
+  { "RACE 3", COLOR_MAGENTA },
+  { "TIME TRIAL", COLOR_MAGENTA },
+  { "SESSION", COLOR_MAGENTA },
+};
+
+static constexpr EnumLabel SAFETY_CAR_LABELS[] = {
+  { "NO", COLOR_GREEN },
+  { "FULL", COLOR_YELLOW },
+  { "VIRTUAL", COLOR_YELLOW },
+  { "FORMATION", COLOR_CYAN },
+  { "NO", COLOR_GREEN },
+};
+
+// GENERAL
+static constexpr ValueFormat POSITION_FORMAT = ValueFormat(2, COLOR_CYAN).text("P", "").valid(0);
+static constexpr ValueFormat GAP_FORMAT = ValueFormat(1, COLOR_YELLOW, 2).text("+", "").scaled(0.001f).valid(0, 30);
+static constexpr ValueFormat SECTOR_FORMAT = ValueFormat(1, COLOR_GREEN, 3).scaled(0.001f).valid(0);
+static constexpr ValueFormat LAP_NUM_FORMAT = ValueFormat(2, COLOR_WHITE);
+static constexpr ValueFormat WARNINGS_FORMAT = ValueFormat(2, COLOR_GREEN).band(1, COLOR_RED);
+static constexpr ValueFormat RPM_FORMAT = ValueFormat(2, COLOR_YELLOW);
+static constexpr ValueFormat DRS_FORMAT = ValueFormat(2, COLOR_GREEN).enumerated(DRS_LABELS);
+static constexpr ValueFormat REV_LIGHTS_FORMAT = ValueFormat(2, COLOR_ORANGE).text("", "%");
+static constexpr ValueFormat SUGGESTED_GEAR_FORMAT = ValueFormat(2, COLOR_MAGENTA).valid(0);
+static constexpr ValueFormat BIAS_FORMAT = ValueFormat(2, COLOR_MAGENTA).text("", "%");
+static constexpr ValueFormat DIFF_FORMAT = ValueFormat(2, COLOR_CYAN).text("", "%");
+static constexpr ValueFormat FUEL_FORMAT = ValueFormat(1, COLOR_WHITE, 1).text("", "kg");
+static constexpr ValueFormat FUEL_LAPS_FORMAT = ValueFormat(1, COLOR_RED, 1).valid(0.1f).band(1, COLOR_YELLOW, 3, COLOR_GREEN);
+static constexpr ValueFormat ERS_MODE_FORMAT = ValueFormat(1, COLOR_YELLOW).enumerated(ERS_MODE_LABELS);
+
+static constexpr WidgetSpec GENERAL_CRITICAL_SPECS[] = {
+  { FIELD_ENGINE_RPM, 113, 1, 74, 22, TEXT_CENTER, 6, &RPM_FORMAT },
+  { FIELD_DRS, 191, 25, 86, 22, TEXT_CENTER, 30, &DRS_FORMAT },
+  { FIELD_SUGGESTED_GEAR, 191, 73, 86, 22, TEXT_CENTER, 78, &SUGGESTED_GEAR_FORMAT },
+};
+
+static constexpr WidgetSpec GENERAL_RACE_SPECS[] = {
+  { FIELD_CAR_POSITION, 43, 1, 66, 22, TEXT_CENTER, 4, &POSITION_FORMAT },
+  { FIELD_DELTA_TO_CAR_IN_FRONT, 43, 25, 66, 22, TEXT_CENTER, 32, &GAP_FORMAT },
+  { FIELD_SECTOR1_TIME, 43, 121, 66, 22, TEXT_CENTER, 128, &SECTOR_FORMAT },
+  { FIELD_SECTOR2_TIME, 43, 145, 66, 22, TEXT_CENTER, 152, &SECTOR_FORMAT },
+  { FIELD_CURRENT_LAP_NUM, 43, 169, 66, 22, TEXT_CENTER, 172, &LAP_NUM_FORMAT },
+  { FIELD_CORNER_CUTTING_WARNINGS, 43, 193, 66, 22, TEXT_CENTER, 199, &WARNINGS_FORMAT },
+  { FIELD_REV_LIGHTS_PERCENT, 191, 49, 86, 22, TEXT_CENTER, 54, &REV_LIGHTS_FORMAT },
+  { FIELD_ERS_DEPLOY_MODE, 191, 193, 86, 22, TEXT_CENTER, 201, &ERS_MODE_FORMAT },
+};
+
+static constexpr WidgetSpec GENERAL_SETUP_SPECS[] = {
+  { FIELD_FRONT_BRAKE_BIAS, 191, 97, 86, 22, TEXT_CENTER, 102, &BIAS_FORMAT },
+  { FIELD_DIFF_ON_THROTTLE, 191, 121, 86, 22, TEXT_CENTER, 126, &DIFF_FORMAT },
+  { FIELD_FUEL_IN_TANK, 191, 145, 86, 22, TEXT_CENTER, 153, &FUEL_FORMAT },
+  { FIELD_FUEL_REMAINING_LAPS, 191, 169, 86, 22, TEXT_CENTER, 177, &FUEL_LAPS_FORMAT },
+};
+
+// TYRE INFO - one row per value, left column front/rear left, right column
+// front/rear right.
+static constexpr ValueFormat BRAKE_TEMP_FORMAT = ValueFormat(1, COLOR_ORANGE).text("Brake: ", "C").band(601, COLOR_RED);
+static constexpr ValueFormat SURFACE_TEMP_FORMAT = ValueFormat(1, COLOR_GREEN).text("Surf:  ", "C");
+static constexpr ValueFormat INNER_TEMP_FORMAT = ValueFormat(1, COLOR_YELLOW).text("Inner: ", "C");
+static constexpr ValueFormat PRESSURE_FORMAT = ValueFormat(1, COLOR_WHITE, 2).text("Press: ", "");
+static constexpr ValueFormat TYRE_WEAR_FORMAT = ValueFormat(1, COLOR_CYAN).text("Wear:  ", "%");
+static constexpr ValueFormat TYRE_DAMAGE_FORMAT = ValueFormat(1, COLOR_GREEN).text("T.Dmg: ", "%").band(51, COLOR_RED);
+static constexpr ValueFormat BRAKE_DAMAGE_FORMAT = ValueFormat(1, COLOR_GREEN).text("B.Dmg: ", "%").band(51, COLOR_RED);
+static constexpr ValueFormat TYRE_AGE_FORMAT = ValueFormat(2, COLOR_WHITE).text("AGE: ", " LAPS");
+
+#define TYRE_ROW(id, y, format) \
+  { FIELD_##id##_FL, 5, y, 150, 10, 5, y, &format }, \
+  { FIELD_##id##_FR, 165, y, 150, 10, 165, y, &format }, \
+  { FIELD_##id##_RL, 5, y + 108, 150, 10, 5, y + 108, &format }, \
+  { FIELD_##id##_RR, 165, y + 108, 150, 10, 165, y + 108, &format }
+
+static constexpr WidgetSpec TYRE_TEMP_SPECS[] = {
+  TYRE_ROW(BRAKE_TEMP, 40, BRAKE_TEMP_FORMAT),
+  TYRE_ROW(TYRE_SURFACE_TEMP, 52, SURFACE_TEMP_FORMAT),
+  TYRE_ROW(TYRE_INNER_TEMP, 64, INNER_TEMP_FORMAT),
+  TYRE_ROW(TYRE_PRESSURE, 76, PRESSURE_FORMAT),
+};
+
+static constexpr WidgetSpec TYRE_WEAR_SPECS[] = {
+  TYRE_ROW(TYRE_WEAR, 88, TYRE_WEAR_FORMAT),
+  TYRE_ROW(TYRE_DAMAGE, 100, TYRE_DAMAGE_FORMAT),
+  TYRE_ROW(BRAKE_DAMAGE, 112, BRAKE_DAMAGE_FORMAT),
+  { FIELD_TYRES_AGE_LAPS, 1, 1, 318, 22, 90, 4, &TYRE_AGE_FORMAT },
+};
+
+#undef TYRE_ROW
+
+// CAR INFO
+static constexpr ValueFormat POWER_FORMAT = ValueFormat(1, COLOR_GREEN).text("", " kW");
+static constexpr ValueFormat ERS_PERCENT_FORMAT =
+  ValueFormat(1, COLOR_RED).text("", "%").scaled(100.0f / 4000000.0f).band(20, COLOR_YELLOW, 50, COLOR_GREEN);
+static constexpr ValueFormat ENGINE_TEMP_FORMAT = ValueFormat(1, COLOR_GREEN).text("", "C").band(140, COLOR_YELLOW, 160, COLOR_RED);
+static constexpr ValueFormat AERO_DAMAGE_FORMAT = ValueFormat(1, COLOR_GREEN).text("", "%").band(21, COLOR_YELLOW, 41, COLOR_RED);
+static constexpr ValueFormat COMPONENT_WEAR_FORMAT =
+  ValueFormat(1, COLOR_GREEN).text("", "%").band(71, COLOR_YELLOW, 91, COLOR_RED).bar(150, 6, 0, 100);
+
+static constexpr WidgetSpec POWER_UNIT_SPECS[] = {
+  { FIELD_ENGINE_POWER_ICE, 60, 25, 90, 10, 60, 25, &POWER_FORMAT },
+  { FIELD_ENGINE_POWER_MGUK, 60, 40, 90, 10, 60, 40, &POWER_FORMAT },
+  { FIELD_ERS_STORE_ENERGY, 60, 55, 90, 10, 60, 55, &ERS_PERCENT_FORMAT },
+  { FIELD_ENGINE_TEMP, 60, 70, 90, 10, 60, 70, &ENGINE_TEMP_FORMAT },
+};
+
+static constexpr WidgetSpec AERO_DAMAGE_SPECS[] = {
+  { FIELD_FRONT_LEFT_WING_DAMAGE, 240, 25, 70, 10, 240, 25, &AERO_DAMAGE_FORMAT },
+  { FIELD_FRONT_RIGHT_WING_DAMAGE, 240, 37, 70, 10, 240, 37, &AERO_DAMAGE_FORMAT },
+  { FIELD_REAR_WING_DAMAGE, 240, 49, 70, 10, 240, 49, &AERO_DAMAGE_FORMAT },
+  { FIELD_FLOOR_DAMAGE, 240, 61, 70, 10, 240, 61, &AERO_DAMAGE_FORMAT },
+  { FIELD_DIFFUSER_DAMAGE, 240, 73, 70, 10, 240, 73, &AERO_DAMAGE_FORMAT },
+  { FIELD_SIDEPOD_DAMAGE, 240, 85, 70, 10, 240, 85, &AERO_DAMAGE_FORMAT },
+};
+
+static constexpr WidgetSpec COMPONENT_WEAR_SPECS[] = {
+  { FIELD_GEARBOX_DAMAGE, 70, 130, 240, 10, 230, 130, &COMPONENT_WEAR_FORMAT },
+  { FIELD_ENGINE_ICE_WEAR, 70, 145, 240, 10, 230, 145, &COMPONENT_WEAR_FORMAT },
+  { FIELD_ENGINE_MGUH_WEAR, 70, 160, 240, 10, 230, 160, &COMPONENT_WEAR_FORMAT },
+  { FIELD_ENGINE_MGUK_WEAR, 70, 175, 240, 10, 230, 175, &COMPONENT_WEAR_FORMAT },
+  { FIELD_ENGINE_TC_WEAR, 70, 190, 240, 10, 230, 190, &COMPONENT_WEAR_FORMAT },
+  { FIELD_ENGINE_ES_WEAR, 70, 205, 240, 10, 230, 205, &COMPONENT_WEAR_FORMAT },
+  { FIELD_ENGINE_CE_WEAR, 70, 220, 240, 10, 230, 220, &COMPONENT_WEAR_FORMAT },
+};
+
+// SESSION INFO
+static constexpr ValueFormat WEATHER_FORMAT = ValueFormat(1, COLOR_WHITE).enumerated(WEATHER_LABELS);
+static constexpr ValueFormat TRACK_TEMP_FORMAT = ValueFormat(1, COLOR_GREEN).text("", "C").band(31, COLOR_YELLOW, 41, COLOR_RED);
+static constexpr ValueFormat AIR_TEMP_FORMAT = ValueFormat(1, COLOR_GREEN).text("", "C").band(26, COLOR_YELLOW, 36, COLOR_RED);
+static constexpr ValueFormat SESSION_TYPE_FORMAT = ValueFormat(1, COLOR_MAGENTA).enumerated(SESSION_TYPE_LABELS);
+static constexpr ValueFormat SAFETY_CAR_FORMAT = ValueFormat(1, COLOR_GREEN).enumerated(SAFETY_CAR_LABELS);
+static constexpr ValueFormat SESSION_SECTOR_FORMAT = ValueFormat(1, COLOR_CYAN, 3).text("", "s").scaled(0.001f).valid(0);
+static constexpr ValueFormat FUEL_STATUS_FORMAT =
+  ValueFormat(1, COLOR_RED, 1).text("", " laps").band(3, COLOR_YELLOW, 5, COLOR_GREEN).bar(150, 8, 0, 20);
+static constexpr ValueFormat TYRE_STATUS_FORMAT =
+  ValueFormat(1, COLOR_GREEN).text("", " laps").band(16, COLOR_YELLOW, 26, COLOR_RED).bar(150, 8, 0, 30);
+static constexpr ValueFormat ENGINE_STATUS_FORMAT =
+  ValueFormat(1, COLOR_GREEN).text("", "C").band(140, COLOR_YELLOW, 160, COLOR_RED).bar(150, 8, 80, 180);
+
+static constexpr WidgetSpec SESSION_SECTOR_SPECS[] = {
+  { FIELD_SECTOR1_TIME, 165, 115, 145, 10, 165, 115, &SESSION_SECTOR_FORMAT },
+  { FIELD_SECTOR2_TIME, 165, 137, 145, 10, 165, 137, &SESSION_SECTOR_FORMAT },
+};
+
+static constexpr WidgetSpec SESSION_STATUS_SPECS[] = {
+  { FIELD_SAFETY_CAR_STATUS, 190, 61, 120, 10, 210, 61, &SAFETY_CAR_FORMAT },
+  { FIELD_FUEL_REMAINING_LAPS, 55, 181, 255, 10, 210, 181, &FUEL_STATUS_FORMAT },
+  { FIELD_TYRES_AGE_LAPS, 55, 196, 255, 10, 210, 196, &TYRE_STATUS_FORMAT },
+  { FIELD_ENGINE_TEMP, 55, 211, 255, 10, 210, 211, &ENGINE_STATUS_FORMAT },
+};
+
+static constexpr WidgetSpec SESSION_CONDITION_SPECS[] = {
+  { FIELD_WEATHER, 70, 25, 80, 10, 70, 25, &WEATHER_FORMAT },
+  { FIELD_TRACK_TEMPERATURE, 70, 40, 80, 10, 70, 40, &TRACK_TEMP_FORMAT },
+  { FIELD_AIR_TEMPERATURE, 70, 55, 80, 10, 70, 55, &AIR_TEMP_FORMAT },
+  { FIELD_SESSION_TYPE, 210, 25, 100, 10, 210, 25, &SESSION_TYPE_FORMAT },
+};
+
+// INPUT TRACE - current values in the fixed label area beside each lane
+static constexpr ValueFormat INPUT_FORMAT = ValueFormat(1, COLOR_WHITE).text("", "%").scaled(100.0f);
+
+static constexpr WidgetSpec INPUT_TRACE_SPECS[] = {
+  { FIELD_THROTTLE, 2, 20, 36, 10, 4, 20, &INPUT_FORMAT },
+  { FIELD_BRAKE, 2, 100, 36, 10, 4, 100, &INPUT_FORMAT },
+  { FIELD_STEER, 2, 180, 36, 10, 4, 180, &INPUT_FORMAT },
+};
+
+static constexpr ValueFormat GFORCE_FORMAT = ValueFormat(2, COLOR_WHITE, 1);
+
+static constexpr WidgetSpec GFORCE_SPECS[] = {
+  { FIELD_G_FORCE_LATERAL, 256, 132, 58, 20, 258, 134, &GFORCE_FORMAT },
+  { FIELD_G_FORCE_LONGITUDINAL, 256, 162, 58, 20, 258, 164, &GFORCE_FORMAT },
+  { FIELD_G_FORCE_VERTICAL, 256, 192, 58, 20, 258, 194, &GFORCE_FORMAT },
+};
+
+// STRATEGY - fuel panel under the fitted tyre
+static constexpr ValueFormat FUEL_BURN_FORMAT = ValueFormat(2, COLOR_WHITE, 2).text("", "kg").valid(0.0f);
+static constexpr ValueFormat FUEL_FINISH_FORMAT =
+  ValueFormat(2, COLOR_RED, 1).text("", "kg").valid(FUEL_NO_ESTIMATE).band(0.0f, COLOR_YELLOW, 0.5f, COLOR_GREEN);
+static constexpr ValueFormat FUEL_SAVE_FORMAT =
+  ValueFormat(2, COLOR_GREEN, 2).text("", "kg").valid(FUEL_NO_ESTIMATE).band(0.01f, COLOR_YELLOW, 0.2f, COLOR_RED);
+
+static constexpr WidgetSpec FUEL_SPECS[] = {
+  { FIELD_FUEL_BURN_PER_LAP, 206, 146, 108, 16, 208, 146, &FUEL_BURN_FORMAT },
+  { FIELD_FUEL_AT_FINISH, 206, 178, 108, 16, 208, 178, &FUEL_FINISH_FORMAT },
+  { FIELD_FUEL_SAVE_PER_LAP, 206, 210, 108, 16, 208, 210, &FUEL_SAVE_FORMAT },
+};
+
+// ============================================
+// WIDGET TABLES
+// ============================================
+// One entry per scheduled widget: either an update method for widgets
+// with their own drawing code, or a table of value widgets. Each has a
+// priority, a minimum interval between redraws and the fields that make
+// it dirty (taken from the specs for value tables).
+#define WIDGET(method, priority, intervalMS, ...) \
+  { #method, &TelemetryView::method, TelemetryView::priority, intervalMS, { __VA_ARGS__, FIELD_COUNT }, NULL, 0 }
+#define VALUES(specs, priority, intervalMS) \
+  { #specs, NULL, TelemetryView::priority, intervalMS, { FIELD_COUNT }, specs, sizeof(specs) / sizeof(specs[0]) }
+
+static const TelemetryView::Widget GENERAL_WIDGETS[] = {
+  WIDGET(updateGear, PRIORITY_CRITICAL, 0, FIELD_GEAR),
+  WIDGET(updateSpeed, PRIORITY_CRITICAL, 0, FIELD_SPEED),
+  WIDGET(updateThrottle, PRIORITY_CRITICAL, 0, FIELD_THROTTLE),
+  WIDGET(updateBrake, PRIORITY_CRITICAL, 0, FIELD_BRAKE),
+  WIDGET(updateDeltaLive, PRIORITY_CRITICAL, 0, FIELD_DELTA_LIVE),
+  VALUES(GENERAL_CRITICAL_SPECS, PRIORITY_CRITICAL, 0),
+  VALUES(GENERAL_RACE_SPECS, PRIORITY_HIGH, 100),
+  WIDGET(updateDeltaLeader, PRIORITY_HIGH, 100, FIELD_DELTA_TO_RACE_LEADER),
+  WIDGET(updateCurrentLapTime, PRIORITY_HIGH, 0, FIELD_LIVE_LAP_TIME),
+  WIDGET(updateLastLapTime, PRIORITY_HIGH, 100, FIELD_LAST_LAP_TIME),
+  WIDGET(updateERSEnergy, PRIORITY_HIGH, 100, FIELD_ERS_STORE_ENERGY),
+  VALUES(GENERAL_SETUP_SPECS, PRIORITY_NORMAL, 250),
+};
+
+static const TelemetryView::Widget TYRE_WIDGETS[] = {
+  VALUES(TYRE_TEMP_SPECS, PRIORITY_NORMAL, 250),
+  VALUES(TYRE_WEAR_SPECS, PRIORITY_LOW, 1000),
+  WIDGET(updateTyreDegradation, PRIORITY_LOW, 1000, FIELD_TYRE_DEGRADATION),
+};
+
+static const TelemetryView::Widget CAR_WIDGETS[] = {
+  VALUES(POWER_UNIT_SPECS, PRIORITY_NORMAL, 250),
+  WIDGET(updatePowerUnitFaults, PRIORITY_NORMAL, 250, FIELD_DRS_FAULT, FIELD_ERS_FAULT),
+  VALUES(AERO_DAMAGE_SPECS, PRIORITY_LOW, 1000),
+  VALUES(COMPONENT_WEAR_SPECS, PRIORITY_LOW, 1000),
+};
+
+static const TelemetryView::Widget SESSION_WIDGETS[] = {
+  WIDGET(updateLapInfo, PRIORITY_HIGH, 100, FIELD_CURRENT_LAP_NUM, FIELD_TOTAL_LAPS),
+  WIDGET(updateBestLap, PRIORITY_HIGH, 100, FIELD_BEST_LAP_TIME),
+  WIDGET(updateLastLap, PRIORITY_HIGH, 100, FIELD_LAST_LAP_TIME),
+  VALUES(SESSION_SECTOR_SPECS, PRIORITY_HIGH, 100),
+  VALUES(SESSION_STATUS_SPECS, PRIORITY_NORMAL, 250),
+  VALUES(SESSION_CONDITION_SPECS, PRIORITY_LOW, 1000),
+  WIDGET(updateSessionTimeLeft, PRIORITY_LOW, 1000, FIELD_SESSION_TIME_LEFT),
+  WIDGET(updateDamageStatus, PRIORITY_LOW, 1000,
+         FIELD_FRONT_LEFT_WING_DAMAGE, FIELD_FRONT_RIGHT_WING_DAMAGE, FIELD_FLOOR_DAMAGE, FIELD_DIFFUSER_DAMAGE),
+};
+
+static const TelemetryView::Widget INPUT_TRACE_WIDGETS[] = {
+  WIDGET(updateInputTrace, PRIORITY_CRITICAL, 0, FIELD_INPUT_SAMPLES),
+  VALUES(INPUT_TRACE_SPECS, PRIORITY_NORMAL, 100),
+};
+
+static const TelemetryView::Widget TRACK_MAP_WIDGETS[] = {
+  WIDGET(updateTrackMap, PRIORITY_HIGH, 0, FIELD_MOTION_FRAMES, FIELD_TRACK_MAP_VERSION, FIELD_TRACK_MAP_PROGRESS),
+  WIDGET(updateGForce, PRIORITY_HIGH, 0, FIELD_GFORCE_SAMPLES),
+  VALUES(GFORCE_SPECS, PRIORITY_NORMAL, 100),
+};
+
+static const TelemetryView::Widget LAP_HISTORY_WIDGETS[] = {
+  WIDGET(updateLapHistory, PRIORITY_LOW, 500, FIELD_LAP_HISTORY),
+  WIDGET(updateLapConsistency, PRIORITY_LOW, 500, FIELD_LAP_HISTORY),
+};
+
+static const TelemetryView::Widget STRATEGY_WIDGETS[] = {
+  WIDGET(updateFittedTyre, PRIORITY_NORMAL, 250, FIELD_VISUAL_TYRE_COMPOUND, FIELD_TYRES_AGE_LAPS),
+  WIDGET(updateTyreSets, PRIORITY_LOW, 500, FIELD_TYRE_SETS),
+  WIDGET(updateTyreSuggestions, PRIORITY_LOW, 500, FIELD_TYRE_SETS),
+  VALUES(FUEL_SPECS, PRIORITY_NORMAL, 250),
+  WIDGET(updateStrategyPlan, PRIORITY_LOW, 500, FIELD_STRATEGY_PLAN, FIELD_PIT_LOSS, FIELD_PIT_WINDOW_IDEAL_LAP),
+};
+
+#undef WIDGET
+#undef VALUES
+
+struct ScreenWidgets {
+  const TelemetryView::Widget* widgets;
+  uint8_t count;
+};
+
+// Checks every screen's table against the per-screen state arrays.
+template <size_t N>
+constexpr uint8_t screenWidgetCount(const TelemetryView::Widget (&)[N]) {
+  static_assert(N <= TelemetryView::MAX_SCREEN_WIDGETS, "raise MAX_SCREEN_WIDGETS");
+  return N;
+}
+
+#define SCREEN_WIDGETS_ENTRY(list) { list, screenWidgetCount(list) }
+static const ScreenWidgets SCREEN_WIDGETS[TelemetryView::SCREEN_COUNT] = {
+  SCREEN_WIDGETS_ENTRY(GENERAL_WIDGETS),
+  SCREEN_WIDGETS_ENTRY(TYRE_WIDGETS),
+  SCREEN_WIDGETS_ENTRY(CAR_WIDGETS),
+  SCREEN_WIDGETS_ENTRY(SESSION_WIDGETS),
+  SCREEN_WIDGETS_ENTRY(INPUT_TRACE_WIDGETS),
+  SCREEN_WIDGETS_ENTRY(TRACK_MAP_WIDGETS),
+  SCREEN_WIDGETS_ENTRY(LAP_HISTORY_WIDGETS),
+  SCREEN_WIDGETS_ENTRY(STRATEGY_WIDGETS),
+};
+#undef SCREEN_WIDGETS_ENTRY
+
+static bool widgetIsDirty(const TelemetryView::Widget& widget, const DirtyMask& dirty) {
+  for (uint8_t i = 0; i < widget.specCount; i++) {
+    if (dirty.test(widget.specs[i].field)) return true;
+  }
+  for (uint8_t i = 0; i < TelemetryView::WIDGET_MAX_FIELDS && widget.fields[i] != FIELD_COUNT; i++) {
+    if (dirty.test(widget.fields[i])) return true;
+  }
+  return false;
+}
+
 // ============================================
 // RENDER - Main Loop
 // ============================================
-void TelemetryView::render() {
+// Pulls the cached packet groups the current screen reads; groups no
+// widget shows are never decoded.
+void TelemetryView::refreshVisibleData() {
   switch (currentScreen) {
     case SCREEN_GENERAL:
-      if (screenChanged) {
-        drawGeneralScreen();
-        resetGeneralDirtyTracking();
-        screenChanged = false;
-      }
-      updatePosition();
-      updateDeltaFront();
-      updateDeltaLeader();
-      updateDeltaLive();
-      updateLastLapTime();
-      updateCurrentLapTime();
-      updateSector1();
-      updateSector2();
-      updateCurrentLapNum();
-      updateCornerCuttingWarnings();
-      updateSpeed();
-      updateThrottle();
-      updateBrake();
-      updateGear();
-      updateRPM();
-      updateDRS();
-      updateRevLights();
-      updateSuggestedGear();
-      updateFrontBrakeBias();
-      updateDiffOnThrottle();
-      updateFuelInTank();
-      updateFuelRemainingLaps();
-      updateERSEnergy();
-      updateERSMode();
+      model->refresh(PACKET_ID_CAR_SETUPS);
+      model->refresh(PACKET_ID_CAR_STATUS);
       break;
 
     case SCREEN_TYRE_INFO:
-      if (screenChanged) {
-        drawTyreInfoScreen();
-        resetTyreInfoDirtyTracking();
-        screenChanged = false;
-      }
-      updateTyresAgeLaps();
-      updateBrakeTemps();
-      updateTyreSurfaceTemps();
-      updateTyreInnerTemps();
-      updateTyrePressures();
-      updateTyreWear();
-      updateTyreDamage();
-      updateBrakeDamage();
-      break;
-
     case SCREEN_CAR_INFO:
-      if (screenChanged) {
-        drawCarInfoScreen();
-        resetCarInfoDirtyTracking();
-        screenChanged = false;
-      }
-      updatePowerUnit();
-      updateAeroDamage();
-      updateComponentWear();
+      model->refresh(PACKET_ID_CAR_STATUS);
+      model->refresh(PACKET_ID_CAR_DAMAGE);
       break;
 
     case SCREEN_SESSION_INFO:
-      if (screenChanged) {
-        drawSessionInfoScreen();
-        resetSessionInfoDirtyTracking();
-        screenChanged = false;
+      model->refresh(PACKET_ID_SESSION);
+      model->refresh(PACKET_ID_CAR_STATUS);
+      model->refresh(PACKET_ID_CAR_DAMAGE);
+      break;
+
+    case SCREEN_INPUT_TRACE:
+      // Telemetry is decoded on arrival.
+      break;
+
+    case SCREEN_TRACK_MAP:
+      // Motion reads the track ID itself.
+      break;
+
+    case SCREEN_LAP_HISTORY:
+      // Session history is ingested on arrival.
+      break;
+
+    case SCREEN_STRATEGY:
+      model->refresh(PACKET_ID_CAR_STATUS);
+      model->refresh(PACKET_ID_TYRE_SETS);
+      break;
+  }
+}
+
+void TelemetryView::render() {
+  TRACE_SCOPE(TRACE_RENDER);
+  refreshVisibleData();
+
+#if ENABLE_TRACE && ENABLE_TRACE_OVERLAY
+  bool overlayDue = screenChanged || trace.getWindow() != drawnTraceWindow;
+#else
+  bool overlayDue = false;
+#endif
+  // The banner covers parts of several widgets; redrawing the screen is
+  // the simplest restore, and events are rare.
+  if (bannerState == BANNER_SHOWN && millis() - bannerStartMS >= EVENT_BANNER_MS) {
+    bannerState = BANNER_IDLE;
+    screenChanged = true;
+    lastLedsOn = 255;
+  }
+
+  bool heldDue = widgetsHeld && (int32_t)(millis() - heldWidgetMS) >= 0;
+  if (!screenChanged && !model->hasDirtyFields() && dueWidgets == 0 && !heldDue && !overlayDue &&
+      bannerState != BANNER_PENDING) {
+    return;
+  }
+  TRACE_COUNT(countFrame);
+
+  DirtyMask dirty = model->consumeDirtyFields();
+  uint32_t frameStart = micros();
+  compositor.resetStats();
+  bus->resetStats();
+
+  if (screenChanged) {
+    uint32_t switchStart = micros();
+    inputTrace.deactivate();
+#if ENABLE_BACKGROUND_CACHE
+    bool restored = backgrounds.restore(currentScreen, bus);
+#else
+    bool restored = false;
+#endif
+    if (!restored) {
+      gfx = panel;
+      drawScreenLayout(currentScreen);
+    }
+    if (currentScreen == SCREEN_INPUT_TRACE) {
+      inputTrace.activate(*model);
+    }
+    uint32_t switchMicros = micros() - switchStart;
+    renderStats[currentScreen].switches++;
+    renderStats[currentScreen].switchMicros += switchMicros;
+    if (switchMicros > renderStats[currentScreen].maxSwitchMicros) {
+      renderStats[currentScreen].maxSwitchMicros = switchMicros;
+    }
+
+    dirty.setAll();
+    drawnThrottleHeight = -1;
+    drawnBrakeHeight = -1;
+    drawnERSWidth = -1;
+    gForceTrailDrawn = false;
+    resetWidgetState();
+    screenChanged = false;
+  }
+
+  runWidgets(dirty, frameStart);
+  // Widgets under the banner may have just drawn over it. A flush sends
+  // tiles in scanline order, which would put one starting at y=1 after
+  // the banner at y=0, so theirs go out first.
+  if (bannerState != BANNER_IDLE) {
+    compositor.flush();
+    drawEventBanner();
+  }
+  updateLEDs(dirty);
+#if ENABLE_TRACE && ENABLE_TRACE_OVERLAY
+  // The same goes for the bars under the overlay.
+  if (overlayDue) {
+    compositor.flush();
+    drawTraceOverlay();
+  }
+#endif
+  compositor.flush();
+
+  RenderStats& stats = renderStats[currentScreen];
+  const Compositor::Stats& frame = compositor.getStats();
+  uint32_t frameMicros = micros() - frameStart;
+  stats.frames++;
+  stats.totalMicros += frameMicros;
+  if (frameMicros > stats.maxMicros) stats.maxMicros = frameMicros;
+  stats.busWaitMicros += bus->getStats().waitMicros;
+  stats.pushedBytes += frame.bytes;
+  stats.directBytes += compositor.getSprite().getDirectBytes();
+  stats.tiles += frame.tiles;
+  stats.regions += frame.regions;
+  stats.transactions += frame.transactions;
+  stats.directWindows += compositor.getSprite().getDirectWindows();
+}
+
+// ============================================
+// WIDGET SCHEDULER
+// ============================================
+
+void TelemetryView::resetWidgetState() {
+  uint32_t now = micros();
+  for (uint8_t i = 0; i < MAX_SCREEN_WIDGETS; i++) {
+    widgetState[i].pending.setAll();
+    widgetState[i].due = true;
+    widgetState[i].dueSince = now;
+    // Far enough back that no rate limit applies.
+    widgetState[i].lastRunMS = millis() - 0x10000UL;
+  }
+  dueWidgets = SCREEN_WIDGETS[currentScreen].count;
+  widgetsHeld = false;
+}
+
+// Runs due widgets in priority order, oldest first within a priority.
+// Non-critical widgets are skipped once the next one's usual cost would
+// overrun the frame budget, unless they have been starved too long.
+void TelemetryView::runWidgets(const DirtyMask& dirty, uint32_t frameStart) {
+  const ScreenWidgets& screen = SCREEN_WIDGETS[currentScreen];
+  WidgetStats* stats = widgetStats[currentScreen];
+  uint32_t nowMS = millis();
+
+  uint8_t order[MAX_SCREEN_WIDGETS];
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < screen.count; i++) {
+    WidgetState& state = widgetState[i];
+    if (widgetIsDirty(screen.widgets[i], dirty)) {
+      if (!state.due) {
+        state.due = true;
+        state.dueSince = frameStart;
       }
-      updateWeather();
-      updateTrackTemp();
-      updateAirTemp();
-
-      updateSessionType();
-      updateLapInfo();
-      updateSessionTimeLeft();
-      updateSafetyCarStatus();
-
-      updateBestLap();
-      updateLastLap();
-      updateSectorTimes();
-
-      updateFuelStatus();
-      updateTyreStatus();
-      updateEngineStatus();
-      updateDamageStatus();
+      state.pending.merge(dirty);
+    }
+    if (!state.due) continue;
+    if (nowMS - state.lastRunMS < screen.widgets[i].minIntervalMS) continue;
+
+    uint8_t j = count++;
+    while (j > 0) {
+      const WidgetState& prev = widgetState[order[j - 1]];
+      uint8_t prevPriority = screen.widgets[order[j - 1]].priority;
+      uint8_t priority = screen.widgets[i].priority;
+      if (prevPriority < priority || (prevPriority == priority && (int32_t)(prev.dueSince - state.dueSince) <= 0)) break;
+      order[j] = order[j - 1];
+      j--;
+    }
+    order[j] = i;
+  }
+
+  for (uint8_t k = 0; k < count; k++) {
+    uint8_t i = order[k];
+    const Widget& widget = screen.widgets[i];
+    WidgetState& state = widgetState[i];
+    WidgetStats& stat = stats[i];
+
+    uint32_t start = micros();
+    if (widget.priority != PRIORITY_CRITICAL && start - frameStart + stat.costMicros > RENDER_BUDGET_MICROS &&
+        start - state.dueSince < RENDER_STARVATION_MS * 1000UL) {
+      stat.deferrals++;
+      continue;
+    }
+
+    if (widget.update) {
+      (this->*widget.update)(state.pending);
+    } else {
+      for (uint8_t n = 0; n < widget.specCount; n++) {
+        if (state.pending.test(widget.specs[n].field)) drawSpec(widget.specs[n]);
+      }
+    }
+
+    uint32_t end = micros();
+    uint32_t cost = end - start;
+    stat.costMicros = stat.runs == 0 ? cost : (stat.costMicros * 7 + cost) / 8;
+    uint32_t latency = end - state.dueSince;
+    stat.runs++;
+    stat.totalLatencyMicros += latency;
+    if (latency > stat.maxLatencyMicros) stat.maxLatencyMicros = latency;
+
+    state.pending.clear();
+    state.due = false;
+    state.lastRunMS = nowMS;
+  }
+
+  dueWidgets = 0;
+  widgetsHeld = false;
+  for (uint8_t i = 0; i < screen.count; i++) {
+    const WidgetState& state = widgetState[i];
+    if (!state.due) continue;
+    uint32_t readyMS = state.lastRunMS + screen.widgets[i].minIntervalMS;
+    if ((int32_t)(readyMS - nowMS) <= 0) {
+      dueWidgets++;
+    } else if (!widgetsHeld || (int32_t)(readyMS - heldWidgetMS) < 0) {
+      widgetsHeld = true;
+      heldWidgetMS = readyMS;
+    }
+  }
+}
+
+void TelemetryView::printWidgetStats(Print& out) {
+  const ScreenWidgets& screen = SCREEN_WIDGETS[currentScreen];
+  const WidgetStats* stats = widgetStats[currentScreen];
+
+  out.println("Widget                       pri   runs  defer  avg_lat_us  max_lat_us  cost_us");
+  for (uint8_t i = 0; i < screen.count; i++) {
+    const WidgetStats& stat = stats[i];
+    out.printf("%-28s %3u %6lu %6lu %11lu %11lu %8u\n", screen.widgets[i].name, screen.widgets[i].priority,
+               (unsigned long)stat.runs, (unsigned long)stat.deferrals,
+               (unsigned long)(stat.runs ? stat.totalLatencyMicros / stat.runs : 0),
+               (unsigned long)stat.maxLatencyMicros, stat.costMicros);
+  }
+}
+
+// ============================================
+// WIDGET TILES
+// ============================================
+// Opens a widget region: widget code draws through gfx, which is a
+// compositor tile when the region fits, or the panel after a plain clear.
+// Tiles reach the panel at the next compositor flush.
+void TelemetryView::beginWidget(int16_t x, int16_t y, int16_t w, int16_t h) {
+#if ENABLE_SPRITES
+  gfx = compositor.beginTile(x, y, w, h);
+  if (gfx) return;
+#endif
+  panel->fillRect(x, y, w, h, COLOR_BLACK);
+  gfx = panel;
+}
+
+void TelemetryView::endWidget() {
+  if (gfx != panel) {
+    compositor.endTile();
+  }
+  gfx = panel;
+}
+
+// Renders one value widget: the field scaled and formatted, a label from
+// its enum table, or "--" outside the valid range; optionally with a bar.
+void TelemetryView::drawSpec(const WidgetSpec& spec) {
+  const ValueFormat& format = *spec.format;
+  float value = model->getFieldValue(spec.field) * format.scale;
+
+  char text[FORMAT_BUFFER_SIZE];
+  uint8_t length;
+  uint16_t color;
+  if (format.labels) {
+    int index = (int)value;
+    if (index < 0 || index >= format.labelCount - 1) index = format.labelCount - 1;
+    length = appendText(text, 0, format.labels[index].text);
+    color = format.labels[index].color;
+  } else if (value <= format.validAbove || value >= format.validBelow) {
+    length = appendText(text, 0, "--");
+    color = COLOR_DARKGREY;
+  } else {
+    // Whole numbers truncate, as the widgets always have.
+    int32_t fixed = format.decimals > 0 ? toFixed(value, format.decimals) : (int32_t)value;
+    length = appendText(text, 0, format.prefix);
+    length += formatFixed(text + length, fixed, format.decimals);
+    length = appendText(text, length, format.suffix);
+    color = format.colorFor(value);
+  }
+
+  beginWidget(spec.x, spec.y, spec.w, spec.h);
+
+  if (format.barWidth > 0) {
+    int16_t barY = spec.y + (spec.h - format.barHeight) / 2;
+    gfx->drawRect(spec.x, barY, format.barWidth, format.barHeight, COLOR_DARKGREY);
+
+    float fraction = (value - format.barMin) / (format.barMax - format.barMin);
+    if (fraction < 0.0f) fraction = 0.0f;
+    if (fraction > 1.0f) fraction = 1.0f;
+    int16_t fill = (int16_t)(fraction * (format.barWidth - 2));
+    if (fill > 0) {
+      gfx->fillRect(spec.x + 1, barY + 1, fill, format.barHeight - 2, color);
+    }
+  }
+
+  int16_t textX = spec.textX;
+  if (textX == TEXT_CENTER) {
+    textX = spec.x + (spec.w - textWidth(length, format.textSize)) / 2;
+  }
+  drawGlyphText(gfx, textX, spec.textY, text, format.textSize, color);
+  endWidget();
+}
+
+// ============================================
+// EVENT BANNER
+// ============================================
+struct BannerStyle {
+  const char* text;
+  uint16_t background;
+  uint16_t textColor;
+  uint8_t red, green, blue;  // LED strip while the banner shows
+};
+
+static const BannerStyle BANNER_STYLES[EVENT_TYPE_COUNT] = {
+  { "FASTEST ", COLOR_MAGENTA, COLOR_WHITE, 160, 0, 255 },
+  { "PENALTY", COLOR_ORANGE, COLOR_BLACK, 255, 100, 0 },
+  { "DRS ENABLED", COLOR_GREEN, COLOR_BLACK, 0, 255, 0 },
+  { "DRS DISABLED", COLOR_DARKGREY, COLOR_WHITE, 40, 40, 40 },
+  { "SAFETY CAR", COLOR_YELLOW, COLOR_BLACK, 255, 200, 0 },
+  { "FLASHBACK", COLOR_BLUE, COLOR_WHITE, 0, 0, 255 },
+  { "RED FLAG", COLOR_RED, COLOR_WHITE, 255, 0, 0 },
+  { "CHEQUERED FLAG", COLOR_WHITE, COLOR_BLACK, 255, 255, 255 },
+};
+
+void TelemetryView::showEvent(const RaceEvent& event) {
+  bannerEvent = event;
+  bannerState = BANNER_PENDING;
+}
+
+// Redrawn on every render while shown, so widgets updating underneath
+// cannot leave holes in it. The LED cue is set once, when it appears.
+void TelemetryView::drawEventBanner() {
+  const BannerStyle& style = BANNER_STYLES[bannerEvent.type];
+
+  if (bannerState == BANNER_PENDING) {
+    bannerState = BANNER_SHOWN;
+    bannerStartMS = millis();
+    for (uint8_t i = 0; i < NUM_LEDS; i++) {
+      pixels->setPixelColor(i, pixels->Color(style.red, style.green, style.blue));
+    }
+    pixels->show();
+  }
+  // Across a hardware-scrolled plot the banner would scroll with it.
+  if (inputTrace.isActive()) return;
+
+  char text[FORMAT_BUFFER_SIZE];
+  uint8_t length = appendText(text, 0, style.text);
+  switch (bannerEvent.type) {
+    case EVENT_FASTEST_LAP: {
+      // "FASTEST VER 1:23.456", or "FASTEST LAP ..." before names arrive.
+      const char* code = model->getParticipants().getCode(bannerEvent.vehicleIdx);
+      length = appendText(text, length, code[0] != '\0' ? code : "LAP");
+      length = appendText(text, length, " ");
+      length += formatLapTime(text + length, bannerEvent.value);
       break;
+    }
+    case EVENT_PENALTY:
+      if (bannerEvent.detail > 0) {
+        length = appendText(text, length, " +");
+        length += formatFixed(text + length, bannerEvent.detail, 0);
+        length = appendText(text, length, "S");
+      }
+      break;
+    case EVENT_SAFETY_CAR:
+      if (bannerEvent.detail == 2) length = appendText(text, 0, "VIRTUAL SC");
+      if (bannerEvent.detail == 3) length = appendText(text, 0, "FORMATION LAP");
+      if (bannerEvent.phase == 1) length = appendText(text, length, " ENDING");
+      break;
+    default:
+      break;
+  }
+
+  beginWidget(0, 0, SCREEN_WIDTH, 20);
+  gfx->fillRect(0, 0, SCREEN_WIDTH, 20, style.background);
+  drawGlyphText(gfx, (SCREEN_WIDTH - textWidth(length, 2)) / 2, 2, text, 2, style.textColor);
+  endWidget();
+}
+
+#if ENABLE_TRACE && ENABLE_TRACE_OVERLAY
+// One line over the bottom edge of every screen, refreshed once a second
+// when the trace publishes new rates. Widgets underneath can draw over it
+// until then.
+void TelemetryView::drawTraceOverlay() {
+  struct Item {
+    const char* label;
+    int32_t value;
+    uint8_t decimals;
+    const char* suffix;
+  };
+  const Trace::Rates& rates = trace.getRates();
+  const Item items[] = {
+    { "FPS ", rates.framesPerSecond, 0, "" },
+    { "PKT ", rates.packetsPerSecond, 0, "/s" },
+    { "DROP ", rates.drops, 0, "" },
+    { "RND ", (int32_t)((rates.renderMicros + 50) / 100), 1, "ms" },
+  };
+  drawnTraceWindow = trace.getWindow();
+  // Across a hardware-scrolled plot the strip would scroll with it.
+  if (inputTrace.isActive()) return;
+
+  const int16_t y = SCREEN_HEIGHT - 10;
+  beginWidget(0, y, SCREEN_WIDTH, 10);
+  gfx->fillRect(0, y, SCREEN_WIDTH, 10, COLOR_BLACK);
+  int16_t x = 2;
+  for (uint8_t i = 0; i < sizeof(items) / sizeof(items[0]); i++) {
+    char text[FORMAT_BUFFER_SIZE];
+    uint8_t length = appendText(text, 0, items[i].label);
+    length += formatFixed(text + length, items[i].value, items[i].decimals);
+    appendText(text, length, items[i].suffix);
+    x = drawGlyphText(gfx, x, y + 1, text, 1, COLOR_YELLOW) + 12;
+  }
+  endWidget();
+}
+#endif
+
+void TelemetryView::printRenderStats(Print& out) {
+  static const char* const names[SCREEN_COUNT] = { "GENERAL", "TYRES", "CAR", "SESSION", "INPUTS", "MAP", "HISTORY", "STRATEGY" };
+
+  out.println("Screen   frames  avg_us  max_us  wait_us   spi_B  direct_B  tiles  windows  tx  direct_windows  (per frame)");
+  for (uint8_t i = 0; i < SCREEN_COUNT; i++) {
+    const RenderStats& stats = renderStats[i];
+    if (stats.frames == 0) continue;
+
+    uint32_t frames = stats.frames;
+    out.printf("%-8s %6lu %7lu %7lu %8lu %7lu %9lu %6lu %8lu %3lu %15lu\n", names[i], (unsigned long)frames,
+               (unsigned long)(stats.totalMicros / frames), (unsigned long)stats.maxMicros,
+               (unsigned long)(stats.busWaitMicros / frames), (unsigned long)(stats.pushedBytes / frames),
+               (unsigned long)(stats.directBytes / frames), (unsigned long)(stats.tiles / frames),
+               (unsigned long)(stats.regions / frames), (unsigned long)(stats.transactions / frames),
+               (unsigned long)(stats.directWindows / frames));
+  }
+
+  out.println("Screen   switches  avg_switch_us  max_switch_us  background_B");
+  for (uint8_t i = 0; i < SCREEN_COUNT; i++) {
+    const RenderStats& stats = renderStats[i];
+    if (stats.switches == 0) continue;
+
+#if ENABLE_BACKGROUND_CACHE
+    uint16_t backgroundBytes = backgrounds.size(i);
+#else
+    uint16_t backgroundBytes = 0;
+#endif
+    out.printf("%-8s %8lu %14lu %14lu %13u\n", names[i], (unsigned long)stats.switches,
+               (unsigned long)(stats.switchMicros / stats.switches), (unsigned long)stats.maxSwitchMicros,
+               backgroundBytes);
+  }
+
+  const InputTrace::Stats& inputStats = inputTrace.getStats();
+  if (inputStats.samples > 0) {
+    out.printf("Input trace: %lu samples, %lu px/sample, %lu scrolls (full plot %d px)\n", (unsigned long)inputStats.samples,
+               (unsigned long)(inputStats.pixels / inputStats.samples), (unsigned long)inputStats.scrolls,
+               InputTrace::PLOT_WIDTH * SCREEN_HEIGHT);
   }
-  updateLEDs();
 }
 
 void TelemetryView::drawLayout() {
@@ -247,775 +909,547 @@ void TelemetryView::drawLayout() {
 }
 
 void TelemetryView::nextScreen() {
-  currentScreen = (Screen)((currentScreen + 1) % 4);
+  currentScreen = (Screen)((currentScreen + 1) % SCREEN_COUNT);
   screenChanged = true;
 }
 
 // ============================================
 // SCREEN DRAWING METHODS
 // ============================================
+// Layouts draw through gfx: the panel, or a background capture band.
+
+void TelemetryView::drawScreenLayout(Screen screen) {
+  switch (screen) {
+    case SCREEN_GENERAL: drawGeneralScreen(); break;
+    case SCREEN_TYRE_INFO: drawTyreInfoScreen(); break;
+    case SCREEN_CAR_INFO: drawCarInfoScreen(); break;
+    case SCREEN_SESSION_INFO: drawSessionInfoScreen(); break;
+    case SCREEN_INPUT_TRACE: drawInputTraceScreen(); break;
+    case SCREEN_TRACK_MAP: drawTrackMapScreen(); break;
+    case SCREEN_LAP_HISTORY: drawLapHistoryScreen(); break;
+    case SCREEN_STRATEGY: drawStrategyScreen(); break;
+  }
+}
+
+// Renders every layout once into the background cache so screen
+// switches stream a stored image instead of redrawing.
+void TelemetryView::captureBackgrounds() {
+#if ENABLE_BACKGROUND_CACHE
+  for (uint8_t i = 0; i < SCREEN_COUNT; i++) {
+    backgrounds.beginCapture(i);
+    while ((gfx = backgrounds.nextBand()) != NULL) {
+      drawScreenLayout((Screen)i);
+    }
+    backgrounds.endCapture();
+  }
+  gfx = panel;
+#endif
+}
 
 void TelemetryView::drawGeneralScreen() {
-  tft->fillScreen(COLOR_BLACK);
+  gfx->fillScreen(COLOR_BLACK);
 
-  tft->drawRect(0, 0, 40, 240, COLOR_WHITE);
+  gfx->drawRect(0, 0, 40, 240, COLOR_WHITE);
 
-  tft->drawRect(280, 0, 40, 240, COLOR_WHITE);
+  gfx->drawRect(280, 0, 40, 240, COLOR_WHITE);
 
   for (int i = 0; i < 9; i++) {
-    tft->drawRect(42, i * 24, 68, 24, COLOR_WHITE);
+    gfx->drawRect(42, i * 24, 68, 24, COLOR_WHITE);
   }
 
-  tft->drawRect(112, 0, 76, 24, COLOR_WHITE);
-  tft->drawRect(112, 24, 76, 96, COLOR_WHITE);
-  tft->drawRect(112, 120, 76, 96, COLOR_WHITE);
+  gfx->drawRect(112, 0, 76, 24, COLOR_WHITE);
+  gfx->drawRect(112, 24, 76, 96, COLOR_WHITE);
+  gfx->drawRect(112, 120, 76, 96, COLOR_WHITE);
 
   for (int i = 0; i < 9; i++) {
-    tft->drawRect(190, i * 24, 88, 24, COLOR_WHITE);
+    gfx->drawRect(190, i * 24, 88, 24, COLOR_WHITE);
   }
 
-  tft->drawRect(42, 216, 236, 24, COLOR_WHITE);
+  gfx->drawRect(42, 216, 236, 24, COLOR_WHITE);
 }
 
 void TelemetryView::drawTyreInfoScreen() {
-  tft->fillScreen(COLOR_BLACK);
+  gfx->fillScreen(COLOR_BLACK);
 
-  tft->drawRect(0, 0, 320, 24, COLOR_WHITE);
+  gfx->drawRect(0, 0, 320, 24, COLOR_WHITE);
 
-  tft->drawRect(0, 24, 160, 108, COLOR_WHITE);
-  tft->drawRect(160, 24, 160, 108, COLOR_WHITE);
-  tft->drawRect(0, 132, 160, 108, COLOR_WHITE);
-  tft->drawRect(160, 132, 160, 108, COLOR_WHITE);
+  gfx->drawRect(0, 24, 160, 108, COLOR_WHITE);
+  gfx->drawRect(160, 24, 160, 108, COLOR_WHITE);
+  gfx->drawRect(0, 132, 160, 108, COLOR_WHITE);
+  gfx->drawRect(160, 132, 160, 108, COLOR_WHITE);
 
-  tft->setTextSize(1);
+  gfx->setTextSize(1);
 
-  tft->setTextColor(COLOR_CYAN);
-  tft->setCursor(30, 28);
-  tft->print("FRONT LEFT");
+  gfx->setTextColor(COLOR_CYAN);
+  gfx->setCursor(30, 28);
+  gfx->print("FRONT LEFT");
 
-  tft->setCursor(190, 28);
-  tft->print("FRONT RIGHT");
+  gfx->setCursor(190, 28);
+  gfx->print("FRONT RIGHT");
 
-  tft->setCursor(35, 136);
-  tft->print("REAR LEFT");
+  gfx->setCursor(35, 136);
+  gfx->print("REAR LEFT");
 
-  tft->setCursor(190, 136);
-  tft->print("REAR RIGHT");
+  gfx->setCursor(190, 136);
+  gfx->print("REAR RIGHT");
 }
 
 void TelemetryView::drawCarInfoScreen() {
-  tft->fillScreen(COLOR_BLACK);
-
-  tft->drawRect(2, 2, 156, 104, COLOR_CYAN);
-  tft->setTextSize(1);
-  tft->setTextColor(COLOR_CYAN);
-  tft->setCursor(40, 8);
-  tft->print("POWER UNIT");
-
-  tft->setTextColor(COLOR_DARKGREY);
-  tft->setCursor(8, 25);
-  tft->print("ICE:");
-  tft->setCursor(8, 40);
-  tft->print("MGU-K:");
-  tft->setCursor(8, 55);
-  tft->print("ERS:");
-  tft->setCursor(8, 70);
-  tft->print("TEMP:");
-  tft->setCursor(8, 85);
-  tft->print("STATUS:");
-
-  tft->drawRect(162, 2, 156, 104, COLOR_ORANGE);
-  tft->setTextColor(COLOR_ORANGE);
-  tft->setCursor(185, 8);
-  tft->print("AERODYNAMICS");
-
-  tft->setTextColor(COLOR_DARKGREY);
-  tft->setCursor(168, 25);
-  tft->print("Wing FL:");
-  tft->setCursor(168, 37);
-  tft->print("Wing FR:");
-  tft->setCursor(168, 49);
-  tft->print("Rear Wing:");
-  tft->setCursor(168, 61);
-  tft->print("Floor:");
-  tft->setCursor(168, 73);
-  tft->print("Diffuser:");
-  tft->setCursor(168, 85);
-  tft->print("Sidepod:");
-
-  tft->drawRect(2, 110, 316, 128, COLOR_MAGENTA);
-  tft->setTextColor(COLOR_MAGENTA);
-  tft->setCursor(70, 116);
-  tft->print("COMPONENT WEAR");
-
-  tft->setTextColor(COLOR_DARKGREY);
-  tft->setCursor(8, 130);
-  tft->print("Gearbox:");
-  tft->setCursor(8, 145);
-  tft->print("ICE:");
-  tft->setCursor(8, 160);
-  tft->print("MGU-H:");
-  tft->setCursor(8, 175);
-  tft->print("MGU-K:");
-  tft->setCursor(8, 190);
-  tft->print("TC:");
-  tft->setCursor(8, 205);
-  tft->print("ES:");
-  tft->setCursor(8, 220);
-  tft->print("CE:");
+  gfx->fillScreen(COLOR_BLACK);
+
+  gfx->drawRect(2, 2, 156, 104, COLOR_CYAN);
+  gfx->setTextSize(1);
+  gfx->setTextColor(COLOR_CYAN);
+  gfx->setCursor(40, 8);
+  gfx->print("POWER UNIT");
+
+  gfx->setTextColor(COLOR_DARKGREY);
+  gfx->setCursor(8, 25);
+  gfx->print("ICE:");
+  gfx->setCursor(8, 40);
+  gfx->print("MGU-K:");
+  gfx->setCursor(8, 55);
+  gfx->print("ERS:");
+  gfx->setCursor(8, 70);
+  gfx->print("TEMP:");
+  gfx->setCursor(8, 85);
+  gfx->print("STATUS:");
+
+  gfx->drawRect(162, 2, 156, 104, COLOR_ORANGE);
+  gfx->setTextColor(COLOR_ORANGE);
+  gfx->setCursor(185, 8);
+  gfx->print("AERODYNAMICS");
+
+  gfx->setTextColor(COLOR_DARKGREY);
+  gfx->setCursor(168, 25);
+  gfx->print("Wing FL:");
+  gfx->setCursor(168, 37);
+  gfx->print("Wing FR:");
+  gfx->setCursor(168, 49);
+  gfx->print("Rear Wing:");
+  gfx->setCursor(168, 61);
+  gfx->print("Floor:");
+  gfx->setCursor(168, 73);
+  gfx->print("Diffuser:");
+  gfx->setCursor(168, 85);
+  gfx->print("Sidepod:");
+
+  gfx->drawRect(2, 110, 316, 128, COLOR_MAGENTA);
+  gfx->setTextColor(COLOR_MAGENTA);
+  gfx->setCursor(70, 116);
+  gfx->print("COMPONENT WEAR");
+
+  gfx->setTextColor(COLOR_DARKGREY);
+  gfx->setCursor(8, 130);
+  gfx->print("Gearbox:");
+  gfx->setCursor(8, 145);
+  gfx->print("ICE:");
+  gfx->setCursor(8, 160);
+  gfx->print("MGU-H:");
+  gfx->setCursor(8, 175);
+  gfx->print("MGU-K:");
+  gfx->setCursor(8, 190);
+  gfx->print("TC:");
+  gfx->setCursor(8, 205);
+  gfx->print("ES:");
+  gfx->setCursor(8, 220);
+  gfx->print("CE:");
 }
 
 void TelemetryView::drawSessionInfoScreen() {
-  tft->fillScreen(COLOR_BLACK);
-
-  tft->drawRect(2, 2, 156, 75, COLOR_CYAN);
-  tft->setTextSize(1);
-  tft->setTextColor(COLOR_CYAN);
-  tft->setCursor(38, 8);
-  tft->print("CONDITIONS");
-
-  tft->setTextColor(COLOR_DARKGREY);
-  tft->setCursor(8, 25);
-  tft->print("Weather:");
-  tft->setCursor(8, 42);
-  tft->print("Track:");
-  tft->setCursor(8, 59);
-  tft->print("Air:");
-
-  tft->drawRect(162, 2, 156, 75, COLOR_MAGENTA);
-  tft->setTextColor(COLOR_MAGENTA);
-  tft->setCursor(205, 8);
-  tft->print("SESSION");
-
-  tft->setTextColor(COLOR_DARKGREY);
-  tft->setCursor(168, 25);
-  tft->print("Type:");
-  tft->setCursor(168, 37);
-  tft->print("Lap:");
-  tft->setCursor(168, 49);
-  tft->print("Time:");
-  tft->setCursor(168, 61);
-  tft->print("SC:");
-
-  tft->drawRect(2, 81, 316, 75, COLOR_ORANGE);
-  tft->setTextColor(COLOR_ORANGE);
-  tft->setCursor(88, 87);
-  tft->print("LAP PERFORMANCE");
-
-  tft->setTextColor(COLOR_DARKGREY);
-  tft->setCursor(8, 105);
-  tft->print("Best Lap:");
-  tft->setCursor(8, 127);
-  tft->print("Last Lap:");
-
-  tft->setCursor(165, 105);
-  tft->print("Sector 1:");
-  tft->setCursor(165, 127);
-  tft->print("Sector 2:");
-
-  tft->drawRect(2, 160, 316, 78, COLOR_YELLOW);
-  tft->setTextColor(COLOR_YELLOW);
-  tft->setCursor(85, 166);
-  tft->print("VEHICLE STATUS");
-
-  tft->setTextColor(COLOR_DARKGREY);
-  tft->setCursor(8, 181);
-  tft->print("Fuel:");
-  tft->setCursor(8, 196);
-  tft->print("Tyres:");
-  tft->setCursor(8, 211);
-  tft->print("Engine:");
-  tft->setCursor(8, 226);
-  tft->print("Damage:");
-}
-
-// ============================================
-// RESET DIRTY TRACKING METHODS
-// ============================================
-
-void TelemetryView::resetGeneralDirtyTracking() {
-  lastPosition = 255;
-  lastDeltaFront = 65535;
-  lastDeltaLeader = 65535;
-  lastDeltaLive = -999.0f;
-  lastLapTime = 0;
-  lastCurrentLapTime = 0;
-  lastSector1 = 65535;
-  lastSector2 = 65535;
-  lastCurrentLapNum = 255;
-  lastCornerCuttingWarnings = 255;
-
-  lastSpeed = 65535;
-  lastThrottle = -999.0f;
-  lastBrake = -999.0f;
-  lastGear = -99;
-  lastRPM = 65535;
-
-  lastDRS = 255;
-  lastRevLightsPercent = 255;
-  lastSuggestedGear = -99;
-  lastFrontBrakeBias = 255;
-  lastDiffOnThrottle = 255;
-
-  lastFuelInTank = -999.0f;
-  lastFuelRemainingLaps = -999.0f;
-  lastERSEnergy = -999.0f;
-  lastERSMode = 255;
-
-  lastLedsOn = 255;
-}
-
-void TelemetryView::resetTyreInfoDirtyTracking() {
-  lastTyresAgeLaps = 255;
-
-  lastBrakeTempFL = 65535;
-  lastBrakeTempFR = 65535;
-  lastBrakeTempRL = 65535;
-  lastBrakeTempRR = 65535;
-
-  lastTyreSurfTempFL = 255;
-  lastTyreSurfTempFR = 255;
-  lastTyreSurfTempRL = 255;
-  lastTyreSurfTempRR = 255;
-
-  lastTyreInnerTempFL = 255;
-  lastTyreInnerTempFR = 255;
-  lastTyreInnerTempRL = 255;
-  lastTyreInnerTempRR = 255;
-
-  lastTyrePressureFL = -1.0f;
-  lastTyrePressureFR = -1.0f;
-  lastTyrePressureRL = -1.0f;
-  lastTyrePressureRR = -1.0f;
-
-  lastTyreWearFL = -1.0f;
-  lastTyreWearFR = -1.0f;
-  lastTyreWearRL = -1.0f;
-  lastTyreWearRR = -1.0f;
-
-  lastTyreDamageFL = 255;
-  lastTyreDamageFR = 255;
-  lastTyreDamageRL = 255;
-  lastTyreDamageRR = 255;
-
-  lastBrakeDamageFL = 255;
-  lastBrakeDamageFR = 255;
-  lastBrakeDamageRL = 255;
-  lastBrakeDamageRR = 255;
-}
-
-void TelemetryView::resetCarInfoDirtyTracking() {
-  lastICEPower = -1.0f;
-  lastMGUKPower = -1.0f;
-  lastERSPercent = -1.0f;
-  lastEngineTemp = 65535;
-  lastDRSFault = 255;
-  lastERSFault = 255;
-
-  lastWingDamageFL = 255;
-  lastWingDamageFR = 255;
-  lastWingDamageRear = 255;
-  lastFloorDamage = 255;
-  lastDiffuserDamage = 255;
-  lastSidepodDamage = 255;
-
-  lastGearboxDamage = 255;
-  lastICEDamage = 255;
-  lastMGUHDamage = 255;
-  lastMGUKDamage = 255;
-  lastTCDamage = 255;
-  lastERSDamage = 255;
-  lastCEDamage = 255;
-}
-
-void TelemetryView::resetSessionInfoDirtyTracking() {
-  lastWeather = 255;
-  lastTrackTemp = -99;
-  lastAirTemp = -99;
-
-  lastSessionType = 255;
-  lastCurrentLapInfo = 255;
-  lastTotalLaps = 255;
-  lastSessionTimeLeft = 65535;
-  lastSafetyCarStatus = 255;
-
-  lastBestLapTime = 0;
-  lastLastLapTime = 0;
-  lastSector1Time = 65535;
-  lastSector2Time = 65535;
-
-  lastFuelRemaining = -1.0f;
-  lastTyresAge = 255;
-  lastEngineTempCritical = 65535;
-  lastOverallDamage = 255;
+  gfx->fillScreen(COLOR_BLACK);
+
+  gfx->drawRect(2, 2, 156, 75, COLOR_CYAN);
+  gfx->setTextSize(1);
+  gfx->setTextColor(COLOR_CYAN);
+  gfx->setCursor(38, 8);
+  gfx->print("CONDITIONS");
+
+  gfx->setTextColor(COLOR_DARKGREY);
+  gfx->setCursor(8, 25);
+  gfx->print("Weather:");
+  gfx->setCursor(8, 42);
+  gfx->print("Track:");
+  gfx->setCursor(8, 59);
+  gfx->print("Air:");
+
+  gfx->drawRect(162, 2, 156, 75, COLOR_MAGENTA);
+  gfx->setTextColor(COLOR_MAGENTA);
+  gfx->setCursor(205, 8);
+  gfx->print("SESSION");
+
+  gfx->setTextColor(COLOR_DARKGREY);
+  gfx->setCursor(168, 25);
+  gfx->print("Type:");
+  gfx->setCursor(168, 37);
+  gfx->print("Lap:");
+  gfx->setCursor(168, 49);
+  gfx->print("Time:");
+  gfx->setCursor(168, 61);
+  gfx->print("SC:");
+
+  gfx->drawRect(2, 81, 316, 75, COLOR_ORANGE);
+  gfx->setTextColor(COLOR_ORANGE);
+  gfx->setCursor(88, 87);
+  gfx->print("LAP PERFORMANCE");
+
+  gfx->setTextColor(COLOR_DARKGREY);
+  gfx->setCursor(8, 105);
+  gfx->print("Best Lap:");
+  gfx->setCursor(8, 127);
+  gfx->print("Last Lap:");
+
+  gfx->setCursor(165, 105);
+  gfx->print("Sector 1:");
+  gfx->setCursor(165, 127);
+  gfx->print("Sector 2:");
+
+  gfx->drawRect(2, 160, 316, 78, COLOR_YELLOW);
+  gfx->setTextColor(COLOR_YELLOW);
+  gfx->setCursor(85, 166);
+  gfx->print("VEHICLE STATUS");
+
+  gfx->setTextColor(COLOR_DARKGREY);
+  gfx->setCursor(8, 181);
+  gfx->print("Fuel:");
+  gfx->setCursor(8, 196);
+  gfx->print("Tyres:");
+  gfx->setCursor(8, 211);
+  gfx->print("Engine:");
+  gfx->setCursor(8, 226);
+  gfx->print("Damage:");
+}
+
+void TelemetryView::drawInputTraceScreen() {
+  gfx->fillScreen(COLOR_BLACK);
+
+  gfx->drawFastVLine(InputTrace::PLOT_X - 1, 0, SCREEN_HEIGHT, COLOR_WHITE);
+  InputTrace::drawGuides(gfx);
+
+  gfx->setTextSize(1);
+  gfx->setTextColor(COLOR_GREEN);
+  gfx->setCursor(4, 6);
+  gfx->print("THR");
+  gfx->setTextColor(COLOR_RED);
+  gfx->setCursor(4, 86);
+  gfx->print("BRK");
+  gfx->setTextColor(COLOR_CYAN);
+  gfx->setCursor(4, 166);
+  gfx->print("STR");
+}
+
+// Friction circle: GFORCE_RANGE at the edge, rings every 2 g.
+static const int16_t GFORCE_CENTER_X = 270;
+static const int16_t GFORCE_CENTER_Y = 76;
+static const int16_t GFORCE_RADIUS = 44;
+
+static void drawGForceGuides(Adafruit_GFX* gfx) {
+  gfx->drawFastHLine(GFORCE_CENTER_X - GFORCE_RADIUS, GFORCE_CENTER_Y, 2 * GFORCE_RADIUS + 1, COLOR_DARKGREY);
+  gfx->drawFastVLine(GFORCE_CENTER_X, GFORCE_CENTER_Y - GFORCE_RADIUS, 2 * GFORCE_RADIUS + 1, COLOR_DARKGREY);
+  for (float g = 2.0f; g <= GFORCE_RANGE; g += 2.0f) {
+    gfx->drawCircle(GFORCE_CENTER_X, GFORCE_CENTER_Y, (int16_t)(g * GFORCE_RADIUS / GFORCE_RANGE), COLOR_DARKGREY);
+  }
+}
+
+void TelemetryView::drawTrackMapScreen() {
+  gfx->fillScreen(COLOR_BLACK);
+
+  gfx->setTextSize(2);
+  gfx->setTextColor(COLOR_WHITE);
+  gfx->setCursor(58, 6);
+  gfx->print("TRACK MAP");
+  gfx->setCursor(228, 6);
+  gfx->print("G-FORCE");
+
+  gfx->drawRect(TrackMap::MAP_X - 2, TrackMap::MAP_Y - 2, TrackMap::MAP_WIDTH + 4, TrackMap::MAP_HEIGHT + 4,
+                COLOR_DARKGREY);
+  gfx->drawRect(222, 26, 96, 210, COLOR_DARKGREY);
+  drawGForceGuides(gfx);
+
+  gfx->setTextSize(1);
+  gfx->setTextColor(COLOR_DARKGREY);
+  gfx->setCursor(228, 138);
+  gfx->print("LAT");
+  gfx->setCursor(228, 168);
+  gfx->print("LON");
+  gfx->setCursor(228, 198);
+  gfx->print("VERT");
+}
+
+// History table: newest lap on the first row.
+static const int16_t LAP_COLUMN_X = 8;
+static const int16_t TIME_COLUMN_X = 40;
+static const int16_t SECTOR_COLUMN_X[3] = { 116, 176, 236 };
+static const int16_t LAP_ROWS_Y = 46;
+static const int16_t LAP_ROW_HEIGHT = 13;
+
+void TelemetryView::drawLapHistoryScreen() {
+  gfx->fillScreen(COLOR_BLACK);
+
+  gfx->setTextSize(2);
+  gfx->setTextColor(COLOR_WHITE);
+  gfx->setCursor(94, 6);
+  gfx->print("LAP HISTORY");
+
+  gfx->drawRect(2, 26, 316, 160, COLOR_DARKGREY);
+  gfx->setTextSize(1);
+  gfx->setTextColor(COLOR_DARKGREY);
+  gfx->setCursor(LAP_COLUMN_X, 32);
+  gfx->print("LAP");
+  gfx->setCursor(TIME_COLUMN_X, 32);
+  gfx->print("TIME");
+  gfx->setCursor(SECTOR_COLUMN_X[0], 32);
+  gfx->print("S1");
+  gfx->setCursor(SECTOR_COLUMN_X[1], 32);
+  gfx->print("S2");
+  gfx->setCursor(SECTOR_COLUMN_X[2], 32);
+  gfx->print("S3");
+
+  gfx->drawRect(2, 190, 316, 48, COLOR_CYAN);
+  gfx->setCursor(8, 195);
+  gfx->print("BEST");
+  gfx->setCursor(110, 195);
+  gfx->print("MEDIAN");
+  gfx->setCursor(212, 195);
+  gfx->print("STD DEV");
+}
+
+// Tyre set table on the left, fitted set and suggestions on the right.
+static const int16_t SET_COMPOUND_X = 8;
+static const int16_t SET_WEAR_X = 56;
+static const int16_t SET_LIFE_X = 92;
+static const int16_t SET_DELTA_X = 128;
+static const int16_t SET_ROWS_Y = 44;
+static const int16_t SET_ROW_HEIGHT = 12;
+
+void TelemetryView::drawStrategyScreen() {
+  gfx->fillScreen(COLOR_BLACK);
+
+  gfx->setTextSize(2);
+  gfx->setTextColor(COLOR_WHITE);
+  gfx->setCursor(112, 6);
+  gfx->print("STRATEGY");
+
+  gfx->drawRect(2, 26, 196, 152, COLOR_DARKGREY);
+  gfx->setTextSize(1);
+  gfx->setTextColor(COLOR_DARKGREY);
+  gfx->setCursor(SET_COMPOUND_X, 32);
+  gfx->print("SET");
+  gfx->setCursor(SET_WEAR_X, 32);
+  gfx->print("WEAR");
+  gfx->setCursor(SET_LIFE_X, 32);
+  gfx->print("LAPS");
+  gfx->setCursor(SET_DELTA_X, 32);
+  gfx->print("DELTA");
+
+  gfx->drawRect(2, 182, 196, 56, COLOR_DARKGREY);
+  gfx->setCursor(8, 188);
+  gfx->print("PLAN");
+
+  gfx->drawRect(202, 26, 116, 100, COLOR_DARKGREY);
+  gfx->setCursor(208, 32);
+  gfx->print("FITTED");
+  gfx->setCursor(208, 80);
+  gfx->print("NEXT");
+
+  gfx->drawRect(202, 130, 116, 108, COLOR_DARKGREY);
+  gfx->setCursor(208, 136);
+  gfx->print("BURN/LAP");
+  gfx->setCursor(208, 168);
+  gfx->print("AT FLAG");
+  gfx->setCursor(208, 200);
+  gfx->print("SAVE/LAP");
 }
 
 // ============================================
 // UPDATE METHODS - GENERAL SCREEN
 // ============================================
 
-void TelemetryView::updatePosition() {
-  uint8_t pos = model->getCarPosition();
-  if (pos != lastPosition) {
-    tft->fillRect(43, 1, 66, 22, COLOR_BLACK);
-    tft->setTextSize(2);
-    tft->setTextColor(COLOR_CYAN);
-
-    uint8_t cursorX;
-    if (pos < 10) {
-      cursorX = 64;
-    } else {
-      cursorX = 58;
-    }
-    tft->setCursor(cursorX, 4);
-
-    if (pos > 0) {
-      tft->print("P");
-      tft->print(pos);
-    } else {
-      tft->setCursor(64, 4);
-      tft->print("--");
-    }
-    lastPosition = pos;
-  }
-}
-
-void TelemetryView::updateDeltaFront() {
-  uint16_t delta = model->getDeltaToCarInFrontMS();
-  if (delta != lastDeltaFront) {
-    tft->fillRect(43, 25, 66, 22, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_YELLOW);
-
-    if (delta > 0 && delta < 30000) {
-      tft->setCursor(54, 32);
-      tft->print("+");
-      tft->print(delta / 1000.0f, 2);
-    } else {
-      tft->setCursor(68, 32);
-      tft->print("--");
-    }
-    lastDeltaFront = delta;
-  }
-}
-
-void TelemetryView::updateDeltaLeader() {
+void TelemetryView::updateDeltaLeader(const DirtyMask& dirty) {
   uint16_t delta = model->getDeltaToRaceLeaderMS();
-  if (delta != lastDeltaLeader) {
-    tft->fillRect(43, 49, 66, 22, COLOR_BLACK);
-    tft->setTextSize(1);
+  if (dirty.test(FIELD_DELTA_TO_RACE_LEADER)) {
+    beginWidget(43, 49, 66, 22);
 
     if (delta == 0) {
-      tft->setTextColor(COLOR_GREEN);
-      tft->setCursor(60, 56);
-      tft->print("LEAD");
+      drawGlyphText(gfx, 60, 56, "LEAD", 1, COLOR_GREEN);
     } else if (delta < 30000) {
-      tft->setTextColor(COLOR_ORANGE);
-      tft->setCursor(54, 56);
-      tft->print("+");
-      tft->print(delta / 1000.0f, 1);
+      char text[FORMAT_BUFFER_SIZE];
+      formatSigned(text, (delta + 50) / 100, 1);
+      drawGlyphText(gfx, 54, 56, text, 1, COLOR_ORANGE);
     } else {
-      tft->setTextColor(COLOR_DARKGREY);
-      tft->setCursor(68, 56);
-      tft->print("--");
+      drawGlyphText(gfx, 68, 56, "--", 1, COLOR_DARKGREY);
     }
-    lastDeltaLeader = delta;
+    endWidget();
   }
 }
 
-void TelemetryView::updateDeltaLive() {
+void TelemetryView::updateDeltaLive(const DirtyMask& dirty) {
   float delta = model->getDeltaLive();
   uint32_t bestLap = model->getBestLapTimeMS();
-  float lapDist = model->getLapDistance();
-
-  bool shouldUpdate = (abs(delta - lastDeltaLive) > 0.001f) || (lastDeltaLive == -999.0f);
+  float lapDist = model->getLiveLapDistance();
 
-  if (shouldUpdate) {
-    tft->fillRect(43, 73, 66, 22, COLOR_BLACK);
-    tft->setTextSize(1);
+  if (dirty.test(FIELD_DELTA_LIVE)) {
+    beginWidget(43, 73, 66, 22);
 
     if (bestLap == 0 || lapDist < 10.0f) {
-      tft->setTextColor(COLOR_DARKGREY);
-      tft->setCursor(68, 80);
-      tft->print("--");
-    } else if (delta > 0.1f) {
-      tft->setTextColor(COLOR_RED);
-      tft->setCursor(50, 80);
-      tft->print("+");
-      tft->print(delta, 3);
-    } else if (delta < -0.1f) {
-      tft->setTextColor(COLOR_GREEN);
-      tft->setCursor(54, 80);
-      tft->print(delta, 3);
+      drawGlyphText(gfx, 68, 80, "--", 1, COLOR_DARKGREY);
+    } else if (delta > 0.1f || delta < -0.1f) {
+      char text[FORMAT_BUFFER_SIZE];
+      formatSigned(text, toFixed(delta, 3), 3);
+      drawGlyphText(gfx, delta > 0 ? 50 : 54, 80, text, 1, delta > 0 ? COLOR_RED : COLOR_GREEN);
     } else {
-      tft->setTextColor(COLOR_WHITE);
-      tft->setCursor(54, 80);
-      tft->print("0.000");
+      drawGlyphText(gfx, 54, 80, "0.000", 1, COLOR_WHITE);
     }
-
-    lastDeltaLive = delta;
+    endWidget();
   }
 }
 
-void TelemetryView::updateLastLapTime() {
+void TelemetryView::updateLastLapTime(const DirtyMask& dirty) {
   uint32_t time = model->getLastLapTimeMS();
-  if (time != lastLapTime) {
-    tft->fillRect(43, 97, 66, 22, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_CYAN);
-    tft->setCursor(52, 105);
-
-    if (time > 0) {
-      uint8_t mins = time / 60000;
-      uint8_t secs = (time % 60000) / 1000;
-      uint16_t ms = time % 1000;
-
-      if (mins > 0) {
-        tft->print(mins);
-        tft->print(":");
-        if (secs < 10) tft->print("0");
-      }
-      tft->print(secs);
-      tft->print(".");
-      if (ms < 100) tft->print("0");
-      if (ms < 10) tft->print("0");
-      tft->print(ms);
-    } else {
-      tft->print("--");
-    }
-    lastLapTime = time;
-  }
-}
-
-void TelemetryView::updateSector1() {
-  uint16_t time = model->getSector1TimeMS();
-  if (time != lastSector1) {
-    tft->fillRect(43, 121, 66, 22, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_GREEN);
-
-    if (time > 0) {
-      tft->setCursor(54, 128);
-      tft->print(time / 1000.0f, 3);
-    } else {
-      tft->setCursor(68, 128);
-      tft->print("--");
-    }
-    lastSector1 = time;
-  }
-}
-
-void TelemetryView::updateSector2() {
-  uint16_t time = model->getSector2TimeMS();
-  if (time != lastSector2) {
-    tft->fillRect(43, 145, 66, 22, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_GREEN);
+  if (dirty.test(FIELD_LAST_LAP_TIME)) {
+    beginWidget(43, 97, 66, 22);
 
     if (time > 0) {
-      tft->setCursor(54, 152);
-      tft->print(time / 1000.0f, 3);
+      char text[FORMAT_BUFFER_SIZE];
+      if (time >= 60000) formatLapTime(text, time);
+      else formatSeconds(text, time);
+      drawGlyphText(gfx, 52, 105, text, 1, COLOR_CYAN);
     } else {
-      tft->setCursor(68, 152);
-      tft->print("--");
+      drawGlyphText(gfx, 52, 105, "--", 1, COLOR_CYAN);
     }
-    lastSector2 = time;
+    endWidget();
   }
 }
 
-void TelemetryView::updateCurrentLapNum() {
-  uint8_t lap = model->getCurrentLapNum();
-  if (lap != lastCurrentLapNum) {
-    tft->fillRect(43, 169, 66, 22, COLOR_BLACK);
-    tft->setTextSize(2);
-    tft->setTextColor(COLOR_WHITE);
-    uint8_t cursorX = (lap < 10) ? 69 : 63;
-    tft->setCursor(cursorX, 172);
-    tft->print(lap);
-    lastCurrentLapNum = lap;
-  }
-}
-
-void TelemetryView::updateCornerCuttingWarnings() {
-  uint8_t warnings = model->getCornerCuttingWarnings();
-  if (warnings != lastCornerCuttingWarnings) {
-    tft->fillRect(43, 193, 66, 22, COLOR_BLACK);
-    tft->setTextSize(2);
-    tft->setTextColor(warnings > 0 ? COLOR_RED : COLOR_GREEN);
-    tft->setCursor(70, 199);
-    tft->print(warnings);
-    lastCornerCuttingWarnings = warnings;
-  }
-}
-
-void TelemetryView::updateRPM() {
-  uint16_t rpm = model->getEngineRPM();
-  if (rpm != lastRPM) {
-    tft->fillRect(113, 1, 74, 22, COLOR_BLACK);
-    tft->setTextSize(2);
-    tft->setTextColor(COLOR_YELLOW);
-    uint8_t cursorX = (rpm < 10000) ? 130 : 122;
-    tft->setCursor(cursorX, 6);
-    tft->print(rpm);
-    lastRPM = rpm;
-  }
-}
-
-void TelemetryView::updateGear() {
+void TelemetryView::updateGear(const DirtyMask& dirty) {
   int8_t gear = model->getGear();
-  if (gear != lastGear) {
-    tft->fillRect(113, 25, 74, 94, COLOR_BLACK);
-    tft->setTextSize(8);
-    tft->setCursor(130, 45);
+  if (dirty.test(FIELD_GEAR)) {
+    beginWidget(113, 25, 74, 94);
 
     if (gear == -1) {
-      tft->setTextColor(COLOR_RED);
-      tft->print("R");
+      drawGlyphText(gfx, 130, 45, "R", 8, COLOR_RED);
     } else if (gear == 0) {
-      tft->setTextColor(COLOR_WHITE);
-      tft->print("N");
+      drawGlyphText(gfx, 130, 45, "N", 8, COLOR_WHITE);
     } else {
-      tft->setTextColor(COLOR_WHITE);
-      tft->print(gear);
+      char text[FORMAT_BUFFER_SIZE];
+      formatFixed(text, gear, 0);
+      drawGlyphText(gfx, 130, 45, text, 8, COLOR_WHITE);
     }
-
-    lastGear = gear;
+    endWidget();
   }
 }
 
-void TelemetryView::updateSpeed() {
+void TelemetryView::updateSpeed(const DirtyMask& dirty) {
   uint16_t speed = model->getSpeed();
-  if (speed != lastSpeed) {
-    tft->fillRect(113, 121, 74, 94, COLOR_BLACK);
-
-    tft->setTextSize(3);
-    tft->setTextColor(COLOR_WHITE);
+  if (dirty.test(FIELD_SPEED)) {
+    beginWidget(113, 121, 74, 94);
 
-    uint8_t cursorX;
-    if (speed < 10) {
-      cursorX = 142;
-    } else if (speed < 100) {
-      cursorX = 131;
-    } else {
-      cursorX = 122;
-    }
-
-    tft->setCursor(cursorX, 140);
-    tft->print(speed);
-
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_DARKGREY);
-    tft->setCursor(138, 180);
-    tft->print("km/h");
-
-    lastSpeed = speed;
+    char text[FORMAT_BUFFER_SIZE];
+    uint8_t length = formatFixed(text, speed, 0);
+    drawGlyphText(gfx, 150 - textWidth(length, 3) / 2, 140, text, 3, COLOR_WHITE);
+    drawGlyphText(gfx, 138, 180, "km/h", 1, COLOR_DARKGREY);
+    endWidget();
   }
 }
 
-void TelemetryView::updateCurrentLapTime() {
-  uint32_t time = model->getCurrentLapTimeMS();
-  if (time != lastCurrentLapTime) {
-    tft->fillRect(191, 1, 86, 22, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_WHITE);
-    tft->setCursor(210, 8);
+void TelemetryView::updateCurrentLapTime(const DirtyMask& dirty) {
+  uint32_t time = model->getLiveLapTimeMS();
+  if (dirty.test(FIELD_LIVE_LAP_TIME)) {
+    beginWidget(191, 1, 86, 22);
     if (time > 0) {
-      char buffer[16];
-      model->formatLapTime(time, buffer);
-      tft->print(buffer);
+      char buffer[FORMAT_BUFFER_SIZE];
+      formatLapTime(buffer, time);
+      drawGlyphText(gfx, 210, 8, buffer, 1, COLOR_WHITE);
     } else {
-      tft->print("--:--.---");
+      drawGlyphText(gfx, 210, 8, "--:--.---", 1, COLOR_WHITE);
     }
-    lastCurrentLapTime = time;
+    endWidget();
   }
 }
 
-void TelemetryView::updateDRS() {
-  uint8_t drs = model->getDRS();
-  if (drs != lastDRS) {
-    tft->fillRect(191, 25, 86, 22, COLOR_BLACK);
-    tft->setTextSize(2);
-    tft->setTextColor(drs == 1 ? COLOR_GREEN : COLOR_DARKGREY);
-    tft->setCursor(216, 30);
-    tft->print(drs == 1 ? "DRS" : "---");
-    lastDRS = drs;
-  }
-}
-
-void TelemetryView::updateRevLights() {
-  uint8_t rev = model->getRevLightsPercent();
-  if (rev != lastRevLightsPercent) {
-    tft->fillRect(191, 49, 86, 22, COLOR_BLACK);
-    tft->setTextSize(2);
-    tft->setTextColor(COLOR_ORANGE);
-    uint8_t cursorX = (rev < 10) ? 224 : (rev < 100 ? 218 : 212);
-    tft->setCursor(cursorX, 54);
-    tft->print(rev);
-    tft->print("%");
-    lastRevLightsPercent = rev;
-  }
-}
-
-void TelemetryView::updateSuggestedGear() {
-  int8_t gear = model->getSuggestedGear();
-  if (gear != lastSuggestedGear) {
-    tft->fillRect(191, 73, 86, 22, COLOR_BLACK);
-    tft->setTextSize(2);
-    tft->setTextColor(COLOR_MAGENTA);
-    uint8_t cursorX = (gear > 0) ? 228 : 224;
-    tft->setCursor(cursorX, 78);
-    if (gear > 0) tft->print(gear);
-    else tft->print("--");
-    lastSuggestedGear = gear;
-  }
-}
-
-void TelemetryView::updateFrontBrakeBias() {
-  uint8_t bias = model->getFrontBrakeBias();
-  if (bias != lastFrontBrakeBias) {
-    tft->fillRect(191, 97, 86, 22, COLOR_BLACK);
-    tft->setTextSize(2);
-    tft->setTextColor(COLOR_MAGENTA);
-    uint8_t cursorX = (bias < 10) ? 224 : (bias < 100 ? 218 : 212);
-    tft->setCursor(cursorX, 102);
-    tft->print(bias);
-    tft->print("%");
-    lastFrontBrakeBias = bias;
-  }
-}
-
-void TelemetryView::updateDiffOnThrottle() {
-  uint8_t diff = model->getDiffOnThrottle();
-  if (diff != lastDiffOnThrottle) {
-    tft->fillRect(191, 121, 86, 22, COLOR_BLACK);
-    tft->setTextSize(2);
-    tft->setTextColor(COLOR_CYAN);
-    uint8_t cursorX = (diff < 10) ? 224 : (diff < 100 ? 218 : 212);
-    tft->setCursor(cursorX, 126);
-    tft->print(diff);
-    tft->print("%");
-    lastDiffOnThrottle = diff;
-  }
-}
-
-void TelemetryView::updateFuelInTank() {
-  float fuel = model->getFuelInTank();
-  if (abs(fuel - lastFuelInTank) > 0.1f) {
-    tft->fillRect(191, 145, 86, 22, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_WHITE);
-    tft->setCursor(215, 153);
-    tft->print(fuel, 1);
-    tft->print("kg");
-    lastFuelInTank = fuel;
-  }
-}
-
-void TelemetryView::updateFuelRemainingLaps() {
-  float laps = model->getFuelRemainingLaps();
-  if (abs(laps - lastFuelRemainingLaps) > 0.1f) {
-    tft->fillRect(191, 169, 86, 22, COLOR_BLACK);
-    tft->setTextSize(1);
-
-    if (laps > 0.1f) {
-      uint16_t color = laps < 1.0f ? COLOR_RED : (laps < 3.0f ? COLOR_YELLOW : COLOR_GREEN);
-      tft->setTextColor(color);
-      tft->setCursor(222, 177);
-      tft->print(laps, 1);
-    } else {
-      tft->setTextColor(COLOR_DARKGREY);
-      tft->setCursor(228, 177);
-      tft->print("--");
-    }
-    lastFuelRemainingLaps = laps;
-  }
-}
-
-void TelemetryView::updateERSMode() {
-  uint8_t mode = model->getERSDeployMode();
-  if (mode != lastERSMode) {
-    tft->fillRect(191, 193, 86, 22, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_YELLOW);
-    tft->setCursor(220, 201);
-    switch (mode) {
-      case 0: tft->print("NONE"); break;
-      case 1: tft->print("MED"); break;
-      case 2: tft->print("HOT"); break;
-      case 3: tft->print("OVR"); break;
-      default: tft->print("--"); break;
-    }
-    lastERSMode = mode;
-  }
-}
-
-void TelemetryView::updateERSEnergy() {
+// The bars redraw as tiles over the strip that changed: beginWidget()
+// clears it, and a strip the bar grew into is filled again.
+void TelemetryView::updateERSEnergy(const DirtyMask& dirty) {
   float ers = model->getERSPercent();
-  if (abs(ers - lastERSEnergy) > 0.1f) {
+  if (dirty.test(FIELD_ERS_STORE_ENERGY)) {
     int barWidth = (int)((ers / 100.0f) * 234);
 
-    if (lastERSEnergy < 0.0f) {
-      tft->fillRect(43, 217, 234, 22, COLOR_BLACK);
-      tft->fillRect(43, 217, barWidth, 22, COLOR_YELLOW);
+    if (drawnERSWidth < 0) {
+      beginWidget(43, 217, 234, 22);
+      gfx->fillRect(43, 217, barWidth, 22, COLOR_YELLOW);
+      endWidget();
     } else {
-      int oldBarWidth = (int)((lastERSEnergy / 100.0f) * 234);
+      int oldBarWidth = drawnERSWidth;
 
       if (barWidth > oldBarWidth) {
-        tft->fillRect(43 + oldBarWidth, 217, barWidth - oldBarWidth, 22, COLOR_YELLOW);
+        beginWidget(43 + oldBarWidth, 217, barWidth - oldBarWidth, 22);
+        gfx->fillRect(43 + oldBarWidth, 217, barWidth - oldBarWidth, 22, COLOR_YELLOW);
+        endWidget();
       } else if (barWidth < oldBarWidth) {
-        tft->fillRect(43 + barWidth, 217, oldBarWidth - barWidth, 22, COLOR_BLACK);
+        beginWidget(43 + barWidth, 217, oldBarWidth - barWidth, 22);
+        endWidget();
       }
     }
 
-    lastERSEnergy = ers;
+    drawnERSWidth = barWidth;
   }
 }
 
-void TelemetryView::updateThrottle() {
+void TelemetryView::updateThrottle(const DirtyMask& dirty) {
   float throttle = model->getThrottle();
-  if (abs(throttle - lastThrottle) > 0.01f) {
+  if (dirty.test(FIELD_THROTTLE)) {
     int barHeight = (int)(throttle * 238);
 
-    if (lastThrottle < 0.0f) {
-      tft->fillRect(281, 1, 38, 238, COLOR_BLACK);
-      tft->fillRect(281, 239 - barHeight, 38, barHeight, COLOR_GREEN);
+    if (drawnThrottleHeight < 0) {
+      beginWidget(281, 1, 38, 238);
+      gfx->fillRect(281, 239 - barHeight, 38, barHeight, COLOR_GREEN);
+      endWidget();
     } else {
-      int oldBarHeight = (int)(lastThrottle * 238);
+      int oldBarHeight = drawnThrottleHeight;
 
       if (barHeight > oldBarHeight) {
-        tft->fillRect(281, 239 - barHeight, 38, barHeight - oldBarHeight, COLOR_GREEN);
+        beginWidget(281, 239 - barHeight, 38, barHeight - oldBarHeight);
+        gfx->fillRect(281, 239 - barHeight, 38, barHeight - oldBarHeight, COLOR_GREEN);
+        endWidget();
       } else if (barHeight < oldBarHeight) {
-        tft->fillRect(281, 239 - oldBarHeight, 38, oldBarHeight - barHeight, COLOR_BLACK);
+        beginWidget(281, 239 - oldBarHeight, 38, oldBarHeight - barHeight);
+        endWidget();
       }
     }
 
-    lastThrottle = throttle;
+    drawnThrottleHeight = barHeight;
   }
 }
 
-void TelemetryView::updateBrake() {
+void TelemetryView::updateBrake(const DirtyMask& dirty) {
   float brake = model->getBrake();
-  if (abs(brake - lastBrake) > 0.01f) {
+  if (dirty.test(FIELD_BRAKE)) {
     int barHeight = (int)(brake * 238);
 
-    if (lastBrake < 0.0f) {
-      tft->fillRect(1, 1, 38, 238, COLOR_BLACK);
-      tft->fillRect(1, 239 - barHeight, 38, barHeight, COLOR_RED);
+    if (drawnBrakeHeight < 0) {
+      beginWidget(1, 1, 38, 238);
+      gfx->fillRect(1, 239 - barHeight, 38, barHeight, COLOR_RED);
+      endWidget();
     } else {
-      int oldBarHeight = (int)(lastBrake * 238);
+      int oldBarHeight = drawnBrakeHeight;
 
       if (barHeight > oldBarHeight) {
-        tft->fillRect(1, 239 - barHeight, 38, barHeight - oldBarHeight, COLOR_RED);
+        beginWidget(1, 239 - barHeight, 38, barHeight - oldBarHeight);
+        gfx->fillRect(1, 239 - barHeight, 38, barHeight - oldBarHeight, COLOR_RED);
+        endWidget();
       } else if (barHeight < oldBarHeight) {
-        tft->fillRect(1, 239 - oldBarHeight, 38, oldBarHeight - barHeight, COLOR_BLACK);
+        beginWidget(1, 239 - oldBarHeight, 38, oldBarHeight - barHeight);
+        endWidget();
       }
     }
 
-    lastBrake = brake;
+    drawnBrakeHeight = barHeight;
   }
 }
 
-void TelemetryView::updateLEDs() {
+void TelemetryView::updateLEDs(const DirtyMask& dirty) {
+  if (!dirty.test(FIELD_REV_LIGHTS_PERCENT) || bannerState != BANNER_IDLE) return;
+
   uint8_t revPercent = model->getRevLightsPercent();
   int ledsOn = map(revPercent, 0, 100, 0, NUM_LEDS);
 
@@ -1039,929 +1473,601 @@ void TelemetryView::updateLEDs() {
 // UPDATE METHODS - TYRE INFO SCREEN
 // ============================================
 
-void TelemetryView::updateTyresAgeLaps() {
-  uint8_t age = model->getTyresAgeLaps();
-  if (age != lastTyresAgeLaps) {
-    tft->fillRect(1, 1, 318, 22, COLOR_BLACK);
-    tft->setTextSize(2);
-    tft->setTextColor(COLOR_WHITE);
-    tft->setCursor(90, 4);
-    tft->print("AGE: ");
-    tft->print(age);
-    tft->print(" LAPS");
-    lastTyresAgeLaps = age;
-  }
-}
+// One row under each corner's values: wear per lap and laps left before
+// TYRE_WEAR_CLIFF. Seven rows tall, clear of the panel borders.
+void TelemetryView::updateTyreDegradation(const DirtyMask& dirty) {
+  if (!dirty.test(FIELD_TYRE_DEGRADATION)) return;
+
+  // Packet order: RL, RR, FL, FR.
+  static const int16_t CORNER_X[4] = { 5, 165, 5, 165 };
+  static const int16_t CORNER_Y[4] = { 232, 232, 124, 124 };
+
+  const TyreWearModel& wear = model->getTyreWear();
+  for (uint8_t i = 0; i < 4; i++) {
+    int16_t x = CORNER_X[i];
+    int16_t y = CORNER_Y[i];
+    beginWidget(x, y, 150, 7);
+
+    float laps = wear.getLapsToCliff(i);
+    if (laps < 0.0f) {
+      drawGlyphText(gfx, x, y, "Deg:   --", 1, COLOR_DARKGREY);
+      endWidget();
+      continue;
+    }
 
-void TelemetryView::updateBrakeTemps() {
-  uint16_t fl = model->getBrakeTemp(2);
-  uint16_t fr = model->getBrakeTemp(3);
-  uint16_t rl = model->getBrakeTemp(0);
-  uint16_t rr = model->getBrakeTemp(1);
-
-  if (fl != lastBrakeTempFL) {
-    tft->fillRect(5, 40, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(fl > 600 ? COLOR_RED : COLOR_ORANGE);
-    tft->setCursor(5, 40);
-    tft->print("Brake: ");
-    tft->print(fl);
-    tft->print("C");
-    lastBrakeTempFL = fl;
-  }
-
-  if (fr != lastBrakeTempFR) {
-    tft->fillRect(165, 40, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(fr > 600 ? COLOR_RED : COLOR_ORANGE);
-    tft->setCursor(165, 40);
-    tft->print("Brake: ");
-    tft->print(fr);
-    tft->print("C");
-    lastBrakeTempFR = fr;
-  }
-
-  if (rl != lastBrakeTempRL) {
-    tft->fillRect(5, 148, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(rl > 600 ? COLOR_RED : COLOR_ORANGE);
-    tft->setCursor(5, 148);
-    tft->print("Brake: ");
-    tft->print(rl);
-    tft->print("C");
-    lastBrakeTempRL = rl;
-  }
-
-  if (rr != lastBrakeTempRR) {
-    tft->fillRect(165, 148, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(rr > 600 ? COLOR_RED : COLOR_ORANGE);
-    tft->setCursor(165, 148);
-    tft->print("Brake: ");
-    tft->print(rr);
-    tft->print("C");
-    lastBrakeTempRR = rr;
+    char text[FORMAT_BUFFER_SIZE];
+    uint8_t length = appendText(text, 0, "Deg:  ");
+    length += formatFixed(text + length, toFixed(wear.getRatePerLap(i), 2), 2);
+    length = appendText(text, length, "%/L ");
+    if (laps >= 99.0f) {
+      appendText(text, length, "99+ L");
+    } else {
+      length += formatFixed(text + length, toFixed(laps, 1), 1);
+      appendText(text, length, " L");
+    }
+    uint16_t color = laps < 3.0f ? COLOR_RED : (laps < 8.0f ? COLOR_YELLOW : COLOR_CYAN);
+    drawGlyphText(gfx, x, y, text, 1, color);
+    endWidget();
   }
 }
 
-void TelemetryView::updateTyreSurfaceTemps() {
-  uint8_t fl = model->getTyreSurfaceTemp(2);
-  uint8_t fr = model->getTyreSurfaceTemp(3);
-  uint8_t rl = model->getTyreSurfaceTemp(0);
-  uint8_t rr = model->getTyreSurfaceTemp(1);
-
-  if (fl != lastTyreSurfTempFL) {
-    tft->fillRect(5, 52, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_GREEN);
-    tft->setCursor(5, 52);
-    tft->print("Surf:  ");
-    tft->print(fl);
-    tft->print("C");
-    lastTyreSurfTempFL = fl;
-  }
-
-  if (fr != lastTyreSurfTempFR) {
-    tft->fillRect(165, 52, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_GREEN);
-    tft->setCursor(165, 52);
-    tft->print("Surf:  ");
-    tft->print(fr);
-    tft->print("C");
-    lastTyreSurfTempFR = fr;
-  }
-
-  if (rl != lastTyreSurfTempRL) {
-    tft->fillRect(5, 160, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_GREEN);
-    tft->setCursor(5, 160);
-    tft->print("Surf:  ");
-    tft->print(rl);
-    tft->print("C");
-    lastTyreSurfTempRL = rl;
-  }
-
-  if (rr != lastTyreSurfTempRR) {
-    tft->fillRect(165, 160, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_GREEN);
-    tft->setCursor(165, 160);
-    tft->print("Surf:  ");
-    tft->print(rr);
-    tft->print("C");
-    lastTyreSurfTempRR = rr;
-  }
-}
+// ============================================
+// UPDATE METHODS - CAR DAMAGE SCREEN
+// ============================================
 
-void TelemetryView::updateTyreInnerTemps() {
-  uint8_t fl = model->getTyreInnerTemp(2);
-  uint8_t fr = model->getTyreInnerTemp(3);
-  uint8_t rl = model->getTyreInnerTemp(0);
-  uint8_t rr = model->getTyreInnerTemp(1);
-
-  if (fl != lastTyreInnerTempFL) {
-    tft->fillRect(5, 64, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_YELLOW);
-    tft->setCursor(5, 64);
-    tft->print("Inner: ");
-    tft->print(fl);
-    tft->print("C");
-    lastTyreInnerTempFL = fl;
-  }
-
-  if (fr != lastTyreInnerTempFR) {
-    tft->fillRect(165, 64, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_YELLOW);
-    tft->setCursor(165, 64);
-    tft->print("Inner: ");
-    tft->print(fr);
-    tft->print("C");
-    lastTyreInnerTempFR = fr;
-  }
-
-  if (rl != lastTyreInnerTempRL) {
-    tft->fillRect(5, 172, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_YELLOW);
-    tft->setCursor(5, 172);
-    tft->print("Inner: ");
-    tft->print(rl);
-    tft->print("C");
-    lastTyreInnerTempRL = rl;
-  }
-
-  if (rr != lastTyreInnerTempRR) {
-    tft->fillRect(165, 172, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_YELLOW);
-    tft->setCursor(165, 172);
-    tft->print("Inner: ");
-    tft->print(rr);
-    tft->print("C");
-    lastTyreInnerTempRR = rr;
-  }
-}
+void TelemetryView::updatePowerUnitFaults(const DirtyMask& dirty) {
+  uint8_t drsFault = model->getDRSFault();
+  uint8_t ersFault = model->getERSFault();
 
-void TelemetryView::updateTyrePressures() {
-  float fl = model->getTyrePressure(2);
-  float fr = model->getTyrePressure(3);
-  float rl = model->getTyrePressure(0);
-  float rr = model->getTyrePressure(1);
-
-  if (abs(fl - lastTyrePressureFL) > 0.01f) {
-    tft->fillRect(5, 76, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_WHITE);
-    tft->setCursor(5, 76);
-    tft->print("Press: ");
-    tft->print(fl, 2);
-    lastTyrePressureFL = fl;
-  }
-
-  if (abs(fr - lastTyrePressureFR) > 0.01f) {
-    tft->fillRect(165, 76, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_WHITE);
-    tft->setCursor(165, 76);
-    tft->print("Press: ");
-    tft->print(fr, 2);
-    lastTyrePressureFR = fr;
-  }
-
-  if (abs(rl - lastTyrePressureRL) > 0.01f) {
-    tft->fillRect(5, 184, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_WHITE);
-    tft->setCursor(5, 184);
-    tft->print("Press: ");
-    tft->print(rl, 2);
-    lastTyrePressureRL = rl;
-  }
-
-  if (abs(rr - lastTyrePressureRR) > 0.01f) {
-    tft->fillRect(165, 184, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_WHITE);
-    tft->setCursor(165, 184);
-    tft->print("Press: ");
-    tft->print(rr, 2);
-    lastTyrePressureRR = rr;
+  if (dirty.test(FIELD_DRS_FAULT) || dirty.test(FIELD_ERS_FAULT)) {
+    beginWidget(60, 85, 90, 10);
+    if (drsFault == 1 || ersFault == 1) {
+      drawGlyphText(gfx, 60, 85, drsFault == 1 ? "DRS FAULT" : "ERS FAULT", 1, COLOR_RED);
+    } else {
+      drawGlyphText(gfx, 60, 85, "OK", 1, COLOR_GREEN);
+    }
+    endWidget();
   }
 }
 
-void TelemetryView::updateTyreWear() {
-  float fl = model->getTyreWear(2);
-  float fr = model->getTyreWear(3);
-  float rl = model->getTyreWear(0);
-  float rr = model->getTyreWear(1);
-
-  if (abs(fl - lastTyreWearFL) > 0.1f) {
-    tft->fillRect(5, 88, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_CYAN);
-    tft->setCursor(5, 88);
-    tft->print("Wear:  ");
-    tft->print((int)fl);
-    tft->print("%");
-    lastTyreWearFL = fl;
-  }
-
-  if (abs(fr - lastTyreWearFR) > 0.1f) {
-    tft->fillRect(165, 88, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_CYAN);
-    tft->setCursor(165, 88);
-    tft->print("Wear:  ");
-    tft->print((int)fr);
-    tft->print("%");
-    lastTyreWearFR = fr;
-  }
-
-  if (abs(rl - lastTyreWearRL) > 0.1f) {
-    tft->fillRect(5, 196, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_CYAN);
-    tft->setCursor(5, 196);
-    tft->print("Wear:  ");
-    tft->print((int)rl);
-    tft->print("%");
-    lastTyreWearRL = rl;
-  }
-
-  if (abs(rr - lastTyreWearRR) > 0.1f) {
-    tft->fillRect(165, 196, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_CYAN);
-    tft->setCursor(165, 196);
-    tft->print("Wear:  ");
-    tft->print((int)rr);
-    tft->print("%");
-    lastTyreWearRR = rr;
+// ============================================
+// UPDATE METHODS - SCREEN 4: RACE OVERVIEW
+// ============================================
+
+void TelemetryView::updateLapInfo(const DirtyMask& dirty) {
+  uint8_t currentLap = model->getCurrentLapNum();
+  uint8_t totalLaps = model->getTotalLaps();
+
+  if (dirty.test(FIELD_CURRENT_LAP_NUM) || dirty.test(FIELD_TOTAL_LAPS)) {
+    beginWidget(210, 37, 100, 10);
+    char text[FORMAT_BUFFER_SIZE];
+    uint8_t length = formatFixed(text, currentLap, 0);
+    length = appendText(text, length, " / ");
+    formatFixed(text + length, totalLaps, 0);
+    drawGlyphText(gfx, 210, 37, text, 1, COLOR_WHITE);
+    endWidget();
   }
 }
 
-void TelemetryView::updateTyreDamage() {
-  uint8_t fl = model->getTyreDamage(2);
-  uint8_t fr = model->getTyreDamage(3);
-  uint8_t rl = model->getTyreDamage(0);
-  uint8_t rr = model->getTyreDamage(1);
-
-  if (fl != lastTyreDamageFL) {
-    tft->fillRect(5, 100, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(fl > 50 ? COLOR_RED : COLOR_GREEN);
-    tft->setCursor(5, 100);
-    tft->print("T.Dmg: ");
-    tft->print(fl);
-    tft->print("%");
-    lastTyreDamageFL = fl;
-  }
-
-  if (fr != lastTyreDamageFR) {
-    tft->fillRect(165, 100, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(fr > 50 ? COLOR_RED : COLOR_GREEN);
-    tft->setCursor(165, 100);
-    tft->print("T.Dmg: ");
-    tft->print(fr);
-    tft->print("%");
-    lastTyreDamageFR = fr;
-  }
-
-  if (rl != lastTyreDamageRL) {
-    tft->fillRect(5, 208, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(rl > 50 ? COLOR_RED : COLOR_GREEN);
-    tft->setCursor(5, 208);
-    tft->print("T.Dmg: ");
-    tft->print(rl);
-    tft->print("%");
-    lastTyreDamageRL = rl;
-  }
-
-  if (rr != lastTyreDamageRR) {
-    tft->fillRect(165, 208, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(rr > 50 ? COLOR_RED : COLOR_GREEN);
-    tft->setCursor(165, 208);
-    tft->print("T.Dmg: ");
-    tft->print(rr);
-    tft->print("%");
-    lastTyreDamageRR = rr;
+void TelemetryView::updateSessionTimeLeft(const DirtyMask& dirty) {
+  uint16_t timeLeft = model->getSessionTimeLeft();
+  if (dirty.test(FIELD_SESSION_TIME_LEFT)) {
+    beginWidget(210, 49, 100, 10);
+    char text[FORMAT_BUFFER_SIZE];
+    formatClock(text, timeLeft);
+    drawGlyphText(gfx, 210, 49, text, 1, timeLeft < 300 ? COLOR_RED : COLOR_WHITE);
+    endWidget();
   }
 }
 
-void TelemetryView::updateBrakeDamage() {
-  uint8_t fl = model->getBrakeDamage(2);
-  uint8_t fr = model->getBrakeDamage(3);
-  uint8_t rl = model->getBrakeDamage(0);
-  uint8_t rr = model->getBrakeDamage(1);
-
-  if (fl != lastBrakeDamageFL) {
-    tft->fillRect(5, 112, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(fl > 50 ? COLOR_RED : COLOR_GREEN);
-    tft->setCursor(5, 112);
-    tft->print("B.Dmg: ");
-    tft->print(fl);
-    tft->print("%");
-    lastBrakeDamageFL = fl;
-  }
-
-  if (fr != lastBrakeDamageFR) {
-    tft->fillRect(165, 112, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(fr > 50 ? COLOR_RED : COLOR_GREEN);
-    tft->setCursor(165, 112);
-    tft->print("B.Dmg: ");
-    tft->print(fr);
-    tft->print("%");
-    lastBrakeDamageFR = fr;
-  }
-
-  if (rl != lastBrakeDamageRL) {
-    tft->fillRect(5, 220, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(rl > 50 ? COLOR_RED : COLOR_GREEN);
-    tft->setCursor(5, 220);
-    tft->print("B.Dmg: ");
-    tft->print(rl);
-    tft->print("%");
-    lastBrakeDamageRL = rl;
-  }
-
-  if (rr != lastBrakeDamageRR) {
-    tft->fillRect(165, 220, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(rr > 50 ? COLOR_RED : COLOR_GREEN);
-    tft->setCursor(165, 220);
-    tft->print("B.Dmg: ");
-    tft->print(rr);
-    tft->print("%");
-    lastBrakeDamageRR = rr;
+void TelemetryView::updateBestLap(const DirtyMask& dirty) {
+  uint32_t bestLap = model->getBestLapTimeMS();
+  if (dirty.test(FIELD_BEST_LAP_TIME)) {
+    beginWidget(8, 115, 150, 10);
+    if (bestLap > 0) {
+      char buffer[FORMAT_BUFFER_SIZE];
+      formatLapTime(buffer, bestLap);
+      drawGlyphText(gfx, 8, 115, buffer, 1, COLOR_GREEN);
+    } else {
+      drawGlyphText(gfx, 8, 115, "--:--.---", 1, COLOR_GREEN);
+    }
+    endWidget();
   }
 }
 
-// ============================================
-// UPDATE METHODS - CAR DAMAGE SCREEN
-// ============================================
+void TelemetryView::updateLastLap(const DirtyMask& dirty) {
+  uint32_t lastLap = model->getLastLapTimeMS();
+  uint32_t bestLap = model->getBestLapTimeMS();
 
-void TelemetryView::updatePowerUnit() {
-  float icePower = model->getEnginePowerICE();
-  float mgukPower = model->getEnginePowerMGUK();
-  float ersPercent = model->getERSPercent();
-  uint16_t engineTemp = model->getEngineTemp();
-  uint8_t drsFault = model->getDRSFault();
-  uint8_t ersFault = model->getERSFault();
+  if (dirty.test(FIELD_LAST_LAP_TIME)) {
+    beginWidget(8, 137, 150, 17);
 
-  if (abs(icePower - lastICEPower) > 1.0f) {
-    tft->fillRect(60, 25, 90, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_GREEN);
-    tft->setCursor(60, 25);
-    tft->print((int)icePower);
-    tft->print(" kW");
-    lastICEPower = icePower;
-  }
-
-  if (abs(mgukPower - lastMGUKPower) > 1.0f) {
-    tft->fillRect(60, 40, 90, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_GREEN);
-    tft->setCursor(60, 40);
-    tft->print((int)mgukPower);
-    tft->print(" kW");
-    lastMGUKPower = mgukPower;
-  }
-
-  if (abs(ersPercent - lastERSPercent) > 1.0f) {
-    tft->fillRect(60, 55, 90, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    uint16_t color = ersPercent < 20 ? COLOR_RED : (ersPercent < 50 ? COLOR_YELLOW : COLOR_GREEN);
-    tft->setTextColor(color);
-    tft->setCursor(60, 55);
-    tft->print((int)ersPercent);
-    tft->print("%");
-    lastERSPercent = ersPercent;
-  }
-
-  if (engineTemp != lastEngineTemp) {
-    tft->fillRect(60, 70, 90, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(engineTemp >= 160 ? COLOR_RED : (engineTemp >= 140 ? COLOR_YELLOW : COLOR_GREEN));
-    tft->setCursor(60, 70);
-    tft->print(engineTemp);
-    tft->print("C");
-    lastEngineTemp = engineTemp;
-  }
-
-  if (drsFault != lastDRSFault || ersFault != lastERSFault) {
-    tft->fillRect(60, 85, 90, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    if (drsFault == 1 || ersFault == 1) {
-      tft->setTextColor(COLOR_RED);
-      tft->setCursor(60, 85);
-      if (drsFault == 1) tft->print("DRS FAULT");
-      else tft->print("ERS FAULT");
+    if (lastLap > 0) {
+      char buffer[FORMAT_BUFFER_SIZE];
+      formatLapTime(buffer, lastLap);
+
+      if (bestLap > 0 && lastLap >= bestLap) {
+        drawGlyphText(gfx, 8, 137, buffer, 1, COLOR_YELLOW);
+        formatSigned(buffer, lastLap - bestLap, 3);
+        drawGlyphText(gfx, 8, 147, buffer, 1, COLOR_YELLOW);
+      } else if (bestLap > 0 && lastLap < bestLap) {
+        drawGlyphText(gfx, 8, 137, buffer, 1, COLOR_GREEN);
+        drawGlyphText(gfx, 8, 147, "BEST!", 1, COLOR_GREEN);
+      } else {
+        drawGlyphText(gfx, 8, 137, buffer, 1, COLOR_WHITE);
+      }
     } else {
-      tft->setTextColor(COLOR_GREEN);
-      tft->setCursor(60, 85);
-      tft->print("OK");
+      drawGlyphText(gfx, 8, 137, "--:--.---", 1, COLOR_DARKGREY);
     }
-    lastDRSFault = drsFault;
-    lastERSFault = ersFault;
+    endWidget();
   }
 }
 
-void TelemetryView::updateAeroDamage() {
+void TelemetryView::updateDamageStatus(const DirtyMask& dirty) {
   uint8_t fl = model->getFrontLeftWingDamage();
   uint8_t fr = model->getFrontRightWingDamage();
-  uint8_t rear = model->getRearWingDamage();
   uint8_t floor = model->getFloorDamage();
   uint8_t diffuser = model->getDiffuserDamage();
-  uint8_t sidepod = model->getSidepodDamage();
-
-  if (fl != lastWingDamageFL) {
-    tft->fillRect(240, 25, 70, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(fl > 40 ? COLOR_RED : (fl > 20 ? COLOR_YELLOW : COLOR_GREEN));
-    tft->setCursor(240, 25);
-    tft->print(fl);
-    tft->print("%");
-    lastWingDamageFL = fl;
-  }
-
-  if (fr != lastWingDamageFR) {
-    tft->fillRect(240, 37, 70, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(fr > 40 ? COLOR_RED : (fr > 20 ? COLOR_YELLOW : COLOR_GREEN));
-    tft->setCursor(240, 37);
-    tft->print(fr);
-    tft->print("%");
-    lastWingDamageFR = fr;
-  }
-
-  if (rear != lastWingDamageRear) {
-    tft->fillRect(240, 49, 70, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(rear > 40 ? COLOR_RED : (rear > 20 ? COLOR_YELLOW : COLOR_GREEN));
-    tft->setCursor(240, 49);
-    tft->print(rear);
-    tft->print("%");
-    lastWingDamageRear = rear;
-  }
-
-  if (floor != lastFloorDamage) {
-    tft->fillRect(240, 61, 70, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(floor > 40 ? COLOR_RED : (floor > 20 ? COLOR_YELLOW : COLOR_GREEN));
-    tft->setCursor(240, 61);
-    tft->print(floor);
-    tft->print("%");
-    lastFloorDamage = floor;
-  }
-
-  if (diffuser != lastDiffuserDamage) {
-    tft->fillRect(240, 73, 70, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(diffuser > 40 ? COLOR_RED : (diffuser > 20 ? COLOR_YELLOW : COLOR_GREEN));
-    tft->setCursor(240, 73);
-    tft->print(diffuser);
-    tft->print("%");
-    lastDiffuserDamage = diffuser;
-  }
-
-  if (sidepod != lastSidepodDamage) {
-    tft->fillRect(240, 85, 70, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(sidepod > 40 ? COLOR_RED : (sidepod > 20 ? COLOR_YELLOW : COLOR_GREEN));
-    tft->setCursor(240, 85);
-    tft->print(sidepod);
-    tft->print("%");
-    lastSidepodDamage = sidepod;
-  }
-}
 
-void TelemetryView::updateComponentWear() {
-  uint8_t gearbox = model->getGearBoxDamage();
-  uint8_t ice = model->getEngineICEWear();
-  uint8_t mguh = model->getEngineMGUHWear();
-  uint8_t mguk = model->getEngineMGUKWear();
-  uint8_t tc = model->getEngineTCWear();
-  uint8_t es = model->getEngineESWear();
-  uint8_t ce = model->getEngineCEWear();
-
-  auto drawWearBar = [this](uint8_t wear, uint8_t lastWear, int y) -> uint8_t {
-    if (wear != lastWear) {
-      tft->fillRect(70, y, 240, 10, COLOR_BLACK);
-      tft->drawRect(70, y + 2, 150, 6, COLOR_DARKGREY);
-
-      int barWidth = (wear * 150) / 100;
-      uint16_t color = wear > 90 ? COLOR_RED : (wear > 70 ? COLOR_YELLOW : COLOR_GREEN);
-      tft->fillRect(71, y + 3, barWidth, 4, color);
-
-      tft->setTextSize(1);
-      tft->setTextColor(color);
-      tft->setCursor(230, y);
-      tft->print(wear);
-      tft->print("%");
-    }
-    return wear;
-  };
+  uint8_t totalDamage = (fl + fr + floor + diffuser) / 4;
 
-  lastGearboxDamage = drawWearBar(gearbox, lastGearboxDamage, 130);
-  lastICEDamage = drawWearBar(ice, lastICEDamage, 145);
-  lastMGUHDamage = drawWearBar(mguh, lastMGUHDamage, 160);
-  lastMGUKDamage = drawWearBar(mguk, lastMGUKDamage, 175);
-  lastTCDamage = drawWearBar(tc, lastTCDamage, 190);
-  lastERSDamage = drawWearBar(es, lastERSDamage, 205);
-  lastCEDamage = drawWearBar(ce, lastCEDamage, 220);
-}
+  if (dirty.test(FIELD_FRONT_LEFT_WING_DAMAGE) || dirty.test(FIELD_FRONT_RIGHT_WING_DAMAGE) ||
+      dirty.test(FIELD_FLOOR_DAMAGE) || dirty.test(FIELD_DIFFUSER_DAMAGE)) {
+    beginWidget(55, 226, 255, 10);
 
-// ============================================
-// UPDATE METHODS - SCREEN 4: RACE OVERVIEW
-// ============================================
+    gfx->drawRect(55, 227, 150, 8, COLOR_DARKGREY);
 
+    int barWidth = (int)((totalDamage / 100.0f) * 150);
+    if (barWidth > 150) barWidth = 150;
 
-void TelemetryView::updateWeather() {
-  uint8_t weather = model->getWeather();
-  if (weather != lastWeather) {
-    tft->fillRect(70, 25, 80, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-
-    const char* weatherText;
-    uint16_t color;
-    switch (weather) {
-      case 0:
-        weatherText = "CLEAR";
-        color = COLOR_CYAN;
-        break;
-      case 1:
-        weatherText = "LT CLOUD";
-        color = COLOR_WHITE;
-        break;
-      case 2:
-        weatherText = "OVERCAST";
-        color = COLOR_DARKGREY;
-        break;
-      case 3:
-        weatherText = "LT RAIN";
-        color = COLOR_YELLOW;
-        break;
-      case 4:
-        weatherText = "HVY RAIN";
-        color = COLOR_YELLOW;
-        break;
-      case 5:
-        weatherText = "STORM";
-        color = COLOR_RED;
-        break;
-      default:
-        weatherText = "UNKNOWN";
-        color = COLOR_WHITE;
-        break;
+    uint16_t color = totalDamage > 50 ? COLOR_RED : (totalDamage > 25 ? COLOR_YELLOW : COLOR_GREEN);
+    if (barWidth > 0) {
+      gfx->fillRect(56, 228, barWidth, 6, color);
     }
 
-    tft->setTextColor(color);
-    tft->setCursor(70, 25);
-    tft->print(weatherText);
-    lastWeather = weather;
+    char text[FORMAT_BUFFER_SIZE];
+    formatPercent(text, totalDamage);
+    drawGlyphText(gfx, 210, 226, text, 1, color);
+    endWidget();
   }
 }
 
-void TelemetryView::updateTrackTemp() {
-  int8_t trackTemp = model->getTrackTemperature();
-  if (trackTemp != lastTrackTemp) {
-    tft->fillRect(70, 40, 80, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    uint16_t color = trackTemp > 40 ? COLOR_RED : (trackTemp > 30 ? COLOR_YELLOW : COLOR_GREEN);
-    tft->setTextColor(color);
-    tft->setCursor(70, 40);
-    tft->print(trackTemp);
-    tft->print("C");
-    lastTrackTemp = trackTemp;
-  }
-}
+// ============================================
+// UPDATE METHODS - SCREEN 5: INPUT TRACE
+// ============================================
 
-void TelemetryView::updateAirTemp() {
-  int8_t airTemp = model->getAirTemperature();
-  if (airTemp != lastAirTemp) {
-    tft->fillRect(70, 55, 80, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    uint16_t color = airTemp > 35 ? COLOR_RED : (airTemp > 25 ? COLOR_YELLOW : COLOR_GREEN);
-    tft->setTextColor(color);
-    tft->setCursor(70, 55);
-    tft->print(airTemp);
-    tft->print("C");
-    lastAirTemp = airTemp;
+// One column per telemetry sample since the last frame; see InputTrace.
+void TelemetryView::updateInputTrace(const DirtyMask& dirty) {
+  if (dirty.test(FIELD_INPUT_SAMPLES)) {
+    inputTrace.update(*model);
   }
 }
 
+// ============================================
+// UPDATE METHODS - SCREEN 6: TRACK MAP
+// ============================================
+
+// The outline only changes with the track, so it is drawn once per
+// version; each motion frame redraws the small rectangles the markers
+// left and entered, with the outline segments that cross them.
+void TelemetryView::updateTrackMap(const DirtyMask& dirty) {
+  const TrackMap& map = model->getTrackMap();
+  const int16_t MARKER = 2;  // Half the player's marker
+
+  if (map.getState() != TrackMap::STATE_READY) {
+    if (!dirty.test(FIELD_TRACK_MAP_VERSION) && !dirty.test(FIELD_TRACK_MAP_PROGRESS)) return;
 
-void TelemetryView::updateSessionType() {
-  uint8_t type = model->getSessionType();
-  if (type != lastSessionType) {
-    tft->fillRect(210, 25, 100, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_MAGENTA);
-    tft->setCursor(210, 25);
-
-    switch (type) {
-      case 0: tft->print("UNKNOWN"); break;
-      case 1: tft->print("FP1"); break;
-      case 2: tft->print("FP2"); break;
-      case 3: tft->print("FP3"); break;
-      case 4: tft->print("FP SHORT"); break;
-      case 5: tft->print("Q1"); break;
-      case 6: tft->print("Q2"); break;
-      case 7: tft->print("Q3"); break;
-      case 8: tft->print("Q SHORT"); break;
-      case 9: tft->print("OSQ"); break;
-      case 10: tft->print("RACE"); break;
-      case 11: tft->print("RACE 2"); break;
-      case 12: tft->print("RACE 3"); break;
-      case 13: tft->print("TIME TRIAL"); break;
-      default: tft->print("SESSION"); break;
+    if (dirty.test(FIELD_TRACK_MAP_VERSION)) {
+      beginWidget(TrackMap::MAP_X, TrackMap::MAP_Y, TrackMap::MAP_WIDTH, TrackMap::MAP_HEIGHT);
+      endWidget();
     }
-    lastSessionType = type;
-  }
-}
 
-void TelemetryView::updateLapInfo() {
-  uint8_t currentLap = model->getCurrentLapNum();
-  uint8_t totalLaps = model->getTotalLaps();
+    char text[FORMAT_BUFFER_SIZE];
+    uint8_t length = 0;
+    if (map.getState() == TrackMap::STATE_NO_TRACK) {
+      length = appendText(text, 0, "NO SESSION DATA");
+    } else if (map.getState() == TrackMap::STATE_WAITING) {
+      length = appendText(text, 0, "WAITING FOR LAP");
+    } else {
+      length = appendText(text, 0, "RECORDING ");
+      length += formatPercent(text + length, model->getTrackMapProgress());
+    }
 
-  if (currentLap != lastCurrentLapInfo || totalLaps != lastTotalLaps) {
-    tft->fillRect(210, 37, 100, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_WHITE);
-    tft->setCursor(210, 37);
-    tft->print(currentLap);
-    tft->print(" / ");
-    tft->print(totalLaps);
-    lastCurrentLapInfo = currentLap;
-    lastTotalLaps = totalLaps;
+    const int16_t y = TrackMap::MAP_Y + TrackMap::MAP_HEIGHT / 2 - 8;
+    beginWidget(TrackMap::MAP_X, y, TrackMap::MAP_WIDTH, 16);
+    drawGlyphText(gfx, SCREEN_WIDTH / 2 - textWidth(length, 2) / 2, y, text, 2, COLOR_YELLOW);
+    endWidget();
+    return;
   }
-}
 
-void TelemetryView::updateSessionTimeLeft() {
-  uint16_t timeLeft = model->getSessionTimeLeft();
-  if (timeLeft != lastSessionTimeLeft) {
-    tft->fillRect(210, 49, 100, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(timeLeft < 300 ? COLOR_RED : COLOR_WHITE);
-    tft->setCursor(210, 49);
-
-    uint16_t minutes = timeLeft / 60;
-    uint16_t seconds = timeLeft % 60;
-
-    if (minutes < 10) tft->print("0");
-    tft->print(minutes);
-    tft->print(":");
-    if (seconds < 10) tft->print("0");
-    tft->print(seconds);
+  if (dirty.test(FIELD_TRACK_MAP_VERSION)) {
+    for (uint8_t i = 0; i < MAX_CARS; i++) {
+      const TelemetryModel::CarPosition& car = model->getCarPosition(i);
+      drawnMarkers[i].x = -1;
+      if (car.x != 0.0f || car.z != 0.0f) {
+        map.toScreen(car.x, car.z, drawnMarkers[i].x, drawnMarkers[i].y);
+      }
+    }
 
-    lastSessionTimeLeft = timeLeft;
+    // Bands sized to fit a compositor tile.
+    const int16_t BAND_ROWS = COMPOSITOR_ARENA_BYTES / ((TrackMap::MAP_WIDTH + 1) / 2);
+    for (int16_t y = 0; y < TrackMap::MAP_HEIGHT; y += BAND_ROWS) {
+      int16_t rows = min(BAND_ROWS, (int16_t)(TrackMap::MAP_HEIGHT - y));
+      drawTrackArea(TrackMap::MAP_X, TrackMap::MAP_Y + y, TrackMap::MAP_WIDTH, rows);
+    }
+    return;
   }
-}
 
-void TelemetryView::updateSafetyCarStatus() {
-  uint8_t status = model->getSafetyCarStatus();
-  if (status != lastSafetyCarStatus) {
-    tft->fillRect(190, 61, 120, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-
-    const char* statusText;
-    uint16_t color;
-    switch (status) {
-      case 0:
-        statusText = "NO";
-        color = COLOR_GREEN;
-        break;
-      case 1:
-        statusText = "FULL";
-        color = COLOR_YELLOW;
-        break;
-      case 2:
-        statusText = "VIRTUAL";
-        color = COLOR_YELLOW;
-        break;
-      case 3:
-        statusText = "FORMATION";
-        color = COLOR_CYAN;
-        break;
-      default:
-        statusText = "NO";
-        color = COLOR_GREEN;
-        break;
+  if (!dirty.test(FIELD_MOTION_FRAMES)) return;
+
+  // Move every marker first so overlapping cars are drawn in their final
+  // places whichever rectangle covers them.
+  TrackMap::Point previous[MAX_CARS];
+  bool moved[MAX_CARS];
+  for (uint8_t i = 0; i < MAX_CARS; i++) {
+    const TelemetryModel::CarPosition& car = model->getCarPosition(i);
+    TrackMap::Point next = { -1, 0 };
+    if (car.x != 0.0f || car.z != 0.0f) {
+      map.toScreen(car.x, car.z, next.x, next.y);
     }
 
-    tft->setTextColor(color);
-    tft->setCursor(210, 61);
-    tft->print(statusText);
-    lastSafetyCarStatus = status;
+    previous[i] = drawnMarkers[i];
+    moved[i] = next.x != previous[i].x || next.y != previous[i].y;
+    drawnMarkers[i] = next;
   }
-}
 
-void TelemetryView::updateBestLap() {
-  uint32_t bestLap = model->getBestLapTimeMS();
-  if (bestLap != lastBestLapTime) {
-    tft->fillRect(8, 115, 150, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_GREEN);
-    tft->setCursor(8, 115);
+  for (uint8_t i = 0; i < MAX_CARS; i++) {
+    if (!moved[i]) continue;
 
-    if (bestLap > 0) {
-      char buffer[16];
-      model->formatLapTime(bestLap, buffer);
-      tft->print(buffer);
+    const TrackMap::Point& from = previous[i];
+    const TrackMap::Point& to = drawnMarkers[i];
+    if (from.x < 0 || to.x < 0) {
+      const TrackMap::Point& shown = from.x < 0 ? to : from;
+      drawTrackArea(shown.x - MARKER, shown.y - MARKER, 2 * MARKER + 1, 2 * MARKER + 1);
+      continue;
+    }
+
+    // A car moves a pixel or two per frame, so one rectangle usually
+    // covers both places.
+    int16_t left = min(from.x, to.x) - MARKER;
+    int16_t top = min(from.y, to.y) - MARKER;
+    int16_t width = abs(from.x - to.x) + 2 * MARKER + 1;
+    int16_t height = abs(from.y - to.y) + 2 * MARKER + 1;
+    if (width * height <= 4 * (2 * MARKER + 1) * (2 * MARKER + 1)) {
+      drawTrackArea(left, top, width, height);
     } else {
-      tft->print("--:--.---");
+      drawTrackArea(from.x - MARKER, from.y - MARKER, 2 * MARKER + 1, 2 * MARKER + 1);
+      drawTrackArea(to.x - MARKER, to.y - MARKER, 2 * MARKER + 1, 2 * MARKER + 1);
     }
-    lastBestLapTime = bestLap;
   }
 }
 
-void TelemetryView::updateLastLap() {
-  uint32_t lastLap = model->getLastLapTimeMS();
-  uint32_t bestLap = model->getBestLapTimeMS();
+// Each new trail point costs a handful of 3x3 redraws: the point itself,
+// the one it overwrites in the history, and the points whose age just
+// crossed into the next colour. Only a backlog of a quarter trail or
+// more redraws the whole circle.
+void TelemetryView::updateGForce(const DirtyMask& dirty) {
+  if (!dirty.test(FIELD_GFORCE_SAMPLES)) return;
 
-  if (lastLap != lastLastLapTime) {
-    tft->fillRect(8, 137, 150, 17, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setCursor(8, 137);
+  const int16_t DOT = 1;  // Half a trail point
+  const float REACH = GFORCE_RADIUS - DOT;
+  const float PIXELS_PER_CENTI_G = GFORCE_RADIUS / (GFORCE_RANGE * 100.0f);
+  const int16_t QUARTER = GFORCE_HISTORY_POINTS / 4;
+  static_assert(GFORCE_HISTORY_POINTS % 4 == 0, "trail colours change every quarter");
 
-    if (lastLap > 0) {
-      char buffer[16];
-      model->formatLapTime(lastLap, buffer);
+  uint32_t total = model->getGForceSamples();
+  bool redrawAll = !gForceTrailDrawn || total - drawnGForceSamples >= (uint32_t)QUARTER;
+  if (redrawAll) {
+    drawnGForceSamples = total > GFORCE_HISTORY_POINTS ? total - GFORCE_HISTORY_POINTS : 0;
+  }
+  uint32_t added = total - drawnGForceSamples;
 
-      if (bestLap > 0 && lastLap >= bestLap) {
-        uint32_t delta = lastLap - bestLap;
-        tft->setTextColor(COLOR_YELLOW);
-        tft->print(buffer);
-        tft->setCursor(8, 147);
-        tft->print("+");
-        tft->print(delta / 1000.0f, 3);
-      } else if (bestLap > 0 && lastLap < bestLap) {
-        tft->setTextColor(COLOR_GREEN);
-        tft->print(buffer);
-        tft->setCursor(8, 147);
-        tft->print("BEST!");
-      } else {
-        tft->setTextColor(COLOR_WHITE);
-        tft->print(buffer);
-      }
-    } else {
-      tft->setTextColor(COLOR_DARKGREY);
-      tft->print("--:--.---");
-    }
-    lastLastLapTime = lastLap;
+  // Move every point first, as the track map does its markers, so areas
+  // that overlap show the same pixels whichever reaches the panel last.
+  TrackMap::Point expired[QUARTER];
+  uint8_t expiredCount = 0;
+  while (drawnGForceSamples != total) {
+    uint32_t index = drawnGForceSamples;
+    TrackMap::Point& slot = drawnGForce[index % GFORCE_HISTORY_POINTS];
+    if (!redrawAll && index >= GFORCE_HISTORY_POINTS) expired[expiredCount++] = slot;
+
+    const TelemetryModel::GForceSample& sample = model->getGForceSample(index);
+    float dx = constrain(sample.lateral * PIXELS_PER_CENTI_G, -REACH, REACH);
+    float dy = constrain(sample.longitudinal * PIXELS_PER_CENTI_G, -REACH, REACH);
+    slot.x = GFORCE_CENTER_X + (int16_t)dx;
+    slot.y = GFORCE_CENTER_Y - (int16_t)dy;
+    drawnGForceSamples++;
   }
-}
 
-void TelemetryView::updateSectorTimes() {
-  uint16_t sector1 = model->getSector1TimeMS();
-  uint16_t sector2 = model->getSector2TimeMS();
-
-  if (sector1 != lastSector1Time) {
-    tft->fillRect(165, 115, 145, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_CYAN);
-    tft->setCursor(165, 115);
-    if (sector1 > 0) {
-      tft->print(sector1 / 1000.0f, 3);
-      tft->print("s");
-    } else {
-      tft->print("--");
-    }
-    lastSector1Time = sector1;
+  if (redrawAll) {
+    drawGForceArea(GFORCE_CENTER_X - GFORCE_RADIUS, GFORCE_CENTER_Y - GFORCE_RADIUS, 2 * GFORCE_RADIUS + 1,
+                   2 * GFORCE_RADIUS + 1);
+    gForceTrailDrawn = true;
+    return;
   }
+  if (added == 0) return;
 
-  if (sector2 != lastSector2Time) {
-    tft->fillRect(165, 137, 145, 10, COLOR_BLACK);
-    tft->setTextSize(1);
-    tft->setTextColor(COLOR_CYAN);
-    tft->setCursor(165, 137);
-    if (sector2 > 0) {
-      tft->print(sector2 / 1000.0f, 3);
-      tft->print("s");
-    } else {
-      tft->print("--");
-    }
-    lastSector2Time = sector2;
+  for (uint8_t i = 0; i < expiredCount; i++) {
+    drawGForceArea(expired[i].x - DOT, expired[i].y - DOT, 2 * DOT + 1, 2 * DOT + 1);
+  }
+  // Ages below added are new and age added was the red head; any other
+  // changed colour if it crossed a quarter since the last call.
+  uint32_t count = total < GFORCE_HISTORY_POINTS ? total : GFORCE_HISTORY_POINTS;
+  for (uint32_t age = 0; age < count; age++) {
+    if (age > added && age % QUARTER >= added) continue;
+    const TrackMap::Point& point = drawnGForce[(total - 1 - age) % GFORCE_HISTORY_POINTS];
+    drawGForceArea(point.x - DOT, point.y - DOT, 2 * DOT + 1, 2 * DOT + 1);
   }
 }
 
+// Redraws one rectangle of the friction circle: the guides, then the
+// trail oldest first, fading from white to grey, with the newest in red.
+void TelemetryView::drawGForceArea(int16_t x, int16_t y, int16_t w, int16_t h) {
+  static const uint16_t AGE_COLORS[4] = { COLOR_WHITE, COLOR_YELLOW, COLOR_ORANGE, COLOR_DARKGREY };
 
-void TelemetryView::updateFuelStatus() {
-  float fuelLaps = model->getFuelRemainingLaps();
-  if (abs(fuelLaps - lastFuelRemaining) > 0.1f) {
-    tft->fillRect(55, 181, 255, 10, COLOR_BLACK);
-
-    tft->drawRect(55, 182, 150, 8, COLOR_DARKGREY);
-
-    int barWidth = (int)((fuelLaps / 20.0f) * 150);
-    if (barWidth > 150) barWidth = 150;
-
-    uint16_t color = fuelLaps < 3 ? COLOR_RED : (fuelLaps < 5 ? COLOR_YELLOW : COLOR_GREEN);
-    if (barWidth > 0) {
-      tft->fillRect(56, 183, barWidth, 6, color);
-    }
+  beginWidget(x, y, w, h);
+  drawGForceGuides(gfx);
 
-    tft->setTextSize(1);
-    tft->setTextColor(color);
-    tft->setCursor(210, 181);
-    tft->print(fuelLaps, 1);
-    tft->print(" laps");
+  uint32_t count = drawnGForceSamples < GFORCE_HISTORY_POINTS ? drawnGForceSamples : GFORCE_HISTORY_POINTS;
+  for (uint32_t age = count; age-- > 0;) {
+    const TrackMap::Point& point = drawnGForce[(drawnGForceSamples - 1 - age) % GFORCE_HISTORY_POINTS];
+    if (point.x + 1 < x || point.x - 1 >= x + w || point.y + 1 < y || point.y - 1 >= y + h) continue;
 
-    lastFuelRemaining = fuelLaps;
+    uint16_t color = age == 0 ? COLOR_RED : AGE_COLORS[age * 4 / GFORCE_HISTORY_POINTS];
+    gfx->fillRect(point.x - 1, point.y - 1, 3, 3, color);
   }
+  endWidget();
 }
 
-void TelemetryView::updateTyreStatus() {
-  uint8_t tyreAge = model->getTyresAgeLaps();
-  if (tyreAge != lastTyresAge) {
-    tft->fillRect(55, 196, 255, 10, COLOR_BLACK);
+// Redraws one rectangle of the map: the outline segments whose bounds
+// cross it, then the markers inside it, the player last and on top.
+void TelemetryView::drawTrackArea(int16_t x, int16_t y, int16_t w, int16_t h) {
+  const TrackMap& map = model->getTrackMap();
+  const TrackMap::Point* outline = map.getOutline();
+  uint8_t count = map.getOutlineCount();
 
-    tft->drawRect(55, 197, 150, 8, COLOR_DARKGREY);
+  beginWidget(x, y, w, h);
+  for (uint8_t i = 0; i < count; i++) {
+    const TrackMap::Point& a = outline[i];
+    const TrackMap::Point& b = outline[(i + 1) % count];
+    if (max(a.x, b.x) < x || min(a.x, b.x) >= x + w || max(a.y, b.y) < y || min(a.y, b.y) >= y + h) continue;
+    gfx->drawLine(a.x, a.y, b.x, b.y, COLOR_DARKGREY);
+  }
 
-    int barWidth = (int)((tyreAge / 30.0f) * 150);
-    if (barWidth > 150) barWidth = 150;
+  uint8_t player = model->getPlayerCarIndex();
+  for (uint8_t n = 0; n <= MAX_CARS; n++) {
+    // n == MAX_CARS is the player's turn.
+    uint8_t i = n < MAX_CARS ? n : player;
+    if (n < MAX_CARS && i == player) continue;
 
-    uint16_t color = tyreAge > 25 ? COLOR_RED : (tyreAge > 15 ? COLOR_YELLOW : COLOR_GREEN);
-    if (barWidth > 0) {
-      tft->fillRect(56, 198, barWidth, 6, color);
+    const TrackMap::Point& marker = drawnMarkers[i];
+    int16_t half = i == player ? 2 : 1;
+    if (marker.x < 0 || marker.x + half < x || marker.x - half >= x + w || marker.y + half < y ||
+        marker.y - half >= y + h) {
+      continue;
     }
-
-    tft->setTextSize(1);
-    tft->setTextColor(color);
-    tft->setCursor(210, 196);
-    tft->print(tyreAge);
-    tft->print(" laps");
-
-    lastTyresAge = tyreAge;
+    gfx->fillRect(marker.x - half, marker.y - half, 2 * half + 1, 2 * half + 1,
+                  i == player ? COLOR_RED : COLOR_CYAN);
   }
+  endWidget();
 }
 
-void TelemetryView::updateEngineStatus() {
-  uint16_t engineTemp = model->getEngineTemp();
-  if (engineTemp != lastEngineTempCritical) {
-    tft->fillRect(55, 211, 255, 10, COLOR_BLACK);
+// ============================================
+// UPDATE METHODS - SCREEN 7: LAP HISTORY
+// ============================================
 
-    tft->drawRect(55, 212, 150, 8, COLOR_DARKGREY);
+// The rows only change when the player completes a lap, or a flashback
+// rebuilds the history, so all of them are redrawn then, a tile each.
+void TelemetryView::updateLapHistory(const DirtyMask& dirty) {
+  if (!dirty.test(FIELD_LAP_HISTORY)) return;
+
+  const LapHistory& history = model->getLapHistory();
+  uint8_t car = model->getPlayerCarIndex();
+  uint8_t count = history.getLapCount(car);
+  LapHistory::Stats stats;
+  history.getStats(car, stats);
+
+  for (uint8_t row = 0; row < LAP_HISTORY_ROWS; row++) {
+    int16_t y = LAP_ROWS_Y + row * LAP_ROW_HEIGHT;
+    beginWidget(4, y, 312, 8);
+    if (row >= count) {
+      if (count == 0 && row == 0) drawGlyphText(gfx, LAP_COLUMN_X, y, "NO COMPLETED LAPS", 1, COLOR_DARKGREY);
+      endWidget();
+      continue;
+    }
 
-    int barWidth = (int)(((engineTemp - 80) / 100.0f) * 150);
-    if (barWidth < 0) barWidth = 0;
-    if (barWidth > 150) barWidth = 150;
+    uint8_t index = count - 1 - row;
+    const LapHistory::Lap& lap = history.getLap(car, index);
+    uint8_t flags = LapHistory::getFlags(lap);
+    char text[FORMAT_BUFFER_SIZE];
 
-    uint16_t color = engineTemp >= 160 ? COLOR_RED : (engineTemp >= 140 ? COLOR_YELLOW : COLOR_GREEN);
-    if (barWidth > 0) {
-      tft->fillRect(56, 213, barWidth, 6, color);
-    }
+    formatFixed(text, index + 1, 0);
+    drawGlyphText(gfx, LAP_COLUMN_X, y, text, 1, COLOR_DARKGREY);
 
-    tft->setTextSize(1);
-    tft->setTextColor(color);
-    tft->setCursor(210, 211);
-    tft->print(engineTemp);
-    tft->print("C");
+    uint16_t color = COLOR_WHITE;
+    if (!(flags & LapHistory::LAP_VALID)) color = COLOR_RED;
+    else if (stats.laps > 0 && index == stats.bestLap) color = COLOR_MAGENTA;
+    formatLapTime(text, LapHistory::getLapTimeMS(lap));
+    drawGlyphText(gfx, TIME_COLUMN_X, y, text, 1, color);
 
-    lastEngineTempCritical = engineTemp;
+    uint16_t sectors[3] = { lap.sector1MS, lap.sector2MS, LapHistory::getSector3MS(lap) };
+    for (uint8_t i = 0; i < 3; i++) {
+      if (sectors[i] == LapHistory::SECTOR_OVERFLOW) {
+        appendText(text, 0, ">65");
+      } else {
+        formatSeconds(text, sectors[i]);
+      }
+      bool valid = flags & (LapHistory::SECTOR1_VALID << i);
+      drawGlyphText(gfx, SECTOR_COLUMN_X[i], y, text, 1, valid ? COLOR_WHITE : COLOR_RED);
+    }
+    endWidget();
   }
 }
 
-void TelemetryView::updateDamageStatus() {
-  uint8_t fl = model->getFrontLeftWingDamage();
-  uint8_t fr = model->getFrontRightWingDamage();
-  uint8_t floor = model->getFloorDamage();
-  uint8_t diffuser = model->getDiffuserDamage();
+// Best, median and spread of the player's valid laps; LapHistory keeps
+// them current as laps arrive, so this is three lookups.
+void TelemetryView::updateLapConsistency(const DirtyMask& dirty) {
+  if (!dirty.test(FIELD_LAP_HISTORY)) return;
 
-  uint8_t totalDamage = (fl + fr + floor + diffuser) / 4;
+  LapHistory::Stats stats;
+  model->getLapHistory().getStats(model->getPlayerCarIndex(), stats);
 
-  if (totalDamage != lastOverallDamage) {
-    tft->fillRect(55, 226, 255, 10, COLOR_BLACK);
+  beginWidget(4, 206, 312, 30);
+  char text[FORMAT_BUFFER_SIZE];
+  if (stats.laps == 0) {
+    drawGlyphText(gfx, 8, 206, "--:--.---", 2, COLOR_DARKGREY);
+    drawGlyphText(gfx, 110, 206, "--:--.---", 2, COLOR_DARKGREY);
+    drawGlyphText(gfx, 212, 206, "-.---", 2, COLOR_DARKGREY);
+  } else {
+    formatLapTime(text, stats.bestMS);
+    drawGlyphText(gfx, 8, 206, text, 2, COLOR_MAGENTA);
+    formatLapTime(text, stats.medianMS);
+    drawGlyphText(gfx, 110, 206, text, 2, COLOR_WHITE);
+    uint8_t length = formatSeconds(text, (uint32_t)lroundf(stats.stddevMS));
+    appendText(text, length, "s");
+    drawGlyphText(gfx, 212, 206, text, 2, COLOR_WHITE);
+  }
 
-    tft->drawRect(55, 227, 150, 8, COLOR_DARKGREY);
+  uint8_t length = formatFixed(text, stats.laps, 0);
+  appendText(text, length, stats.laps == 1 ? " VALID LAP" : " VALID LAPS");
+  drawGlyphText(gfx, 8, 226, text, 1, COLOR_DARKGREY);
+  endWidget();
+}
 
-    int barWidth = (int)((totalDamage / 100.0f) * 150);
-    if (barWidth > 150) barWidth = 150;
+// ============================================
+// UPDATE METHODS - SCREEN 8: STRATEGY
+// ============================================
 
-    uint16_t color = totalDamage > 50 ? COLOR_RED : (totalDamage > 25 ? COLOR_YELLOW : COLOR_GREEN);
-    if (barWidth > 0) {
-      tft->fillRect(56, 228, barWidth, 6, color);
+// Sidewall colours, with cyan for the wet's blue so it reads on black.
+static uint16_t compoundColor(uint8_t visualCompound) {
+  switch (visualCompound) {
+    case 16: return COLOR_RED;
+    case 17: return COLOR_YELLOW;
+    case 18: return COLOR_WHITE;
+    case 7: return COLOR_GREEN;
+    case 8: return COLOR_CYAN;
+    default: return COLOR_DARKGREY;
+  }
+}
+
+void TelemetryView::updateFittedTyre(const DirtyMask& dirty) {
+  if (!dirty.test(FIELD_VISUAL_TYRE_COMPOUND) && !dirty.test(FIELD_TYRES_AGE_LAPS)) return;
+
+  uint8_t compound = model->getVisualTyreCompound();
+  beginWidget(208, 44, 104, 30);
+  drawGlyphText(gfx, 208, 44, TyreSetTable::compoundName(compound), 2, compoundColor(compound));
+
+  char text[FORMAT_BUFFER_SIZE];
+  uint8_t length = appendText(text, 0, "AGE ");
+  length += formatFixed(text + length, model->getTyresAgeLaps(), 0);
+  appendText(text, length, " LAPS");
+  drawGlyphText(gfx, 208, 64, text, 1, COLOR_WHITE);
+  endWidget();
+}
+
+// One tile per row; the table only changes when a set is fitted, used
+// or wears, which the controller filters down to real changes.
+void TelemetryView::updateTyreSets(const DirtyMask& dirty) {
+  if (!dirty.test(FIELD_TYRE_SETS)) return;
+
+  const TyreSetTable& sets = model->getTyreSets();
+  for (uint8_t row = 0; row < TYRE_SET_ROWS; row++) {
+    int16_t y = SET_ROWS_Y + row * SET_ROW_HEIGHT;
+    beginWidget(4, y, 192, 8);
+    if (row >= sets.getCount()) {
+      if (sets.getCount() == 0 && row == 0) drawGlyphText(gfx, SET_COMPOUND_X, y, "NO TYRE DATA", 1, COLOR_DARKGREY);
+      endWidget();
+      continue;
     }
 
-    tft->setTextSize(1);
-    tft->setTextColor(color);
-    tft->setCursor(210, 226);
-    tft->print(totalDamage);
-    tft->print("%");
+    const TyreSetTable::TyreSet& set = sets.getSet(row);
+    char text[FORMAT_BUFFER_SIZE];
+    uint8_t length = appendText(text, 0, TyreSetTable::compoundName(set.visualCompound));
+    if (set.fitted) appendText(text, length, "*");
+    drawGlyphText(gfx, SET_COMPOUND_X, y, text, 1, compoundColor(set.visualCompound));
+
+    formatPercent(text, set.wear);
+    drawGlyphText(gfx, SET_WEAR_X, y, text, 1, set.wear > 50 ? COLOR_ORANGE : COLOR_WHITE);
+    formatFixed(text, set.lifeSpan, 0);
+    drawGlyphText(gfx, SET_LIFE_X, y, text, 1, COLOR_WHITE);
+    formatSigned(text, set.lapDeltaMS, 3);
+    drawGlyphText(gfx, SET_DELTA_X, y, text, 1, set.lapDeltaMS > 0 ? COLOR_ORANGE : COLOR_GREEN);
+    endWidget();
+  }
+}
+
+// The ranking is worked out when the table changes; see TyreSetTable.
+void TelemetryView::updateTyreSuggestions(const DirtyMask& dirty) {
+  if (!dirty.test(FIELD_TYRE_SETS)) return;
+
+  const TyreSetTable& sets = model->getTyreSets();
+  beginWidget(208, 92, 104, 32);
+  if (sets.getSuggestionCount() == 0) {
+    drawGlyphText(gfx, 208, 92, "NONE", 1, COLOR_DARKGREY);
+  }
+  for (uint8_t rank = 0; rank < sets.getSuggestionCount(); rank++) {
+    const TyreSetTable::TyreSet& set = sets.getSuggestion(rank);
+    int16_t y = 92 + rank * 12;
+    char text[FORMAT_BUFFER_SIZE];
+    uint8_t length = appendText(text, 0, TyreSetTable::compoundName(set.visualCompound));
+    length = appendText(text, length, " ");
+    formatPercent(text + length, set.wear);
+    drawGlyphText(gfx, 208, y, text, 1, compoundColor(set.visualCompound));
+
+    length = formatSigned(text, set.lapDeltaMS, 3);
+    drawGlyphText(gfx, 312 - textWidth(length, 1), y, text, 1, COLOR_WHITE);
+  }
+  endWidget();
+}
+
+// The search runs in the background (see StrategyPlanner); this only
+// draws its latest result, against the game's own ideal lap.
+void TelemetryView::updateStrategyPlan(const DirtyMask& dirty) {
+  if (!dirty.test(FIELD_STRATEGY_PLAN) && !dirty.test(FIELD_PIT_LOSS) && !dirty.test(FIELD_PIT_WINDOW_IDEAL_LAP)) return;
+
+  const StrategyPlanner::Plan& plan = model->getStrategyPlan();
+  char text[FORMAT_BUFFER_SIZE];
+  uint8_t length;
+  beginWidget(8, 200, 188, 32);
+
+  if (!plan.valid) {
+    drawGlyphText(gfx, 8, 200, "NO PLAN", 1, COLOR_DARKGREY);
+  } else {
+    static const char* const names[] = { "STAY OUT", "1 STOP", "2 STOPS" };
+    length = appendText(text, 0, names[plan.stops]);
+    drawGlyphText(gfx, 8, 200, text, 1, COLOR_WHITE);
+    if (plan.marginMS > 0) {
+      int16_t x = 8 + textWidth(length + 1, 1);
+      formatSigned(text, plan.marginMS / 100, 1);
+      drawGlyphText(gfx, x, 200, text, 1, COLOR_GREEN);
+    }
+    if (plan.raceTimeMS > 0) {
+      length = appendText(text, 0, "FLAG ");
+      length += formatLapTime(text + length, plan.raceTimeMS, 0);
+      drawGlyphText(gfx, 196 - textWidth(length, 1), 200, text, 1, COLOR_WHITE);
+    }
 
-    lastOverallDamage = totalDamage;
+    int16_t x = 8;
+    for (uint8_t i = 0; i < plan.stops; i++) {
+      length = appendText(text, 0, "L");
+      length += formatFixed(text + length, plan.pitLap[i], 0);
+      length = appendText(text, length, " ");
+      length = appendText(text, length, TyreSetTable::compoundName(plan.compound[i]));
+      drawGlyphText(gfx, x, 212, text, 1, compoundColor(plan.compound[i]));
+      x += textWidth(length + 2, 1);
+    }
   }
+
+  length = appendText(text, 0, "LOSS ");
+  length += formatSeconds(text + length, model->getPitLossMS(), 1);
+  appendText(text, length, "s");
+  drawGlyphText(gfx, 8, 224, text, 1, COLOR_DARKGREY);
+  if (model->getPitWindowIdealLap() > 0) {
+    length = appendText(text, 0, "GAME L");
+    length += formatFixed(text + length, model->getPitWindowIdealLap(), 0);
+    drawGlyphText(gfx, 196 - textWidth(length, 1), 224, text, 1, COLOR_DARKGREY);
+  }
+  endWidget();
 }
 
 // ============================================
@@ -1973,7 +2079,7 @@ void TelemetryView::drawBootAnimation(uint32_t elapsedMS) {
   static uint8_t lastBrightness = 0;
 
   if (!initialized) {
-    tft->fillScreen(COLOR_BLACK);
+    panel->fillScreen(COLOR_BLACK);
     initialized = true;
   }
 
@@ -1985,11 +2091,12 @@ void TelemetryView::drawBootAnimation(uint32_t elapsedMS) {
 
   uint16_t fadedRed = tft->color565(brightness, 0, 0);
 
-  tft->drawBitmap(10, 80, F1_LOGO, 300, 75, fadedRed);
+  panel->drawBitmap(10, 80, F1_LOGO, 300, 75, fadedRed);
 }
 
 void TelemetryView::resetBootInfo() {
-  tft->fillScreen(COLOR_BLACK);
+  inputTrace.deactivate();
+  panel->fillScreen(COLOR_BLACK);
   bootInfoDrawn = false;
 
   pixels->clear();
@@ -2001,14 +2108,16 @@ void TelemetryView::drawBootInfo(IPAddress ip) {
   static IPAddress lastIP = IPAddress(0, 0, 0, 0);
 
   if (ip != lastIP || !bootInfoDrawn) {
-    tft->fillScreen(COLOR_BLACK);
-    tft->drawBitmap(10, 40, F1_LOGO, 300, 75, COLOR_RED);
-
-    tft->setTextSize(2);
-    tft->setTextColor(COLOR_GREEN);
-    tft->setCursor(60, 140);
-    tft->print("IP: ");
-    tft->print(ip);
+    panel->fillScreen(COLOR_BLACK);
+    panel->drawBitmap(10, 40, F1_LOGO, 300, 75, COLOR_RED);
+
+    char text[FORMAT_BUFFER_SIZE];
+    uint8_t length = appendText(text, 0, "IP: ");
+    for (uint8_t i = 0; i < 4; i++) {
+      if (i > 0) length = appendText(text, length, ".");
+      length += formatFixed(text + length, ip[i], 0);
+    }
+    drawGlyphText(panel, 60, 140, text, 2, COLOR_GREEN);
 
     bootInfoDrawn = true;
     lastIP = ip;
@@ -2022,17 +2131,17 @@ void TelemetryView::drawBootInfo(IPAddress ip) {
     uint8_t dotCount = ((now / 500) % 4);
 
     if (dotCount != lastDotCount) {
-      tft->fillRect(30, 170, 260, 20, COLOR_BLACK);
-
-      tft->setTextSize(2);
-      tft->setTextColor(COLOR_YELLOW);
-      tft->setCursor(30, 170);
-      tft->print("Waiting for data");
-
+      char text[FORMAT_BUFFER_SIZE];
+      uint8_t length = appendText(text, 0, "Waiting for data");
       for (uint8_t i = 0; i < dotCount; i++) {
-        tft->print(".");
+        length = appendText(text, length, ".");
       }
 
+      beginWidget(30, 170, 260, 20);
+      drawGlyphText(gfx, 30, 170, text, 2, COLOR_YELLOW);
+      endWidget();
+      compositor.flush();
+
       lastDotCount = dotCount;
     }
 
@@ -6,6 +6,14 @@
 #include <Adafruit_NeoPixel.h>
 #include "Model.h"
 #include "Config.h"
+#include "Compositor.h"
+#include "TftDisplayBus.h"
+#include "BusCanvas.h"
+#include "WidgetSpec.h"
+#include "Background.h"
+#include "InputTrace.h"
+#include "Events.h"
+#include "Trace.h"
 
 class TelemetryView {
 public:
@@ -16,7 +24,48 @@ public:
     SCREEN_GENERAL = 0,
     SCREEN_TYRE_INFO = 1,
     SCREEN_CAR_INFO = 2,
-    SCREEN_SESSION_INFO = 3
+    SCREEN_SESSION_INFO = 3,
+    SCREEN_INPUT_TRACE = 4,
+    SCREEN_TRACK_MAP = 5,
+    SCREEN_LAP_HISTORY = 6,
+    SCREEN_STRATEGY = 7
+  };
+  static const uint8_t SCREEN_COUNT = 8;
+
+  // ============================================
+  // Widget Scheduling
+  // ============================================
+  // Lower value runs first. Critical widgets run every frame they are
+  // dirty, whatever the budget; the rest are rate-limited and deferred to
+  // later frames when the budget runs out.
+  enum WidgetPriority {
+    PRIORITY_CRITICAL = 0,
+    PRIORITY_HIGH = 1,
+    PRIORITY_NORMAL = 2,
+    PRIORITY_LOW = 3
+  };
+
+  static const uint8_t WIDGET_MAX_FIELDS = 8;
+  static const uint8_t MAX_SCREEN_WIDGETS = 24;
+
+  // Either update is set and fields lists what dirties it, or update is
+  // NULL and the widget is a table of value widgets drawn by drawSpec().
+  struct Widget {
+    const char* name;
+    void (TelemetryView::*update)(const DirtyMask& dirty);
+    uint8_t priority;
+    uint16_t minIntervalMS;
+    ModelField fields[WIDGET_MAX_FIELDS];  // Terminated by FIELD_COUNT
+    const WidgetSpec* specs;
+    uint8_t specCount;
+  };
+
+  struct WidgetStats {
+    uint32_t runs;
+    uint32_t deferrals;
+    uint32_t totalLatencyMicros;  // Dirty to drawn
+    uint32_t maxLatencyMicros;
+    uint16_t costMicros;          // Smoothed draw time
   };
 
 private:
@@ -35,127 +84,107 @@ private:
   bool bootInfoDrawn;
 
   // ============================================
-  // Dirty Tracking - SCREEN 1: GENERAL
+  // Rendering State
   // ============================================
-  uint8_t lastPosition;
-  uint16_t lastDeltaFront;
-  uint16_t lastDeltaLeader;
-  float lastDeltaLive;
-
-  uint32_t lastLapTime;
-  uint32_t lastCurrentLapTime;
-  uint16_t lastSector1;
-  uint16_t lastSector2;
-  uint8_t lastCurrentLapNum;
-  uint8_t lastCornerCuttingWarnings;
-
-  uint16_t lastSpeed;
-  float lastThrottle;
-  float lastBrake;
-  int8_t lastGear;
-  uint16_t lastRPM;
-
-  uint8_t lastDRS;
-  uint8_t lastRevLightsPercent;
-  int8_t lastSuggestedGear;
-  uint8_t lastFrontBrakeBias;
-  uint8_t lastDiffOnThrottle;
-
-  float lastFuelInTank;
-  float lastFuelRemainingLaps;
-  float lastERSEnergy;
-  uint8_t lastERSMode;
-
+  // Incremental bars redraw only the delta against what is on the panel;
+  // -1 forces a full redraw after a screen switch.
+  int16_t drawnThrottleHeight;
+  int16_t drawnBrakeHeight;
+  int16_t drawnERSWidth;
   int lastLedsOn;
 
-  // ============================================
-  // Dirty Tracking - SCREEN 2: TYRE INFO
-  // ============================================
-  uint8_t lastTyresAgeLaps;
-
-  uint16_t lastBrakeTempFL;
-  uint16_t lastBrakeTempFR;
-  uint16_t lastBrakeTempRL;
-  uint16_t lastBrakeTempRR;
-
-  uint8_t lastTyreSurfTempFL;
-  uint8_t lastTyreSurfTempFR;
-  uint8_t lastTyreSurfTempRL;
-  uint8_t lastTyreSurfTempRR;
-
-  uint8_t lastTyreInnerTempFL;
-  uint8_t lastTyreInnerTempFR;
-  uint8_t lastTyreInnerTempRL;
-  uint8_t lastTyreInnerTempRR;
-
-  float lastTyrePressureFL;
-  float lastTyrePressureFR;
-  float lastTyrePressureRL;
-  float lastTyrePressureRR;
-
-  float lastTyreWearFL;
-  float lastTyreWearFR;
-  float lastTyreWearRL;
-  float lastTyreWearRR;
-
-  uint8_t lastTyreDamageFL;
-  uint8_t lastTyreDamageFR;
-  uint8_t lastTyreDamageRL;
-  uint8_t lastTyreDamageRR;
-
-  uint8_t lastBrakeDamageFL;
-  uint8_t lastBrakeDamageFR;
-  uint8_t lastBrakeDamageRL;
-  uint8_t lastBrakeDamageRR;
-
-  // ============================================
-  // Dirty Tracking - SCREEN 3: CAR INFO
-  // ============================================
-  float lastICEPower;
-  float lastMGUKPower;
-  float lastERSPercent;
-  uint16_t lastEngineTemp;
-  uint8_t lastDRSFault;
-  uint8_t lastERSFault;
-
-  uint8_t lastWingDamageFL;
-  uint8_t lastWingDamageFR;
-  uint8_t lastWingDamageRear;
-  uint8_t lastFloorDamage;
-  uint8_t lastDiffuserDamage;
-  uint8_t lastSidepodDamage;
-
-  uint8_t lastGearboxDamage;
-  uint8_t lastICEDamage;
-  uint8_t lastMGUHDamage;
-  uint8_t lastMGUKDamage;
-  uint8_t lastTCDamage;
-  uint8_t lastERSDamage;
-  uint8_t lastCEDamage;
-
-
-  // ============================================
-  // Dirty Tracking - SCREEN 4: RACE OVERVIEW
-  // ============================================
-  uint8_t lastWeather;
-  int8_t lastTrackTemp;
-  int8_t lastAirTemp;
-
-  uint8_t lastSessionType;
-  uint8_t lastCurrentLapInfo;
-  uint8_t lastTotalLaps;
-  uint16_t lastSessionTimeLeft;
-  uint8_t lastSafetyCarStatus;
-
-  uint32_t lastBestLapTime;
-  uint32_t lastLastLapTime;
-  uint16_t lastSector1Time;
-  uint16_t lastSector2Time;
-
-  float lastFuelRemaining;
-  uint8_t lastTyresAge;
-  uint16_t lastEngineTempCritical;
-  uint8_t lastOverallDamage;
+  // Per-widget scheduling state for the current screen; stats are kept
+  // for every screen.
+  struct WidgetState {
+    DirtyMask pending;
+    bool due;
+    uint32_t dueSince;
+    uint32_t lastRunMS;
+  };
+  WidgetState widgetState[MAX_SCREEN_WIDGETS];
+  WidgetStats widgetStats[SCREEN_COUNT][MAX_SCREEN_WIDGETS];
+  // Due widgets that may run now; those held back by their rate limit
+  // only wake the render loop at heldWidgetMS.
+  uint8_t dueWidgets;
+  bool widgetsHeld;
+  uint32_t heldWidgetMS;
+
+  void resetWidgetState();
+  void runWidgets(const DirtyMask& dirty, uint32_t frameStart);
+
+  // Widgets draw through gfx; see beginWidget().
+  Compositor compositor;
+  Adafruit_GFX* gfx;
+
+  // Transport for compositor flushes, chosen in init(). Direct drawing
+  // goes to panel: the driver itself, or with the DMA transport, which
+  // then owns the SPI host, a canvas over the same bus.
+  BlockingDisplayBus blockingBus;
+#if defined(ESP32) && ENABLE_DMA_DISPLAY
+  DmaDisplayBus dmaBus;
+  BusCanvas busCanvas;
+#endif
+  DisplayBus* bus;
+  Adafruit_GFX* panel;
+
+#if ENABLE_BACKGROUND_CACHE
+  BackgroundCache backgrounds;
+#endif
+  InputTrace inputTrace;
+
+  // Car markers as last drawn on the track map; x = -1 means none.
+  TrackMap::Point drawnMarkers[MAX_CARS];
+  void drawTrackArea(int16_t x, int16_t y, int16_t w, int16_t h);
+
+  // Friction circle trail as last drawn, one point per history slot;
+  // false forces a full redraw after a screen switch.
+  TrackMap::Point drawnGForce[GFORCE_HISTORY_POINTS];
+  uint32_t drawnGForceSamples;
+  bool gForceTrailDrawn;
+  void drawGForceArea(int16_t x, int16_t y, int16_t w, int16_t h);
+
+  void drawScreenLayout(Screen screen);
+  void captureBackgrounds();
+
+  void beginWidget(int16_t x, int16_t y, int16_t w, int16_t h);
+  void endWidget();
+  void drawSpec(const WidgetSpec& spec);
+
+  // Event banner across the top of the screen; see showEvent().
+  enum BannerState {
+    BANNER_IDLE,
+    BANNER_PENDING,  // Shown at the next render
+    BANNER_SHOWN
+  };
+  BannerState bannerState;
+  RaceEvent bannerEvent;
+  uint32_t bannerStartMS;
+  void drawEventBanner();
+
+#if ENABLE_TRACE && ENABLE_TRACE_OVERLAY
+  uint32_t drawnTraceWindow;
+  void drawTraceOverlay();
+#endif
+
+  // Per-screen frame cost. The direct* counters are what the same
+  // drawing would have cost without tiles; before compositing, each tile
+  // was its own transaction and address window.
+  struct RenderStats {
+    uint32_t frames;
+    uint32_t totalMicros;
+    uint32_t maxMicros;
+    uint32_t busWaitMicros;
+    uint32_t pushedBytes;
+    uint32_t directBytes;
+    uint32_t tiles;
+    uint32_t regions;
+    uint32_t transactions;
+    uint32_t directWindows;
+    uint32_t switches;  // Layout restores or redraws on a screen switch
+    uint32_t switchMicros;
+    uint32_t maxSwitchMicros;
+  };
+  RenderStats renderStats[SCREEN_COUNT];
 
 public:
   // ============================================
@@ -167,9 +196,19 @@ public:
   // Core Methods
   // ============================================
   void init();
+  void refreshVisibleData();
   void render();
   void drawLayout();
   void nextScreen();
+  void printRenderStats(Print& out);
+  void printWidgetStats(Print& out);
+
+  // Banner and LED cue for one event, for EVENT_BANNER_MS from the next
+  // render; the controller queues the rest until it is done.
+  void showEvent(const RaceEvent& event);
+  bool isShowingEvent() const {
+    return bannerState != BANNER_IDLE;
+  }
 
   // ============================================
   // Screen Drawing Methods
@@ -178,83 +217,69 @@ public:
   void drawTyreInfoScreen();
   void drawCarInfoScreen();
   void drawSessionInfoScreen();
-
-  // ============================================
-  // Reset Dirty Tracking
-  // ============================================
-  void resetGeneralDirtyTracking();
-  void resetTyreInfoDirtyTracking();
-  void resetCarInfoDirtyTracking();
-  void resetSessionInfoDirtyTracking();
+  void drawInputTraceScreen();
+  void drawTrackMapScreen();
+  void drawLapHistoryScreen();
+  void drawStrategyScreen();
 
   // ============================================
   // Update Methods - SCREEN 1: GENERAL
   // ============================================
-  void updatePosition();
-  void updateDeltaFront();
-  void updateDeltaLeader();
-  void updateDeltaLive();
-  void updateLastLapTime();
-  void updateCurrentLapTime();
-  void updateSector1();
-  void updateSector2();
-  void updateCurrentLapNum();
-  void updateCornerCuttingWarnings();
-  void updateSpeed();
-  void updateThrottle();
-  void updateBrake();
-  void updateGear();
-  void updateRPM();
-  void updateDRS();
-  void updateRevLights();
-  void updateSuggestedGear();
-  void updateFrontBrakeBias();
-  void updateDiffOnThrottle();
-  void updateFuelInTank();
-  void updateFuelRemainingLaps();
-  void updateERSEnergy();
-  void updateERSMode();
-  void updateLEDs();
+  void updateDeltaLeader(const DirtyMask& dirty);
+  void updateDeltaLive(const DirtyMask& dirty);
+  void updateLastLapTime(const DirtyMask& dirty);
+  void updateCurrentLapTime(const DirtyMask& dirty);
+  void updateSpeed(const DirtyMask& dirty);
+  void updateThrottle(const DirtyMask& dirty);
+  void updateBrake(const DirtyMask& dirty);
+  void updateGear(const DirtyMask& dirty);
+  void updateERSEnergy(const DirtyMask& dirty);
+  void updateLEDs(const DirtyMask& dirty);
 
   // ============================================
   // Update Methods - SCREEN 2: TYRE INFO
   // ============================================
-  void updateTyresAgeLaps();
-  void updateBrakeTemps();
-  void updateTyreSurfaceTemps();
-  void updateTyreInnerTemps();
-  void updateTyrePressures();
-  void updateTyreWear();
-  void updateTyreDamage();
-  void updateBrakeDamage();
+  // Value widgets (TYRE_TEMP_SPECS, TYRE_WEAR_SPECS) and the wear trend.
+  void updateTyreDegradation(const DirtyMask& dirty);
 
   // ============================================
   // Update Methods - SCREEN 3: CAR INFO
   // ============================================
-  void updatePowerUnit();
-  void updateAeroDamage();
-  void updateComponentWear();
+  void updatePowerUnitFaults(const DirtyMask& dirty);
 
   // ============================================
   // Update Methods - SCREEN 4: RACE OVERVIEW
   // ============================================
-  void updateWeather();
-  void updateTrackTemp();
-  void updateAirTemp();
+  void updateLapInfo(const DirtyMask& dirty);
+  void updateSessionTimeLeft(const DirtyMask& dirty);
+  void updateBestLap(const DirtyMask& dirty);
+  void updateLastLap(const DirtyMask& dirty);
+  void updateDamageStatus(const DirtyMask& dirty);
+
+  // ============================================
+  // Update Methods - SCREEN 5: INPUT TRACE
+  // ============================================
+  void updateInputTrace(const DirtyMask& dirty);
 
-  void updateSessionType();
-  void updateLapInfo();
-  void updateSessionTimeLeft();
-  void updateSafetyCarStatus();
+  // ============================================
+  // Update Methods - SCREEN 6: TRACK MAP
+  // ============================================
+  void updateTrackMap(const DirtyMask& dirty);
+  void updateGForce(const DirtyMask& dirty);
 
-  void updateBestLap();
-  void updateLastLap();
-  void updateSectorTimes();
+  // ============================================
+  // Update Methods - SCREEN 7: LAP HISTORY
+  // ============================================
+  void updateLapHistory(const DirtyMask& dirty);
+  void updateLapConsistency(const DirtyMask& dirty);
 
-  void updateFuelStatus();
-  void updateTyreStatus();
-  void updateEngineStatus();
-  void updateDamageStatus();
+  // ============================================
+  // Update Methods - SCREEN 8: STRATEGY
+  // ============================================
+  void updateTyreSets(const DirtyMask& dirty);
+  void updateFittedTyre(const DirtyMask& dirty);
+  void updateTyreSuggestions(const DirtyMask& dirty);
+  void updateStrategyPlan(const DirtyMask& dirty);
 
   // ============================================
   // Boot Screen
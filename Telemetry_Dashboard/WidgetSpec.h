@@ -0,0 +1,112 @@
+#ifndef WIDGET_SPEC_H
+#define WIDGET_SPEC_H
+
+#include <Arduino.h>
+#include <float.h>
+#include "ModelFields.h"
+
+// ============================================
+// Declarative Widgets
+// ============================================
+// A widget that shows one model field is described by a WidgetSpec (where)
+// and a ValueFormat (how). TelemetryView::drawSpec() is the only code that
+// renders them. Formats are built at compile time and shared between
+// widgets showing the same kind of value:
+//
+//   constexpr ValueFormat SECTOR = ValueFormat(1, COLOR_GREEN, 3).scaled(0.001f).valid(0);
+
+// Value at or above `from` switches to `color`. Bands are checked in order,
+// so list them with ascending thresholds.
+struct ColorBand {
+  float from;
+  uint16_t color;
+};
+
+// Indexed by the field value; the last entry is used for anything out of
+// range.
+struct EnumLabel {
+  const char* text;
+  uint16_t color;
+};
+
+struct ValueFormat {
+  uint8_t textSize;
+  uint8_t decimals;
+  uint16_t color;
+  float scale;
+  float validAbove;  // Values outside (validAbove, validBelow) print "--"
+  float validBelow;
+  const char* prefix;
+  const char* suffix;
+  ColorBand bands[2];
+  const EnumLabel* labels;
+  uint8_t labelCount;
+  int16_t barWidth;  // 0 = text only; otherwise a bar at the widget's left edge
+  int16_t barHeight;
+  float barMin;
+  float barMax;
+
+  constexpr ValueFormat(uint8_t textSize, uint16_t color, uint8_t decimals = 0)
+    : ValueFormat(textSize, decimals, color, 1.0f, -FLT_MAX, FLT_MAX, "", "", FLT_MAX, 0, FLT_MAX, 0,
+                  NULL, 0, 0, 0, 0.0f, 0.0f) {}
+
+  constexpr ValueFormat text(const char* newPrefix, const char* newSuffix) const {
+    return ValueFormat(textSize, decimals, color, scale, validAbove, validBelow, newPrefix, newSuffix,
+                       bands[0].from, bands[0].color, bands[1].from, bands[1].color, labels, labelCount,
+                       barWidth, barHeight, barMin, barMax);
+  }
+  constexpr ValueFormat scaled(float newScale) const {
+    return ValueFormat(textSize, decimals, color, newScale, validAbove, validBelow, prefix, suffix,
+                       bands[0].from, bands[0].color, bands[1].from, bands[1].color, labels, labelCount,
+                       barWidth, barHeight, barMin, barMax);
+  }
+  constexpr ValueFormat valid(float above, float below = FLT_MAX) const {
+    return ValueFormat(textSize, decimals, color, scale, above, below, prefix, suffix,
+                       bands[0].from, bands[0].color, bands[1].from, bands[1].color, labels, labelCount,
+                       barWidth, barHeight, barMin, barMax);
+  }
+  constexpr ValueFormat band(float from1, uint16_t color1, float from2 = FLT_MAX, uint16_t color2 = 0) const {
+    return ValueFormat(textSize, decimals, color, scale, validAbove, validBelow, prefix, suffix,
+                       from1, color1, from2, color2, labels, labelCount, barWidth, barHeight, barMin, barMax);
+  }
+  template <size_t N>
+  constexpr ValueFormat enumerated(const EnumLabel (&table)[N]) const {
+    return ValueFormat(textSize, decimals, color, scale, validAbove, validBelow, prefix, suffix,
+                       bands[0].from, bands[0].color, bands[1].from, bands[1].color, table, N,
+                       barWidth, barHeight, barMin, barMax);
+  }
+  constexpr ValueFormat bar(int16_t width, int16_t height, float min, float max) const {
+    return ValueFormat(textSize, decimals, color, scale, validAbove, validBelow, prefix, suffix,
+                       bands[0].from, bands[0].color, bands[1].from, bands[1].color, labels, labelCount,
+                       width, height, min, max);
+  }
+
+  uint16_t colorFor(float value) const {
+    uint16_t result = color;
+    if (value >= bands[0].from) result = bands[0].color;
+    if (value >= bands[1].from) result = bands[1].color;
+    return result;
+  }
+
+private:
+  constexpr ValueFormat(uint8_t textSize, uint8_t decimals, uint16_t color, float scale, float validAbove,
+                        float validBelow, const char* prefix, const char* suffix, float from1, uint16_t color1,
+                        float from2, uint16_t color2, const EnumLabel* labels, uint8_t labelCount,
+                        int16_t barWidth, int16_t barHeight, float barMin, float barMax)
+    : textSize(textSize), decimals(decimals), color(color), scale(scale), validAbove(validAbove),
+      validBelow(validBelow), prefix(prefix), suffix(suffix), bands{ { from1, color1 }, { from2, color2 } },
+      labels(labels), labelCount(labelCount), barWidth(barWidth), barHeight(barHeight), barMin(barMin),
+      barMax(barMax) {}
+};
+
+// textX == TEXT_CENTER centres the text in the widget rectangle.
+const int16_t TEXT_CENTER = -1;
+
+struct WidgetSpec {
+  ModelField field;
+  int16_t x, y, w, h;
+  int16_t textX, textY;
+  const ValueFormat* format;
+};
+
+#endif
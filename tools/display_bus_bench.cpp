@@ -0,0 +1,152 @@
+// Host benchmark for the display transport.
+//
+// Replays the sprite pushes of a sample of dashboard screens through
+// SimDisplayBus with one and with two span buffers, and reports frame
+// time, wire utilisation and how long the CPU sat waiting on the bus.
+//
+//   g++ -O2 -std=gnu++11 -I../Telemetry_Dashboard -o display_bus_bench
+//       display_bus_bench.cpp ../Telemetry_Dashboard/SimDisplayBus.cpp
+//   ./display_bus_bench [cpu_scale]
+//
+// cpu_scale multiplies host CPU time to approximate the ESP32 (default 15).
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "SimDisplayBus.h"
+
+struct Region {
+  int16_t x, y, w, h;
+};
+
+// A fixed sample of four screens: GENERAL, TYRES, CAR and SESSION, one
+// full redraw each. The rectangles are copied from the drawing code in
+// View.cpp, which computes them as it draws, so they are not derived
+// from the widget tables and must be updated by hand when those screens
+// change. INPUTS, MAP, HISTORY and STRATEGY are not sampled.
+static const Region GENERAL_REGIONS[] = {
+  { 43, 1, 66, 22 }, { 43, 25, 66, 22 }, { 43, 49, 66, 22 }, { 43, 73, 66, 22 },
+  { 43, 97, 66, 22 }, { 43, 121, 66, 22 }, { 43, 145, 66, 22 }, { 43, 169, 66, 22 },
+  { 43, 193, 66, 22 }, { 113, 1, 74, 22 }, { 113, 25, 74, 94 }, { 113, 121, 74, 94 },
+  { 191, 1, 86, 22 }, { 191, 25, 86, 22 }, { 191, 49, 86, 22 }, { 191, 73, 86, 22 },
+  { 191, 97, 86, 22 }, { 191, 121, 86, 22 }, { 191, 145, 86, 22 }, { 191, 169, 86, 22 },
+  { 191, 193, 86, 22 },
+};
+
+static const Region TYRE_REGIONS[] = {
+  { 1, 1, 318, 22 },
+  { 5, 40, 150, 10 }, { 165, 40, 150, 10 }, { 5, 148, 150, 10 }, { 165, 148, 150, 10 },
+  { 5, 52, 150, 10 }, { 165, 52, 150, 10 }, { 5, 160, 150, 10 }, { 165, 160, 150, 10 },
+  { 5, 64, 150, 10 }, { 165, 64, 150, 10 }, { 5, 172, 150, 10 }, { 165, 172, 150, 10 },
+  { 5, 76, 150, 10 }, { 165, 76, 150, 10 }, { 5, 184, 150, 10 }, { 165, 184, 150, 10 },
+  { 5, 88, 150, 10 }, { 165, 88, 150, 10 }, { 5, 196, 150, 10 }, { 165, 196, 150, 10 },
+  { 5, 100, 150, 10 }, { 165, 100, 150, 10 }, { 5, 208, 150, 10 }, { 165, 208, 150, 10 },
+  { 5, 112, 150, 10 }, { 165, 112, 150, 10 }, { 5, 220, 150, 10 }, { 165, 220, 150, 10 },
+};
+
+static const Region CAR_REGIONS[] = {
+  { 60, 25, 90, 10 }, { 60, 40, 90, 10 }, { 60, 55, 90, 10 }, { 60, 70, 90, 10 },
+  { 60, 85, 90, 10 }, { 240, 25, 70, 10 }, { 240, 37, 70, 10 }, { 240, 49, 70, 10 },
+  { 240, 61, 70, 10 }, { 240, 73, 70, 10 }, { 240, 85, 70, 10 }, { 70, 130, 240, 10 },
+  { 70, 145, 240, 10 }, { 70, 160, 240, 10 }, { 70, 175, 240, 10 }, { 70, 190, 240, 10 },
+  { 70, 205, 240, 10 }, { 70, 220, 240, 10 },
+};
+
+static const Region SESSION_REGIONS[] = {
+  { 70, 25, 80, 10 }, { 70, 40, 80, 10 }, { 70, 55, 80, 10 }, { 210, 25, 100, 10 },
+  { 210, 37, 100, 10 }, { 210, 49, 100, 10 }, { 190, 61, 120, 10 }, { 8, 115, 150, 10 },
+  { 8, 137, 150, 17 }, { 165, 115, 145, 10 }, { 165, 137, 145, 10 }, { 55, 181, 255, 10 },
+  { 55, 196, 255, 10 }, { 55, 211, 255, 10 }, { 55, 226, 255, 10 },
+};
+
+struct Screen {
+  const char* name;
+  const Region* regions;
+  size_t count;
+};
+
+#define SCREEN(name, list) { name, list, sizeof(list) / sizeof(list[0]) }
+static const Screen SCREENS[] = {
+  SCREEN("GENERAL", GENERAL_REGIONS),
+  SCREEN("TYRES", TYRE_REGIONS),
+  SCREEN("CAR", CAR_REGIONS),
+  SCREEN("SESSION", SESSION_REGIONS),
+};
+
+static const uint32_t SPI_HZ = 40000000;
+static const uint32_t TRANSACTION_NANOS = 4000;
+static const int FRAMES = 200;
+
+static uint64_t hostNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+// Same expansion as Compositor::sendRegion(): 4bpp rows through a
+// 16-entry palette.
+static uint8_t spritePixels[4096];
+static uint16_t palette[16];
+
+static void pushRegion(DisplayBus& bus, const Region& r) {
+  uint16_t stride = (r.w + 1) / 2;
+  bus.beginRegion(r.x, r.y, r.w, r.h);
+
+  uint16_t* span = bus.acquireSpan();
+  uint16_t used = 0;
+  for (int16_t row = 0; row < r.h; row++) {
+    if (used + r.w > DISPLAY_BUS_SPAN_PIXELS) {
+      bus.queueSpan(used);
+      span = bus.acquireSpan();
+      used = 0;
+    }
+    const uint8_t* rowStart = &spritePixels[row * stride];
+    for (int16_t col = 0; col < r.w; col++) {
+      uint8_t cell = rowStart[col >> 1];
+      span[used + col] = palette[(col & 1) ? (cell & 0x0F) : (cell >> 4)];
+    }
+    used += r.w;
+  }
+  bus.queueSpan(used);
+  bus.endRegion();
+}
+
+// One transaction per frame, as Compositor::flush() sends it.
+static void pushFrame(DisplayBus& bus, const Region* regions, size_t count) {
+  bus.beginTransaction();
+  for (size_t r = 0; r < count; r++) {
+    pushRegion(bus, regions[r]);
+  }
+  bus.endTransaction();
+}
+
+int main(int argc, char** argv) {
+  uint16_t cpuScale = argc > 1 ? (uint16_t)atoi(argv[1]) : 15;
+
+  for (size_t i = 0; i < sizeof(spritePixels); i++) spritePixels[i] = (uint8_t)(i * 37);
+  for (int i = 0; i < 16; i++) palette[i] = (uint16_t)(i * 0x1111);
+
+  printf("SPI %lu MHz, %lu ns/transaction, cpu x%u, %d frames\n", (unsigned long)(SPI_HZ / 1000000),
+         (unsigned long)TRANSACTION_NANOS, cpuScale, FRAMES);
+  printf("%-8s %7s %9s %8s %8s %8s\n", "screen", "buffers", "frame_us", "wire_%", "wait_us", "MB/s");
+
+  for (size_t s = 0; s < sizeof(SCREENS) / sizeof(SCREENS[0]); s++) {
+    const Screen& screen = SCREENS[s];
+    for (uint8_t buffers = 1; buffers <= 2; buffers++) {
+      SimDisplayBus bus(hostNanos, SPI_HZ, TRANSACTION_NANOS, buffers, cpuScale);
+
+      for (int f = 0; f < FRAMES; f++) {
+        pushFrame(bus, screen.regions, screen.count);
+      }
+
+      uint64_t elapsed = bus.getElapsedNanos();
+      const DisplayBusStats& stats = bus.getStats();
+      printf("%-8s %7u %9.1f %8.1f %8.1f %8.2f\n", screen.name, buffers, elapsed / 1000.0 / FRAMES,
+             100.0 * bus.getWireNanos() / elapsed, (double)stats.waitMicros / FRAMES,
+             stats.bytes * 1000.0 / elapsed);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+# Generates Telemetry_Dashboard/GlyphData.h from the Adafruit GFX classic
+# font.
+#
+#   python3 make_glyphs.py <Adafruit_GFX_Library>/glcdfont.c > ../Telemetry_Dashboard/GlyphData.h
+#
+# Each glyph is decomposed into filled rectangles in font units: runs of
+# lit pixels along rows (or columns, if that needs fewer), merged while the
+# next row has the same run. Drawing a glyph at size s is then one fillRect
+# per rectangle instead of one per lit pixel.
+
+import re
+import sys
+
+# Characters the dashboard draws at large sizes or in hot widgets.
+CHARSET = "0123456789-+.:%RN"
+
+FONT_WIDTH = 5
+FONT_HEIGHT = 8
+
+
+def load_font(path):
+    text = open(path).read()
+    body = text[text.index("{", text.index("font[")) + 1:]
+    body = body[:body.index("}")]
+    body = re.sub(r"//.*", "", body)
+    body = re.sub(r"/\*.*?\*/", "", body, flags=re.S)
+    return [int(v, 16) for v in re.findall(r"0x[0-9A-Fa-f]+", body)]
+
+
+def runs(lit, width, height):
+    """Horizontal runs of lit cells, merged downwards while the next row has the same run."""
+    used = [[0] * width for _ in range(height)]
+    rects = []
+    for y in range(height):
+        x = 0
+        while x < width:
+            if not lit[y][x] or used[y][x]:
+                x += 1
+                continue
+            w = 1
+            while x + w < width and lit[y][x + w] and not used[y][x + w]:
+                w += 1
+            h = 1
+            while y + h < height and all(lit[y + h][x + i] and not used[y + h][x + i] for i in range(w)) \
+                    and (x == 0 or not lit[y + h][x - 1]) and (x + w == width or not lit[y + h][x + w]):
+                h += 1
+            for j in range(h):
+                for i in range(w):
+                    used[y + j][x + i] = 1
+            rects.append((x, y, w, h))
+            x += w
+    return rects
+
+
+def rectangles(columns):
+    """Row-major or column-major runs, whichever needs fewer rectangles."""
+    rows = [[(columns[x] >> y) & 1 for x in range(FONT_WIDTH)] for y in range(FONT_HEIGHT)]
+    cols = [[rows[y][x] for y in range(FONT_HEIGHT)] for x in range(FONT_WIDTH)]
+    by_row = runs(rows, FONT_WIDTH, FONT_HEIGHT)
+    by_column = [(x, y, w, h) for y, x, h, w in runs(cols, FONT_HEIGHT, FONT_WIDTH)]
+    return by_row if len(by_row) <= len(by_column) else by_column
+
+
+def main():
+    font = load_font(sys.argv[1])
+    out = sys.stdout
+    out.write("// Generated by tools/make_glyphs.py from Adafruit GFX glcdfont.c. Do not edit.\n")
+    out.write("#ifndef GLYPH_DATA_H\n#define GLYPH_DATA_H\n\n")
+    out.write("#include \"Glyphs.h\"\n\n")
+
+    all_rects = []
+    glyphs = []
+    for c in CHARSET:
+        code = ord(c)
+        columns = font[code * FONT_WIDTH:(code + 1) * FONT_WIDTH]
+        rects = rectangles(columns)
+        pixels = sum(bin(v & 0x7F).count("1") for v in columns)
+        glyphs.append((c, len(all_rects), len(rects), pixels))
+        all_rects.extend(rects)
+
+    out.write("static const GlyphRect GLYPH_RECTS[] = {\n")
+    for c, offset, count, _ in glyphs:
+        cells = ", ".join("{ 0x%02X, 0x%02X }" % ((x << 4) | y, (w << 4) | h)
+                          for x, y, w, h in all_rects[offset:offset + count])
+        out.write("  %s,  // '%s'\n" % (cells, c))
+    out.write("};\n\n")
+
+    out.write("static const Glyph GLYPHS[] = {\n")
+    for c, offset, count, pixels in glyphs:
+        out.write("  { '%s', %d, %d },  // %d px\n" % (c, offset, count, pixels))
+    out.write("};\n\n#endif\n")
+
+
+if __name__ == "__main__":
+    main()